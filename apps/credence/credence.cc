@@ -39,8 +39,14 @@
 //!  \brief credence key generator and checker (Ed25519 keys)
 //---------------------------------------------------------------------------
 
+#include <charconv>
+#include <fstream>
+
 #include "DwmArguments.hh"
+#include "DwmCredenceKeyEndorsement.hh"
 #include "DwmCredenceKeyStash.hh"
+#include "DwmCredenceStreamSigner.hh"
+#include "DwmCredenceStreamVerifier.hh"
 #include "DwmCredenceVersion.hh"
 
 using namespace std;
@@ -50,6 +56,18 @@ typedef   Dwm::Arguments<Dwm::Argument<'i',string>,
 
 typedef   Dwm::Arguments<Dwm::Argument<'d',string>> KeyCheckArgType;
 
+typedef   Dwm::Arguments<Dwm::Argument<'d',string>,
+                         Dwm::Argument<'e',string>> EndorseArgType;
+
+typedef   Dwm::Arguments<Dwm::Argument<'d',string>,
+                         Dwm::Argument<'o',string>> SignArgType;
+
+typedef   Dwm::Arguments<Dwm::Argument<'k',string>,
+                         Dwm::Argument<'s',string>> VerifyArgType;
+
+static const string    g_sigTag("ed25519ph-signature");
+static const uint32_t  k_maxEndorseDays = 36500;
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -57,6 +75,9 @@ static void Usage(const char *argv0)
 {
   cerr << "Usage: " << argv0 << " keygen [-i id] [-d directory]\n"
        << "       " << argv0 << " keycheck [-d directory]\n"
+       << "       " << argv0 << " endorse [-d directory] [-e days] pubkeyfile\n"
+       << "       " << argv0 << " sign [-d directory] [-o sigfile] file\n"
+       << "       " << argv0 << " verify [-k pubkeyfile] [-s sigfile] file\n"
        << "       " << argv0 << " -v\n";
   return;
 }
@@ -69,7 +90,7 @@ static void InitKeyGenArgs(KeyGenArgType & args)
   args.SetValueName<'i'>("identity");
   Dwm::Credence::Ed25519KeyPair  kp;
   args.SetHelp<'i'>("Use the given identity (defaults to "
-                    + kp.PublicKey().Id() + ")");
+                    + string(kp.PublicKey().Id()) + ")");
   args.SetValueName<'d'>("directory");
   args.SetHelp<'d'>("directory in which to store keys (defaults to ~/.credence)");
   args.Set<'d'>("~/.credence");
@@ -87,6 +108,191 @@ static void InitKeyCheckArgs(KeyCheckArgType & args)
   return;
 }
 
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void InitEndorseArgs(EndorseArgType & args)
+{
+  args.SetValueName<'d'>("directory");
+  args.SetHelp<'d'>("authority key directory (defaults to ~/.credence)");
+  args.Set<'d'>("~/.credence");
+  args.SetValueName<'e'>("days");
+  args.SetHelp<'e'>("days until the endorsement expires, 1 to 36500"
+                    " (defaults to 365)");
+  args.Set<'e'>("365");
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Parses @c s as a number of days for an endorsement to last, from 1
+//!  to k_maxEndorseDays.  Returns true on success.
+//----------------------------------------------------------------------------
+static bool ParseDays(const string & s, uint32_t & days)
+{
+  const char  *end = s.data() + s.size();
+  auto  [ptr, ec] = from_chars(s.data(), end, days);
+  return ((errc() == ec) && (end == ptr)
+          && (0 < days) && (days <= k_maxEndorseDays));
+}
+
+//----------------------------------------------------------------------------
+//!  Endorses the public key in @c pubKeyFile with the key pair in the
+//!  key stash in @c keyDir, and prints the endorsement on stdout.
+//----------------------------------------------------------------------------
+static bool Endorse(const string & keyDir, uint32_t numDays,
+                    const string & pubKeyFile)
+{
+  bool  rc = false;
+  Dwm::Credence::KeyStash        keyStash(keyDir);
+  Dwm::Credence::Ed25519KeyPair  authorityKeys;
+  if (! keyStash.Get(authorityKeys)) {
+    cerr << "Failed to get keys from key stash '" << keyDir << "'\n";
+    return rc;
+  }
+  ifstream  is(pubKeyFile);
+  Dwm::Credence::Ed25519Key  subject;
+  if (! (is >> subject)) {
+    cerr << "Failed to read public key from '" << pubKeyFile << "'\n";
+    return rc;
+  }
+  Dwm::Credence::KeyEndorsement  endorsement;
+  auto  expires = Dwm::Credence::Utils::Clock::now()
+    + std::chrono::hours(24 * numDays);
+  if (endorsement.Create(subject, authorityKeys.SecretKey(), expires)) {
+    cout << endorsement << '\n';
+    rc = true;
+  }
+  else {
+    cerr << "Failed to endorse key for " << subject.Id() << '\n';
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void InitSignArgs(SignArgType & args)
+{
+  args.SetValueName<'d'>("directory");
+  args.SetHelp<'d'>("key directory (defaults to ~/.credence)");
+  args.Set<'d'>("~/.credence");
+  args.SetValueName<'o'>("sigfile");
+  args.SetHelp<'o'>("signature file (defaults to file.sig)");
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void InitVerifyArgs(VerifyArgType & args)
+{
+  args.SetValueName<'k'>("pubkeyfile");
+  args.SetHelp<'k'>("signer's public key file (defaults to"
+                    " ~/.credence/id_ed25519.pub)");
+  args.SetValueName<'s'>("sigfile");
+  args.SetHelp<'s'>("signature file (defaults to file.sig)");
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Signs the content of @c file with the secret key in the key stash in
+//!  @c keyDir, and saves the signature in @c sigFile.  The file is
+//!  memory-mapped and signed with Ed25519ph, so files of any size can be
+//!  signed without reading them into memory.
+//----------------------------------------------------------------------------
+static bool Sign(const string & keyDir, const string & file,
+                 const string & sigFile)
+{
+  bool  rc = false;
+  Dwm::Credence::KeyStash        keyStash(keyDir);
+  Dwm::Credence::Ed25519KeyPair  keys;
+  if (! keyStash.Get(keys)) {
+    cerr << "Failed to get keys from key stash '" << keyDir << "'\n";
+    return rc;
+  }
+  Dwm::Credence::StreamSigner       signer;
+  Dwm::Credence::Signer::Signature  sig;
+  if (! signer.UpdateFile(file)) {
+    cerr << "Failed to read '" << file << "'\n";
+  }
+  else if (! signer.Final(keys.SecretKey().Key(), sig)) {
+    cerr << "Failed to sign '" << file << "'\n";
+  }
+  else {
+    ofstream  os(sigFile);
+    string    sigStr((const char *)sig.data(), sig.size());
+    if (os << keys.PublicKey().Id() << ' ' << g_sigTag << ' '
+        << Dwm::Credence::Utils::Bin2Base64(sigStr) << '\n') {
+      rc = true;
+    }
+    else {
+      cerr << "Failed to write signature to '" << sigFile << "'\n";
+    }
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  Verifies that the signature in @c sigFile is the signature of the
+//!  content of @c file, created by the owner of the public key in
+//!  @c pubKeyFile.  If @c pubKeyFile is empty, our own public key is used.
+//----------------------------------------------------------------------------
+static bool Verify(const string & pubKeyFile, const string & file,
+                   const string & sigFile)
+{
+  bool  rc = false;
+  Dwm::Credence::Ed25519Key  pubKey;
+  if (pubKeyFile.empty()) {
+    Dwm::Credence::KeyStash        keyStash;
+    Dwm::Credence::Ed25519KeyPair  keys;
+    if (! keyStash.Get(keys)) {
+      cerr << "Failed to get keys from key stash '" << keyStash.DirName()
+           << "'\n";
+      return rc;
+    }
+    pubKey = keys.PublicKey();
+  }
+  else {
+    ifstream  is(pubKeyFile);
+    if (! (is >> pubKey)) {
+      cerr << "Failed to read public key from '" << pubKeyFile << "'\n";
+      return rc;
+    }
+  }
+  ifstream  is(sigFile);
+  string    id, tag, sigBase64;
+  if (! (is >> id >> tag >> sigBase64) || (tag != g_sigTag)) {
+    cerr << "Failed to read signature from '" << sigFile << "'\n";
+    return rc;
+  }
+  //  The ID in the signature file is only a claim; it must name the key
+  //  we're verifying with.
+  if (id != pubKey.Id()) {
+    cerr << "Signature in '" << sigFile << "' claims to be from " << id
+         << ", not " << pubKey.Id() << '\n';
+    return rc;
+  }
+  string  sig = Dwm::Credence::Utils::Base642Bin(sigBase64);
+  if (sig.size() != crypto_sign_BYTES) {
+    cerr << "Invalid signature in '" << sigFile << "'\n";
+    return rc;
+  }
+  Dwm::Credence::StreamVerifier  verifier;
+  if (! verifier.UpdateFile(file)) {
+    cerr << "Failed to read '" << file << "'\n";
+  }
+  else if (verifier.Final(span<const uint8_t,crypto_sign_BYTES>
+                          ((const uint8_t *)sig.data(), crypto_sign_BYTES),
+                          pubKey.Key())) {
+    cout << "Good signature from " << pubKey.Id() << '\n';
+    rc = true;
+  }
+  else {
+    cerr << "BAD signature from " << pubKey.Id() << '\n';
+  }
+  return rc;
+}
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -103,8 +309,14 @@ int main(int argc, char *argv[])
 {
   KeyCheckArgType  keycheckArgs;
   KeyGenArgType    keygenArgs;
+  EndorseArgType   endorseArgs;
+  SignArgType      signArgs;
+  VerifyArgType    verifyArgs;
   InitKeyCheckArgs(keycheckArgs);
   InitKeyGenArgs(keygenArgs);
+  InitEndorseArgs(endorseArgs);
+  InitSignArgs(signArgs);
+  InitVerifyArgs(verifyArgs);
 
   if (argc < 2) {
     Usage(argv[0]);
@@ -138,6 +350,55 @@ int main(int argc, char *argv[])
         return 1;
       }
     }
+    else if (string(argv[1]) == "endorse") {
+      int  argind = endorseArgs.Parse(argc-1, &argv[1]);
+      if ((argind < 0) || ((argind + 1) >= argc)) {
+        cerr << endorseArgs.Usage(string(argv[0]) + ' ' + argv[1],
+                                  "pubkeyfile");
+        return 1;
+      }
+      uint32_t  numDays;
+      if (! ParseDays(endorseArgs.Get<'e'>(), numDays)) {
+        cerr << "Invalid number of days '" << endorseArgs.Get<'e'>()
+             << "' (must be 1 to " << k_maxEndorseDays << ")\n"
+             << endorseArgs.Usage(string(argv[0]) + ' ' + argv[1],
+                                  "pubkeyfile");
+        return 1;
+      }
+      if (Endorse(endorseArgs.Get<'d'>(), numDays, argv[argind + 1])) {
+        return 0;
+      }
+    }
+    else if (string(argv[1]) == "sign") {
+      int  argind = signArgs.Parse(argc-1, &argv[1]);
+      if ((argind < 0) || ((argind + 1) >= argc)) {
+        cerr << signArgs.Usage(string(argv[0]) + ' ' + argv[1], "file");
+        return 1;
+      }
+      string  file(argv[argind + 1]);
+      string  sigFile(signArgs.Get<'o'>());
+      if (sigFile.empty()) {
+        sigFile = file + ".sig";
+      }
+      if (Sign(signArgs.Get<'d'>(), file, sigFile)) {
+        return 0;
+      }
+    }
+    else if (string(argv[1]) == "verify") {
+      int  argind = verifyArgs.Parse(argc-1, &argv[1]);
+      if ((argind < 0) || ((argind + 1) >= argc)) {
+        cerr << verifyArgs.Usage(string(argv[0]) + ' ' + argv[1], "file");
+        return 1;
+      }
+      string  file(argv[argind + 1]);
+      string  sigFile(verifyArgs.Get<'s'>());
+      if (sigFile.empty()) {
+        sigFile = file + ".sig";
+      }
+      if (Verify(verifyArgs.Get<'k'>(), file, sigFile)) {
+        return 0;
+      }
+    }
     else if (string(argv[1]) == "-v") {
       cout << Dwm::Credence::Version.Version() << '\n';
       return 0;
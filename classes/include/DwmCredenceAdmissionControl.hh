@@ -0,0 +1,276 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceAdmissionControl.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::AdmissionControl class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEADMISSIONCONTROL_HH_
+#define _DWMCREDENCEADMISSIONCONTROL_HH_
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <memory>
+#include <cstdint>
+#include <list>
+#include <mutex>
+#include <set>
+#include <unordered_map>
+#include <vector>
+#include <boost/asio.hpp>
+
+#include "DwmIpPrefix.hh"
+#include "DwmCredencePrefixTrie.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  Admission control for Peer servers.  A Peer with an AdmissionControl
+    //!  (see Peer::SetAdmissionControl()) checks each accepted connection
+    //!  here before any key exchange work is done.  A connection is
+    //!  admitted only if:
+    //!
+    //!  - the source address matches the allowed clients (if any are
+    //!    configured), typically ServerConfig::AllowedClients(); these
+    //!    are held in a PrefixTrie that is swapped atomically, so they
+    //!    can be replaced on configuration reload without blocking
+    //!    Admit()
+    //!  - the source's token bucket has a token (if a rate is configured);
+    //!    sources are grouped by prefix, /32 for IPv4 and /64 for IPv6 by
+    //!    default, so one host (or one IPv6 subnet) shares a bucket
+    //!  - fewer than the maximum number of handshakes are in progress (if
+    //!    a maximum is configured)
+    //!
+    //!  An admitted connection holds a Ticket until its handshake is done,
+    //!  which counts against the maximum number of handshakes.
+    //!
+    //!  All members are thread safe, so a single AdmissionControl can be
+    //!  shared by all of a server's accepting threads.
+    //------------------------------------------------------------------------
+    class AdmissionControl
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Result of Admit().
+      //----------------------------------------------------------------------
+      enum class Verdict {
+        e_admitted       = 0,
+        e_notAllowed     = 1,
+        e_rateLimited    = 2,
+        e_handshakeLimit = 3
+      };
+
+      //----------------------------------------------------------------------
+      //!  Counts of Admit() results.
+      //----------------------------------------------------------------------
+      struct Counters
+      {
+        uint64_t  admitted;
+        uint64_t  notAllowed;
+        uint64_t  rateLimited;
+        uint64_t  handshakeLimit;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Holds a handshake slot from Admit() and releases it when
+      //!  destroyed or when Release() is called.
+      //----------------------------------------------------------------------
+      class Ticket
+      {
+      public:
+        Ticket() : _admissionControl(nullptr)  { }
+        Ticket(const Ticket &) = delete;
+        Ticket & operator = (const Ticket &) = delete;
+        Ticket(Ticket && ticket) noexcept;
+        Ticket & operator = (Ticket && ticket) noexcept;
+        ~Ticket()  { Release(); }
+
+        //--------------------------------------------------------------------
+        //!  Releases the handshake slot, if held.
+        //--------------------------------------------------------------------
+        void Release();
+
+        //--------------------------------------------------------------------
+        //!  Returns true if a handshake slot is held.
+        //--------------------------------------------------------------------
+        bool Held() const  { return (nullptr != _admissionControl); }
+        
+      private:
+        AdmissionControl  *_admissionControl;
+
+        friend class AdmissionControl;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Default constructor.  Admits everything until configured.
+      //----------------------------------------------------------------------
+      AdmissionControl();
+
+      AdmissionControl(const AdmissionControl &) = delete;
+      AdmissionControl & operator = (const AdmissionControl &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Sets the allowed clients.  If @c prefixes is empty, all sources
+      //!  are allowed.
+      //----------------------------------------------------------------------
+      void AllowedClients(const std::set<IpPrefix> & prefixes);
+
+      //----------------------------------------------------------------------
+      //!  Sets the allowed clients from a prebuilt @c trie.  If @c trie is
+      //!  nullptr or empty, all sources are allowed.  Admit() calls in
+      //!  progress finish with the trie they started with.
+      //----------------------------------------------------------------------
+      void AllowedClients(std::shared_ptr<const PrefixTrie> trie);
+
+      //----------------------------------------------------------------------
+      //!  Returns the current allowed clients.  May be nullptr.
+      //----------------------------------------------------------------------
+      std::shared_ptr<const PrefixTrie> AllowedClients() const;
+
+      //----------------------------------------------------------------------
+      //!  Sets the per-source rate limit: each source prefix may start
+      //!  @c perSecond handshakes per second on average, with bursts of up
+      //!  to @c burst.  A @c perSecond of 0 disables rate limiting.
+      //----------------------------------------------------------------------
+      void SetRate(double perSecond, double burst);
+
+      //----------------------------------------------------------------------
+      //!  Sets the prefix lengths used to group sources for rate limiting.
+      //----------------------------------------------------------------------
+      void SetSourcePrefixLengths(uint8_t v4Len, uint8_t v6Len);
+
+      //----------------------------------------------------------------------
+      //!  Sets the maximum number of source prefixes tracked for rate
+      //!  limiting.  When the limit is reached, idle sources are dropped;
+      //!  if none are idle, new sources are rate limited.
+      //----------------------------------------------------------------------
+      void SetMaxSources(size_t maxSources);
+      
+      //----------------------------------------------------------------------
+      //!  Sets the maximum number of concurrent handshakes.  0 means no
+      //!  limit.
+      //----------------------------------------------------------------------
+      void SetMaxHandshakes(size_t maxHandshakes);
+
+      //----------------------------------------------------------------------
+      //!  Checks the source @c addr.  On e_admitted, @c ticket holds a
+      //!  handshake slot.
+      //----------------------------------------------------------------------
+      Verdict Admit(const boost::asio::ip::address & addr, Ticket & ticket);
+
+      //----------------------------------------------------------------------
+      //!  Like Admit(const boost::asio::ip::address &, Ticket &), for
+      //!  sources without an IP address (UNIX domain sockets).  Only the
+      //!  maximum number of handshakes applies.
+      //----------------------------------------------------------------------
+      Verdict Admit(Ticket & ticket);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if @c addr matches the allowed clients.
+      //----------------------------------------------------------------------
+      bool IsAllowed(const boost::asio::ip::address & addr) const;
+      
+      //----------------------------------------------------------------------
+      //!  Returns the number of handshakes in progress.
+      //----------------------------------------------------------------------
+      size_t ActiveHandshakes() const
+      { return _activeHandshakes.load(); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of source prefixes tracked for rate limiting.
+      //----------------------------------------------------------------------
+      size_t NumSources() const;
+      
+      //----------------------------------------------------------------------
+      //!  Returns counts of Admit() results.
+      //----------------------------------------------------------------------
+      Counters Stats() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns a string for the given @c verdict.
+      //----------------------------------------------------------------------
+      static const char *VerdictString(Verdict verdict);
+      
+    private:
+      using Clock = std::chrono::steady_clock;
+      
+      //  Address family (4 or 6) followed by the address bytes.
+      using SourceKey = std::array<uint8_t,17>;
+
+      struct SourceKeyHash
+      {
+        size_t operator () (const SourceKey & key) const;
+      };
+
+      struct Bucket
+      {
+        double                          tokens;
+        Clock::time_point               last;
+        std::list<SourceKey>::iterator  lru;
+      };
+      
+      std::atomic<std::shared_ptr<const PrefixTrie>>  _allowed;
+      mutable std::mutex                        _bucketsMtx;
+      std::unordered_map<SourceKey,Bucket,SourceKeyHash>  _buckets;
+      std::list<SourceKey>                      _lru;     //  most recent first
+      double                                    _rate;
+      double                                    _burst;
+      uint8_t                                   _v4Len;
+      uint8_t                                   _v6Len;
+      size_t                                    _maxSources;
+      std::atomic<size_t>                       _maxHandshakes;
+      std::atomic<size_t>                       _activeHandshakes;
+      std::atomic<uint64_t>                     _admitted;
+      std::atomic<uint64_t>                     _notAllowed;
+      std::atomic<uint64_t>                     _rateLimited;
+      std::atomic<uint64_t>                     _handshakeLimit;
+
+      static SourceKey ToKey(const boost::asio::ip::address & addr);
+      static void Mask(SourceKey & key, uint8_t maskLen);
+      bool AcquireHandshake(Ticket & ticket);
+      void ReleaseHandshake();
+      bool TakeToken(const SourceKey & key);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEADMISSIONCONTROL_HH_
@@ -43,11 +43,17 @@
 #define _DWMCREDENCEAUTHENTICATOR_HH_
 
 #include <chrono>
+#include <memory>
+#include <mutex>
+#include <string>
 #include <boost/asio.hpp>
 
 #include "DwmStreamIOCapable.hh"
+#include "DwmCredenceHandshakeExecutor.hh"
+#include "DwmCredenceKeyAuthorities.hh"
 #include "DwmCredenceKeyStash.hh"
 #include "DwmCredenceKnownKeys.hh"
+#include "DwmCredenceMemoryPipe.hh"
 #include "DwmCredenceXChaCha20Poly1305Istream.hh"
 #include "DwmCredenceXChaCha20Poly1305Ostream.hh"
 
@@ -56,7 +62,12 @@ namespace Dwm {
   namespace Credence {
 
     //------------------------------------------------------------------------
-    //!  Used by Dwm::Credence::Peer for authentication.
+    //!  Used by Dwm::Credence::Peer for authentication.  Our identity is
+    //!  loaded once and shared, read-only, by every handshake; everything
+    //!  else a handshake needs lives on its own stack.  Hence one
+    //!  Authenticator may be used by many threads at once, as long as
+    //!  SetIdExchangeTimeout() and SetExecutor() are only called before
+    //!  it's shared.
     //------------------------------------------------------------------------
     class Authenticator
     {
@@ -67,9 +78,31 @@ namespace Dwm {
       Authenticator(const KeyStash & keyStash, const KnownKeys & knownKeys);
 
       //----------------------------------------------------------------------
-      //!  Sets the timeout for ID exchange to occur, in milliseconds.
+      //!  Construct from the given @c keyStash, @c knownKeys and
+      //!  @c authorities.  This enables endorsement mode: we send the
+      //!  endorsement from @c keyStash (if any) along with our ID, and
+      //!  accept a peer whose ID is not in @c knownKeys if it presents an
+      //!  endorsement that verifies against @c authorities.  Note that
+      //!  both peers must use endorsement mode.  @c authorities must
+      //!  outlive the Authenticator.
+      //----------------------------------------------------------------------
+      Authenticator(const KeyStash & keyStash, const KnownKeys & knownKeys,
+                    const KeyAuthorities & authorities);
+
+      //----------------------------------------------------------------------
+      //!  Sets the timeout for ID exchange to occur, in milliseconds, for
+      //!  the Authenticate() members that don't take one.  The default is
+      //!  1000.
       //----------------------------------------------------------------------
       void SetIdExchangeTimeout(std::chrono::milliseconds ms);
+
+      //----------------------------------------------------------------------
+      //!  Sets the executor used to limit concurrent signing and
+      //!  verification of challenges (see HandshakeExecutor), for the
+      //!  Authenticate() members that don't take one.  If not set (or set
+      //!  to nullptr), they're done on the calling thread.
+      //----------------------------------------------------------------------
+      void SetExecutor(HandshakeExecutor *executor);
       
       //----------------------------------------------------------------------
       //!  Authenticate the peer connected to @c s using the previously
@@ -82,7 +115,7 @@ namespace Dwm {
       //!  Returns true on success and sets @c theirId to the ID of the peer.
       //----------------------------------------------------------------------
       bool Authenticate(boost::asio::ip::tcp::iostream & s,
-                        const std::string & agreedKey,
+                        std::string_view agreedKey,
                         std::string & theirId);
 
       //----------------------------------------------------------------------
@@ -96,31 +129,110 @@ namespace Dwm {
       //!  Returns true on success and sets @c theirId to the ID of the peer.
       //----------------------------------------------------------------------
       bool Authenticate(boost::asio::local::stream_protocol::iostream & s,
-                        const std::string & agreedKey,
+                        std::string_view agreedKey,
                         std::string & theirId);
+
+      //----------------------------------------------------------------------
+      //!  Like Authenticate(boost::asio::ip::tcp::iostream &,
+      //!  std::string_view, std::string &), but exchanges all messages
+      //!  over the already established encrypted streams @c xis and
+      //!  @c xos, which must read and write the socket of @c s (directly
+      //!  or through their own buffers).  This is what Peer uses, so the
+      //!  socket has a single buffered stream in each direction.
+      //!  @c timeout and @c executor are used in place of those set with
+      //!  SetIdExchangeTimeout() and SetExecutor().
+      //----------------------------------------------------------------------
+      bool Authenticate(boost::asio::ip::tcp::iostream & s,
+                        XChaCha20Poly1305::Istream & xis,
+                        XChaCha20Poly1305::Ostream & xos,
+                        std::string & theirId,
+                        std::chrono::milliseconds timeout,
+                        HandshakeExecutor *executor);
+
+      //----------------------------------------------------------------------
+      //!  Like the TCP version, for UNIX domain sockets.
+      //----------------------------------------------------------------------
+      bool Authenticate(boost::asio::local::stream_protocol::iostream & s,
+                        XChaCha20Poly1305::Istream & xis,
+                        XChaCha20Poly1305::Ostream & xos,
+                        std::string & theirId,
+                        std::chrono::milliseconds timeout,
+                        HandshakeExecutor *executor);
+
+      //----------------------------------------------------------------------
+      //!  Like the TCP version, for an in-process MemoryPipe.
+      //----------------------------------------------------------------------
+      bool Authenticate(MemoryPipe & pipe,
+                        XChaCha20Poly1305::Istream & xis,
+                        XChaCha20Poly1305::Ostream & xos,
+                        std::string & theirId,
+                        std::chrono::milliseconds timeout,
+                        HandshakeExecutor *executor);
+
+      //----------------------------------------------------------------------
+      //!  Loads our key pair from the KeyStash (and our endorsement, in
+      //!  endorsement mode) and serializes the ID message we send to
+      //!  peers.  The first Authenticate() calls this; later calls reuse
+      //!  the loaded identity, so an Authenticator kept for many peers
+      //!  reads the KeyStash once.  Call it again to pick up changes in
+      //!  the KeyStash; handshakes already in progress keep the identity
+      //!  they started with.  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool LoadIdentity();
       
     private:
+      //----------------------------------------------------------------------
+      //!  Our key pair and the serialized ID message we send to peers.
+      //!  Never modified once loaded.
+      //----------------------------------------------------------------------
+      struct Identity
+      {
+        Ed25519KeyPair  keys;
+        std::string     idMessage;
+      };
+
+      //----------------------------------------------------------------------
+      //!  The state of one handshake.
+      //----------------------------------------------------------------------
+      struct Handshake
+      {
+        XChaCha20Poly1305::Istream  & xis;
+        XChaCha20Poly1305::Ostream  & xos;
+        std::chrono::milliseconds     timeout;
+        HandshakeExecutor            *executor;
+        std::string                   endPoint;
+      };
+      
       KeyStash                                        _keyStash;
       KnownKeys                                       _knownKeys;
+      const KeyAuthorities                           *_authorities;
       std::chrono::milliseconds                       _timeout;
-      boost::asio::ip::tcp::endpoint                  _endPoint;
-      boost::asio::local::stream_protocol::endpoint   _lendPoint;
-      std::unique_ptr<XChaCha20Poly1305::Ostream>     _xos;
-      std::unique_ptr<XChaCha20Poly1305::Istream>     _xis;
+      HandshakeExecutor                              *_executor;
+      std::mutex                                      _identityMtx;
+      std::shared_ptr<const Identity>                 _identity;
 
-      bool ExchangeIds(boost::asio::ip::tcp::iostream & s,
-                       Ed25519KeyPair & myKeys,
-                       Ed25519Key & theirPubKey);
-      bool ExchangeIds(boost::asio::local::stream_protocol::iostream & s,
-                       Ed25519KeyPair & myKeys,
+      std::shared_ptr<const Identity> GetIdentity();
+      template <typename SourceT>
+      bool Authenticate(Handshake & hs, SourceT & src, std::string & theirId);
+      template <typename SourceT>
+      bool ExchangeIds(Handshake & hs, SourceT & src,
+                       const Identity & identity, Ed25519Key & theirPubKey);
+      bool SendId(Handshake & hs, const Identity & identity);
+      bool ReceiveId(Handshake & hs, std::string & theirId,
+                     KeyEndorsement & endorsement);
+      bool FindPeerKey(const Handshake & hs, const std::string & theirId,
+                       const KeyEndorsement & endorsement,
                        Ed25519Key & theirPubKey);
-      bool ExchangeChallenges(const Ed25519Key & ourSecretKey,
+      bool ExchangeChallenges(Handshake & hs,
+                              const Ed25519Key & ourSecretKey,
                               const Ed25519Key & theirPubKey);
-      bool Send(const std::string & msg);
-      bool Send(const HasStreamWrite auto & msg);
-      bool Receive(std::string & msg);
-      bool Receive(HasStreamRead auto & msg);
-      std::string EndPointString() const;
+      bool Send(Handshake & hs, const HasStreamWrite auto & msg);
+      bool Receive(Handshake & hs, HasStreamRead auto & msg);
+      template <typename SocketT>
+      bool WaitForBytesReady(Handshake & hs, SocketT & sck,
+                             uint32_t numBytes);
+      bool WaitForBytesReady(Handshake & hs, MemoryPipe & pipe,
+                             uint32_t numBytes);
     };
     
   }  // namespace Credence
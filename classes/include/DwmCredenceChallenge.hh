@@ -42,6 +42,9 @@
 #ifndef _DWMCREDENCECHALLENGE_HH_
 #define _DWMCREDENCECHALLENGE_HH_
 
+#include <cstdint>
+#include <string_view>
+
 #include "DwmCredenceShortString.hh"
 
 namespace Dwm {
@@ -51,7 +54,12 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  Encapsulate a challenge sent to a client or server to verify their
     //!  idendity during authentication.  The challenge consists of 32 bytes
-    //!  of random data.
+    //!  of random data, optionally followed by a single byte of feature
+    //!  flags.  Older peers never send the feature byte and sign whatever
+    //!  challenge they receive, so the feature byte is backward compatible.
+    //!  The only feature flag is currently 'detached', which tells the
+    //!  receiver that it may respond with just a detached signature (see
+    //!  ChallengeResponse).
     //------------------------------------------------------------------------
     class Challenge
     {
@@ -62,9 +70,11 @@ namespace Dwm {
       //!  when the challenge will be transmitted.  If @c init is @c false,
       //!  the content of the challenge will not be initialized.  This is
       //!  used when we are intending to receive a challenge via the
-      //!  Read() member.
+      //!  Read() member.  If @c init is @c true and @c detached is @c true,
+      //!  the challenge will advertise that we accept a detached signature
+      //!  in the response.
       //----------------------------------------------------------------------
-      Challenge(bool init = false);
+      Challenge(bool init = false, bool detached = true);
       
       //----------------------------------------------------------------------
       //!  Copy constructor.
@@ -77,9 +87,15 @@ namespace Dwm {
       Challenge & operator = (const Challenge &) = default;
       
       //----------------------------------------------------------------------
-      //!  Returns a reference to the encapsulate challenge data.
+      //!  Returns the encapsulated challenge data.
+      //----------------------------------------------------------------------
+      operator std::string_view () const;
+
       //----------------------------------------------------------------------
-      operator const std::string & () const;
+      //!  Returns true if the challenge advertises that its sender accepts
+      //!  a detached signature in the response.
+      //----------------------------------------------------------------------
+      bool AcceptsDetached() const;
       
       //----------------------------------------------------------------------
       //!  Reads the challenge from the given istream @c is.  Returns @c is.
@@ -94,7 +110,10 @@ namespace Dwm {
       std::ostream & Write(std::ostream & os) const;
       
     private:
-      ShortString<255>  _challenge;
+      static constexpr size_t   k_randomBytes = 32;
+      static constexpr uint8_t  k_featureDetached = 0x01;
+      
+      ShortString<k_randomBytes + 1>  _challenge;
     };
     
   }  // namespace Credence
@@ -43,6 +43,7 @@
 #define _DWMCREDENCECHALLENGERESPONSE_HH_
 
 #include <string>
+#include <string_view>
 
 #include "DwmCredenceChallenge.hh"
 #include "DwmCredenceEd25519Key.hh"
@@ -54,6 +55,11 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  Encapsulates a challenge response.  This is used when responding
     //!  to a Challenge during authentication to a client or server.
+    //!  If the Challenge advertises that its sender accepts detached
+    //!  signatures, the response holds only the 64-byte detached signature
+    //!  of the challenge.  Otherwise it holds the combined-mode signed
+    //!  challenge, which is always longer than 64 bytes; this is what older
+    //!  peers send and expect.
     //------------------------------------------------------------------------
     class ChallengeResponse
     {
@@ -70,10 +76,17 @@ namespace Dwm {
       
       //----------------------------------------------------------------------
       //!  Given a @c challenge, creates the response using the given
-      //!  @c signingKey.  Returns true on success, false on failure.
+      //!  @c signingKey.  The response will be a detached signature if
+      //!  @c challenge.AcceptsDetached() is true.  Returns true on success,
+      //!  false on failure.
       //----------------------------------------------------------------------
       bool Create(const Ed25519Key & signingKey,
                   const Challenge & challenge);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the response holds a detached signature.
+      //----------------------------------------------------------------------
+      bool Detached() const;
       
       //----------------------------------------------------------------------
       //!  Reads the challenge response from the given istream @c is.
@@ -96,7 +109,7 @@ namespace Dwm {
       //!  true if the response is correct, else returns false.
       //----------------------------------------------------------------------
       bool Verify(const Ed25519Key & publicKey,
-                  const std::string & challengeString) const;
+                  std::string_view challengeString) const;
       
     private:
       std::string  _response;
@@ -0,0 +1,260 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceChannelMultiplexer.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ChannelMultiplexer class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCECHANNELMULTIPLEXER_HH_
+#define _DWMCREDENCECHANNELMULTIPLEXER_HH_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+
+#include "DwmCredencePeer.hh"
+#include "DwmCredencePeerReader.hh"
+#include "DwmCredencePeerWriter.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  Carries independent message streams, called channels, over one
+    //!  authenticated Peer.  Each side of the connection needs its own
+    //!  ChannelMultiplexer.  Channels are numbered by the application and
+    //!  need no setup: a message sent on channel N is received on
+    //!  channel N by the other side.  Messages are ordered within a
+    //!  channel but not across channels.
+    //!
+    //!  Messages are sent in chunks of at most ChunkSize() bytes, and
+    //!  chunks of different channels are interleaved.  A large message
+    //!  on one channel therefore delays a message on another channel by
+    //!  at most one chunk, not the whole message.  Channels with a
+    //!  higher priority (see SetPriority()) are served first; channels
+    //!  with the same priority share the connection round robin.
+    //!
+    //!  Each channel has its own flow control.  The sender may have at
+    //!  most Window() bytes of messages waiting for Receive() on the
+    //!  other side; beyond that, Send() on that channel waits for the
+    //!  receiver to catch up, without affecting other channels.  Chunks
+    //!  of a message that is still being reassembled are credited back
+    //!  as they arrive, so a single message may be larger than the
+    //!  window, up to MaxMessageSize() bytes.  Both sides must use the
+    //!  same window and maximum message size.
+    //!
+    //!  A channel is created the first time either side names it.  At
+    //!  most MaxChannels() channels may exist; a peer that names more,
+    //!  or sends a message larger than MaxMessageSize(), is
+    //!  disconnected.
+    //!
+    //!  All members are thread safe; Send() and Receive() may be called
+    //!  from many threads at once.  Start() splits the Peer (see
+    //!  Peer::Split()) so our reader and writer threads each have their
+    //!  own half of the connection.  That leaves the Peer disconnected;
+    //!  the connection belongs to the multiplexer from then on, and
+    //!  Stop() shuts it down.  Hence a Peer over a MemoryPipe or in
+    //!  shared memory mode can't be multiplexed.
+    //------------------------------------------------------------------------
+    class ChannelMultiplexer
+    {
+    public:
+      static constexpr uint32_t  k_defaultWindow = 1024 * 1024;
+      static constexpr uint32_t  k_defaultChunkSize = 64 * 1024;
+      static constexpr uint32_t  k_defaultMaxMessageSize = 64 * 1024 * 1024;
+      static constexpr uint32_t  k_defaultMaxChannels = 1024;
+      
+      //----------------------------------------------------------------------
+      //!  Construct for the given authenticated @c peer, which must
+      //!  outlive the call to Start().  @c window is the flow control window
+      //!  of each channel, @c chunkSize the maximum number of bytes of a
+      //!  message sent at once, @c maxMessageSize the largest message
+      //!  we'll send or reassemble, and @c maxChannels the largest number
+      //!  of channels we'll keep.
+      //----------------------------------------------------------------------
+      ChannelMultiplexer(Peer & peer, uint32_t window = k_defaultWindow,
+                         uint32_t chunkSize = k_defaultChunkSize,
+                         uint32_t maxMessageSize = k_defaultMaxMessageSize,
+                         uint32_t maxChannels = k_defaultMaxChannels);
+
+      //----------------------------------------------------------------------
+      //!  Stops the multiplexer.
+      //----------------------------------------------------------------------
+      ~ChannelMultiplexer();
+
+      ChannelMultiplexer(const ChannelMultiplexer &) = delete;
+      ChannelMultiplexer & operator = (const ChannelMultiplexer &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Splits the Peer and starts the threads that send and receive
+      //!  chunks.  Returns true on success (or if already started), false
+      //!  on failure.
+      //----------------------------------------------------------------------
+      bool Start();
+
+      //----------------------------------------------------------------------
+      //!  Shuts down the Peer's connection and stops the threads.
+      //!  Pending Send() and Receive() calls return false.
+      //----------------------------------------------------------------------
+      void Stop();
+
+      //----------------------------------------------------------------------
+      //!  Sets the send priority of the given @c channel.  Higher values
+      //!  are served first.  The default priority of a channel is 0.
+      //!  This only affects our side of the connection.
+      //----------------------------------------------------------------------
+      void SetPriority(uint32_t channel, uint8_t priority);
+
+      //----------------------------------------------------------------------
+      //!  Sends @c msg on the given @c channel.  Blocks until the whole
+      //!  message has been handed to the Peer.  Returns true on success,
+      //!  false if the multiplexer is stopped, the connection failed,
+      //!  @c msg is larger than MaxMessageSize() or @c channel would be
+      //!  one more than MaxChannels().
+      //----------------------------------------------------------------------
+      bool Send(uint32_t channel, std::string_view msg);
+
+      //----------------------------------------------------------------------
+      //!  Receives the next message on the given @c channel into @c msg,
+      //!  waiting as long as needed.  Returns true on success, false if
+      //!  the multiplexer is stopped or the connection was closed.
+      //----------------------------------------------------------------------
+      bool Receive(uint32_t channel, std::string & msg);
+
+      //----------------------------------------------------------------------
+      //!  Like Receive(channel, msg), but gives up after @c timeout.
+      //----------------------------------------------------------------------
+      bool Receive(uint32_t channel, std::string & msg,
+                   std::chrono::milliseconds timeout);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the connection failed or was closed, or the
+      //!  multiplexer was stopped.
+      //----------------------------------------------------------------------
+      bool Closed() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the flow control window of each channel.
+      //----------------------------------------------------------------------
+      uint32_t Window() const
+      { return _window; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum size of a chunk.
+      //----------------------------------------------------------------------
+      uint32_t ChunkSize() const
+      { return _chunkSize; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum size of a message.
+      //----------------------------------------------------------------------
+      uint32_t MaxMessageSize() const
+      { return _maxMessageSize; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of channels.
+      //----------------------------------------------------------------------
+      uint32_t MaxChannels() const
+      { return _maxChannels; }
+      
+    private:
+      //  A message being sent, owned by the Send() call waiting for it.
+      //  Once the writer takes the last chunk, the message is no longer
+      //  queued but the writer still refers to it (see _inFlight).
+      struct Outgoing
+      {
+        std::string_view  msg;
+        size_t            offset;
+        bool              done;
+      };
+
+      //  A received message and the credit to return when it's consumed.
+      struct Incoming
+      {
+        std::string  msg;
+        uint32_t     credit;
+      };
+      
+      struct Channel
+      {
+        uint8_t                 priority = 0;
+        uint32_t                sendCredit = 0;
+        std::deque<Outgoing *>  outgoing;
+        uint32_t                received = 0;   //  not yet credited back
+        uint32_t                creditToGrant = 0;
+        std::string             partial;
+        std::deque<Incoming>    incoming;
+      };
+
+      Peer                         &_peer;
+      const uint32_t                _window;
+      const uint32_t                _chunkSize;
+      const uint32_t                _maxMessageSize;
+      const uint32_t                _maxChannels;
+      mutable std::mutex            _mtx;
+      std::condition_variable       _sendCv;
+      std::condition_variable       _recvCv;
+      std::condition_variable       _doneCv;
+      std::map<uint32_t,Channel>    _channels;
+      const Outgoing               *_inFlight;
+      uint32_t                      _lastSent;
+      bool                          _run;
+      bool                          _closed;
+      PeerReader                    _peerReader;
+      PeerWriter                    _peerWriter;
+      std::thread                   _writerThread;
+      std::thread                   _readerThread;
+
+      Channel *GetChannel(uint32_t channel);
+      Channel *NextToSend(uint32_t & channel);
+      void Grant(Channel & ch, uint32_t credit);
+      void WriterLoop();
+      void ReaderLoop();
+      void Close();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCECHANNELMULTIPLEXER_HH_
@@ -44,7 +44,9 @@
 
 #include <iostream>
 #include <string>
+#include <string_view>
 
+#include "DwmCredenceSecureString.hh"
 #include "DwmCredenceShortString.hh"
 
 namespace Dwm {
@@ -54,7 +56,9 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  Encapsulate an Ed25519 key: an identifier and the key content.  This
     //!  key is half of a key pair, and is used to represent a public key or
-    //!  a private key.
+    //!  a private key.  The id is stored inline; the key content is kept
+    //!  in a SecureArena slot, sized for an Ed25519 secret key (the larger
+    //!  half of a key pair).
     //------------------------------------------------------------------------
     class Ed25519Key
     {
@@ -88,29 +92,29 @@ namespace Dwm {
       //!  Construct from the given @c id and @c key.  Note that @c key
       //!  must be in the binary representation.
       //----------------------------------------------------------------------
-      Ed25519Key(const std::string & id, const std::string & key);
+      Ed25519Key(std::string_view id, std::string_view key);
       
       //----------------------------------------------------------------------
       //!  Returns the id.
       //----------------------------------------------------------------------
-      const std::string & Id() const   { return _id.Value(); }
+      std::string_view Id() const   { return _id.Value(); }
 
       //----------------------------------------------------------------------
       //!  Sets and returns the id.
       //----------------------------------------------------------------------
-      const std::string & Id(const std::string & id)
+      std::string_view Id(std::string_view id)
       { _id = id;  return _id.Value(); }
       
       //----------------------------------------------------------------------
       //!  Returns the key content, in binary representation.
       //----------------------------------------------------------------------
-      const std::string & Key() const  { return _key.Value(); }
+      std::string_view Key() const  { return _key.Value(); }
 
       //----------------------------------------------------------------------
       //!  Sets and returns the key content, in binary representation.
       //!  @c key must be in the binary representation.
       //----------------------------------------------------------------------
-      const std::string & Key(const std::string & key)
+      std::string_view Key(std::string_view key)
       { _key = key; return _key.Value(); }
 
       //----------------------------------------------------------------------
@@ -123,7 +127,7 @@ namespace Dwm {
       //!  Returns the key content as a base64-encoded string (which should
       //!  be the same as @c keyBase64).
       //----------------------------------------------------------------------
-      std::string KeyBase64(const std::string & keyBase64);
+      std::string KeyBase64(std::string_view keyBase64);
       
       //----------------------------------------------------------------------
       //!  Reads the key from the given istream @c is.  Note that the key
@@ -165,10 +169,19 @@ namespace Dwm {
       //!  equality operator
       //----------------------------------------------------------------------
       bool operator == (const Ed25519Key &) const = default;
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of bytes written by Write().
+      //----------------------------------------------------------------------
+      static consteval size_t MaxStreamedLength()
+      {
+        return (decltype(_id)::MaxStreamedLength()
+                + decltype(_key)::MaxStreamedLength());
+      }
       
     private:
-      ShortString<64>  _id;
-      ShortString<64>  _key;
+      ShortString<64>   _id;
+      SecureString<64>  _key;
     };
     
   }  // namespace Credence
@@ -0,0 +1,113 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceEd25519phStream.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::Ed25519phStream class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEED25519PHSTREAM_HH_
+#define _DWMCREDENCEED25519PHSTREAM_HH_
+
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <cstdint>
+#include <iostream>
+#include <span>
+#include <string>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  The Ed25519ph (pre-hashed) state shared by StreamSigner and
+    //!  StreamVerifier.  The message is fed in pieces via the Update()
+    //!  members, from spans, istreams or memory-mapped files; derived
+    //!  classes supply Final().
+    //------------------------------------------------------------------------
+    class Ed25519phStream
+    {
+    public:
+      Ed25519phStream(const Ed25519phStream &) = delete;
+      Ed25519phStream & operator = (const Ed25519phStream &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Discards everything passed to Update() so far.
+      //----------------------------------------------------------------------
+      void Reset();
+      
+      //----------------------------------------------------------------------
+      //!  Adds the given @c data to the message.  Returns true on success,
+      //!  false on failure.
+      //----------------------------------------------------------------------
+      bool Update(std::span<const uint8_t> data);
+
+      //----------------------------------------------------------------------
+      //!  Adds everything that can be read from the given istream @c is to
+      //!  the message, reading in fixed-size chunks.  Returns true on
+      //!  success (@c is reached EOF), false on failure.
+      //----------------------------------------------------------------------
+      bool Update(std::istream & is);
+
+      //----------------------------------------------------------------------
+      //!  Adds the content of the file at the given @c path to the message,
+      //!  using a read-only memory mapping of the file.  Returns true on
+      //!  success, false on failure.
+      //----------------------------------------------------------------------
+      bool UpdateFile(const std::string & path);
+      
+    protected:
+      crypto_sign_state  _state;
+
+      //----------------------------------------------------------------------
+      //!  Default constructor.
+      //----------------------------------------------------------------------
+      Ed25519phStream();
+
+      //----------------------------------------------------------------------
+      //!  Destructor.  Clears the hash state.
+      //----------------------------------------------------------------------
+      ~Ed25519phStream();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEED25519PHSTREAM_HH_
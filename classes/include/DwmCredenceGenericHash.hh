@@ -47,7 +47,9 @@ extern "C" {
 }
 
 #include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace Dwm {
 
@@ -75,7 +77,7 @@ namespace Dwm {
       //----------------------------------------------------------------------
       //!  Updates the hash.
       //----------------------------------------------------------------------
-      void Update(const std::string & chunk)
+      void Update(std::string_view chunk)
       {
         crypto_generichash_update(&_h, (const uint8_t *)chunk.data(),
                                   chunk.size());
@@ -91,6 +93,16 @@ namespace Dwm {
         crypto_generichash_final(&_h, finalbuf, sizeof(finalbuf));
         return std::string((const char *)finalbuf, OutLen);
       }
+
+      //----------------------------------------------------------------------
+      //!  Writes the final hash to @c out.  Used when the hash is secret
+      //!  and shouldn't land in a heap-allocated string.
+      //----------------------------------------------------------------------
+      void Final(std::span<uint8_t,OutLen> out)
+      {
+        crypto_generichash_final(&_h, out.data(), out.size());
+        return;
+      }
       
     private:
       crypto_generichash_state  _h;
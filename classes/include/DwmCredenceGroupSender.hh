@@ -0,0 +1,155 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceGroupSender.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::GroupSender class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEGROUPSENDER_HH_
+#define _DWMCREDENCEGROUPSENDER_HH_
+
+#include <atomic>
+#include <cstdint>
+#include <sstream>
+#include <string>
+#include <string_view>
+
+#include "DwmCredencePeer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  Lets many threads send on one Peer at once, with group commit.
+    //!
+    //!  Each sender serializes its message on its own thread and pushes
+    //!  it onto a lock-free queue.  One of the waiting senders becomes
+    //!  the flusher: it takes everything queued, writes it all into a
+    //!  single encrypted frame (one seal, one write), and then tells
+    //!  each sender whether its message went out.  Messages that arrive
+    //!  while a frame is being written go out together in the next one.
+    //!  So the busier it gets, the more messages share each frame, and
+    //!  throughput goes up with contention instead of down.
+    //!
+    //!  The receiver needs nothing special; it gets the messages one at
+    //!  a time from Peer::Receive() as usual.  Messages from one thread
+    //!  arrive in the order that thread sent them.  While a GroupSender
+    //!  is in use, nothing else may send on the Peer.
+    //------------------------------------------------------------------------
+    class GroupSender
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Frames are sealed early if they reach this size, so one frame
+      //!  can't grow without bound under a flood of senders.
+      //----------------------------------------------------------------------
+      static constexpr size_t  k_maxFrameSize = 256 * 1024;
+      
+      struct Counters
+      {
+        uint64_t  messages;   //!< messages sent
+        uint64_t  frames;     //!< encrypted frames written
+        uint64_t  failures;   //!< messages that failed to send
+        uint64_t  maxBatch;   //!< most messages taken by one flusher
+      };
+
+      //----------------------------------------------------------------------
+      //!  Construct for the given connected @c peer, which must outlive
+      //!  the GroupSender.
+      //----------------------------------------------------------------------
+      GroupSender(Peer & peer);
+
+      GroupSender(const GroupSender &) = delete;
+      GroupSender & operator = (const GroupSender &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Sends @c msg, waiting until it has been written.  Safe to call
+      //!  from many threads at once.  Returns true on success, false on
+      //!  failure.  Same requirements on T as Peer::Send().
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamWritable<T>
+      bool Send(const T & msg)
+      {
+        std::ostringstream  os;
+        if (StreamIO::Write(os, msg)) {
+          return SendSerialized(os.view());
+        }
+        FSyslog(LOG_ERR, "Failed to serialize message for {}",
+                _peer.EndPointString());
+        return false;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Like Send(), for an already serialized message.
+      //----------------------------------------------------------------------
+      bool SendSerialized(std::string_view msg);
+
+      //----------------------------------------------------------------------
+      //!  Returns a copy of the counters.
+      //----------------------------------------------------------------------
+      Counters Stats() const;
+      
+    private:
+      //  A queued message.  Lives on the sender's stack; the sender
+      //  doesn't return until the flusher has set done.
+      struct Node
+      {
+        std::string_view   msg;
+        Node              *next;
+        bool               ok;
+        std::atomic<bool>  done;
+      };
+      
+      Peer                   &_peer;
+      std::atomic<Node *>     _head;
+      std::atomic<bool>       _flushing;
+      std::atomic<uint64_t>   _messages;
+      std::atomic<uint64_t>   _frames;
+      std::atomic<uint64_t>   _failures;
+      std::atomic<uint64_t>   _maxBatch;
+
+      void FlushBatch();
+      void Complete(Node *first, Node *end, bool ok);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEGROUPSENDER_HH_
@@ -0,0 +1,182 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceHandshakeExecutor.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::HandshakeExecutor class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEHANDSHAKEEXECUTOR_HH_
+#define _DWMCREDENCEHANDSHAKEEXECUTOR_HH_
+
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <functional>
+#include <mutex>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A concurrency limiter for the CPU-heavy parts of connection
+    //!  handshakes: ephemeral key generation, key agreement (X25519
+    //!  scalar multiplication), and signing and verification of
+    //!  challenges (Ed25519).  With an executor set on a Peer (see
+    //!  Peer::SetHandshakeExecutor()), at most a fixed number of these
+    //!  operations run at once regardless of how many connections are
+    //!  in progress.
+    //!
+    //!  This is a counting semaphore, not a thread pool.  RunLimited()
+    //!  waits for a free slot and then runs the operation on the calling
+    //!  thread, which is blocked in handshake I/O anyway.
+    //!
+    //!  The number of callers waiting for a slot is bounded.  When it's
+    //!  reached, RunLimited() fails immediately instead of waiting
+    //!  (backpressure), and the handshake that tried to run the
+    //!  operation fails.
+    //!
+    //!  Wait and run time are tracked per operation type; see Stats().
+    //------------------------------------------------------------------------
+    class HandshakeExecutor
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+      
+      //----------------------------------------------------------------------
+      //!  Handshake operation types.
+      //----------------------------------------------------------------------
+      enum class Operation {
+        e_keyGeneration = 0,
+        e_keyAgreement  = 1,
+        e_sign          = 2,
+        e_verify        = 3
+      };
+
+      static constexpr size_t  k_numOperations = 4;
+      
+      //----------------------------------------------------------------------
+      //!  Latency metrics for one operation type.  Times are in
+      //!  nanoseconds.
+      //----------------------------------------------------------------------
+      struct OperationStats
+      {
+        uint64_t  completed    = 0;
+        uint64_t  rejected     = 0;
+        uint64_t  totalWaitNs  = 0;
+        uint64_t  maxWaitNs    = 0;
+        uint64_t  totalRunNs   = 0;
+        uint64_t  maxRunNs     = 0;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Construct to allow at most @c maxRunning operations at once and
+      //!  at most @c maxWaiting callers waiting for a slot.  If
+      //!  @c maxRunning is 0, std::thread::hardware_concurrency() is
+      //!  used.  Operations are refused until Start() is called.
+      //----------------------------------------------------------------------
+      HandshakeExecutor(size_t maxRunning = 0, size_t maxWaiting = 256);
+
+      //----------------------------------------------------------------------
+      //!  Stops the executor.
+      //----------------------------------------------------------------------
+      ~HandshakeExecutor();
+
+      HandshakeExecutor(const HandshakeExecutor &) = delete;
+      HandshakeExecutor & operator = (const HandshakeExecutor &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Starts accepting operations.  Returns true.
+      //----------------------------------------------------------------------
+      bool Start();
+
+      //----------------------------------------------------------------------
+      //!  Stops accepting operations.  Waiting callers fail, and Stop()
+      //!  returns when running operations have finished (or when Start()
+      //!  is called again while it waits).
+      //----------------------------------------------------------------------
+      void Stop();
+
+      //----------------------------------------------------------------------
+      //!  Waits for a free slot and runs @c fn on the calling thread, as
+      //!  an operation of the given type @c op.  Returns true if @c fn
+      //!  was run, false if the executor is not running, too many callers
+      //!  are already waiting, or @c fn threw.
+      //----------------------------------------------------------------------
+      bool RunLimited(Operation op, std::function<void()> fn);
+
+      //----------------------------------------------------------------------
+      //!  If @c executor is not nullptr, calls
+      //!  @c executor->RunLimited(op,fn).  Else runs @c fn on the calling
+      //!  thread and returns true.
+      //----------------------------------------------------------------------
+      static bool RunLimited(HandshakeExecutor *executor, Operation op,
+                             std::function<void()> fn);
+      
+      //----------------------------------------------------------------------
+      //!  Returns the metrics for the given operation type.
+      //----------------------------------------------------------------------
+      OperationStats Stats(Operation op) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of callers waiting for a slot.
+      //----------------------------------------------------------------------
+      size_t Waiting() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of callers waiting for a slot.
+      //----------------------------------------------------------------------
+      size_t MaxWaiting() const
+      { return _maxWaiting; }
+      
+    private:
+      size_t                                     _maxRunning;
+      size_t                                     _maxWaiting;
+      mutable std::mutex                         _mtx;
+      std::condition_variable                    _cv;
+      size_t                                     _running;
+      size_t                                     _waiting;
+      bool                                       _run;
+      std::array<OperationStats,k_numOperations> _stats;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEHANDSHAKEEXECUTOR_HH_
@@ -42,6 +42,14 @@
 #ifndef _DWMCREDENCEKXKEYPAIR_HH_
 #define _DWMCREDENCEKXKEYPAIR_HH_
 
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <string>
+#include <string_view>
+
+#include "DwmCredenceSecureString.hh"
 #include "DwmCredenceShortString.hh"
 
 namespace Dwm {
@@ -49,7 +57,9 @@ namespace Dwm {
   namespace Credence {
 
     //------------------------------------------------------------------------
-    //!  Encapsulates a key exchange key pair.
+    //!  Encapsulates a key exchange key pair.  The public key is stored
+    //!  inline; the secret key, and shared keys derived from it, are kept
+    //!  in SecureArena slots.
     //------------------------------------------------------------------------
     class KXKeyPair
     {
@@ -63,16 +73,20 @@ namespace Dwm {
       //!  Clears the keys before destroying them.
       //----------------------------------------------------------------------
       ~KXKeyPair();
+
+      using PublicKeyType = ShortString<crypto_box_PUBLICKEYBYTES>;
+      using SecretKeyType = SecureString<crypto_box_SECRETKEYBYTES>;
+      using SharedKeyType = SecureString<crypto_generichash_BYTES>;
       
       //----------------------------------------------------------------------
       //!  Returns a const reference to the public key.
       //----------------------------------------------------------------------
-      const ShortString<255> & PublicKey() const;
+      const PublicKeyType & PublicKey() const;
       
       //----------------------------------------------------------------------
       //!  Returns a const reference to the secret key.
       //----------------------------------------------------------------------
-      const ShortString<255> & SecretKey() const;
+      const SecretKeyType & SecretKey() const;
 
       //----------------------------------------------------------------------
       //!  Returns the minimum number of bytes to represent the public key
@@ -82,13 +96,14 @@ namespace Dwm {
       
       //----------------------------------------------------------------------
       //!  Given the public key of a peer, returns a shared secret key that
-      //!  can be used to encrypt and decrypt data.
+      //!  can be used to encrypt and decrypt data.  Returns an empty key
+      //!  on failure.
       //----------------------------------------------------------------------
-      std::string SharedKey(const std::string & theirPublicKey) const;
+      SharedKeyType SharedKey(std::string_view theirPublicKey) const;
 
     private:
-      ShortString<255>  _publicKey;
-      ShortString<255>  _secretKey;
+      PublicKeyType  _publicKey;
+      SecretKeyType  _secretKey;
 
     };
     
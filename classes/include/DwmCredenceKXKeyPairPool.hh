@@ -0,0 +1,136 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceKXKeyPairPool.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KXKeyPairPool class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEKXKEYPAIRPOOL_HH_
+#define _DWMCREDENCEKXKEYPAIRPOOL_HH_
+
+#include <condition_variable>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+#include "DwmCredenceKXKeyPair.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A bounded pool of pre-generated ephemeral key exchange key pairs.
+    //!  A background thread keeps the pool filled, so that a handshake
+    //!  can take a ready key pair instead of generating one (a random
+    //!  secret key and a fixed-base scalar multiplication) before it can
+    //!  send its public key.
+    //!
+    //!  Each key pair is handed out exactly once; Get() removes it from
+    //!  the pool and the caller owns it from then on.  Key pairs are
+    //!  cleared when destroyed, including those left in the pool when it
+    //!  is stopped.  If the pool is empty (or not running), Get() just
+    //!  generates a new key pair inline.
+    //!
+    //!  To use a pool for a Peer's key exchanges, pass it to
+    //!  Peer::SetKeyPairPool() (or PeerPool::SetKeyPairPool()).
+    //------------------------------------------------------------------------
+    class KXKeyPairPool
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Construct with the given maximum number of pre-generated key
+      //!  pairs.  The pool is empty and idle until Start() is called.
+      //----------------------------------------------------------------------
+      KXKeyPairPool(size_t capacity = 32);
+
+      //----------------------------------------------------------------------
+      //!  Stops the background thread and clears all pooled key pairs.
+      //----------------------------------------------------------------------
+      ~KXKeyPairPool();
+
+      KXKeyPairPool(const KXKeyPairPool &) = delete;
+      KXKeyPairPool & operator = (const KXKeyPairPool &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Starts the background thread that fills the pool.  Returns true
+      //!  on success (or if already started), false on failure.  Start()
+      //!  and Stop() may be called concurrently.
+      //----------------------------------------------------------------------
+      bool Start();
+
+      //----------------------------------------------------------------------
+      //!  Stops the background thread and clears all pooled key pairs.
+      //----------------------------------------------------------------------
+      void Stop();
+
+      //----------------------------------------------------------------------
+      //!  Removes a key pair from the pool and returns it.  If the pool is
+      //!  empty, returns a newly generated key pair.  Never returns a
+      //!  nullptr.
+      //----------------------------------------------------------------------
+      std::unique_ptr<KXKeyPair> Get();
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of key pairs currently in the pool.
+      //----------------------------------------------------------------------
+      size_t Size() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of key pairs in the pool.
+      //----------------------------------------------------------------------
+      size_t Capacity() const
+      { return _capacity; }
+      
+    private:
+      size_t                                  _capacity;
+      std::mutex                              _startStopMtx;
+      mutable std::mutex                      _mtx;
+      std::condition_variable                 _cv;
+      std::deque<std::unique_ptr<KXKeyPair>>  _keyPairs;
+      std::thread                             _thread;
+      bool                                    _run;
+
+      void Run();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEKXKEYPAIRPOOL_HH_
@@ -0,0 +1,138 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceKeyAuthorities.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KeyAuthorities class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEKEYAUTHORITIES_HH_
+#define _DWMCREDENCEKEYAUTHORITIES_HH_
+
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <array>
+#include <cstdint>
+#include <shared_mutex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+#include "DwmCredenceKeyEndorsement.hh"
+#include "DwmCredenceKnownKeys.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  Encapsulates the public keys of the authorities we trust to endorse
+    //!  peer keys (see KeyEndorsement), and the set of revoked public keys.
+    //!  The authority keys are stored in the same form as KnownKeys, in a
+    //!  file named authority_keys by default.  The revoked keys are stored
+    //!  in the same form in a file named revoked_keys by default; only the
+    //!  key content of each entry is used, and the IDs are informational.
+    //!
+    //!  With KeyAuthorities, a host only needs the small set of authority
+    //!  keys and the revocation list instead of the key of every peer that
+    //!  may connect to it.
+    //------------------------------------------------------------------------
+    class KeyAuthorities
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Construct with the given storage directory @c dirName and the
+      //!  file names @c authoritiesFileName and @c revokedFileName within
+      //!  the storage directory.
+      //----------------------------------------------------------------------
+      KeyAuthorities(const std::string & dirName = "~/.credence",
+                     const std::string & authoritiesFileName =
+                     "authority_keys",
+                     const std::string & revokedFileName = "revoked_keys");
+
+      //----------------------------------------------------------------------
+      //!  Copy constructor.
+      //----------------------------------------------------------------------
+      KeyAuthorities(const KeyAuthorities & keyAuthorities);
+      
+      //----------------------------------------------------------------------
+      //!  Verifies the given @c endorsement presented by a peer claiming
+      //!  the given @c id.  The endorsement must have been signed by one of
+      //!  our authorities, must be for @c id, must not have expired, and
+      //!  neither the endorsed key nor the authority's key may be revoked.
+      //!  On success, sets @c publicKey to the endorsed public key and
+      //!  returns true.  Returns false on failure.
+      //----------------------------------------------------------------------
+      bool Verify(std::string_view id, const KeyEndorsement & endorsement,
+                  Ed25519Key & publicKey) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the given @c publicKey (in binary form) has been
+      //!  revoked.
+      //----------------------------------------------------------------------
+      bool IsRevoked(std::string_view publicKey) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the authority keys.
+      //----------------------------------------------------------------------
+      const KnownKeys & Authorities() const
+      { return _authorities; }
+      
+      //----------------------------------------------------------------------
+      //!  Reloads the authority keys and revoked keys from persistent
+      //!  storage.
+      //----------------------------------------------------------------------
+      void Reload();
+      
+    private:
+      using RawKey = std::array<uint8_t,crypto_sign_PUBLICKEYBYTES>;
+      
+      std::string                 _dirName;
+      std::string                 _revokedFileName;
+      KnownKeys                   _authorities;
+      mutable std::shared_mutex   _revokedMtx;
+      std::vector<RawKey>         _revoked;
+
+      void LoadRevoked();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEKEYAUTHORITIES_HH_
@@ -0,0 +1,161 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceKeyEndorsement.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KeyEndorsement class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEKEYENDORSEMENT_HH_
+#define _DWMCREDENCEKEYENDORSEMENT_HH_
+
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <cstdint>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+#include "DwmCredenceEd25519Key.hh"
+#include "DwmCredenceShortString.hh"
+#include "DwmCredenceUtils.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  Encapsulates an endorsement of an Ed25519 public key by an
+    //!  authority, much like a minimal certificate.  The endorsement holds
+    //!  the ID of the authority and a message signed with the authority's
+    //!  secret key.  The signed message contains the endorsed public key
+    //!  (its ID and key content) and an expiration time.  A peer whose
+    //!  public key is not in our KnownKeys may present an endorsement
+    //!  during authentication, and we'll accept its public key if the
+    //!  endorsement was signed by an authority we trust (see
+    //!  KeyAuthorities), has not expired and has not been revoked.
+    //------------------------------------------------------------------------
+    class KeyEndorsement
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Default constructor.  Creates an empty endorsement.
+      //----------------------------------------------------------------------
+      KeyEndorsement() = default;
+
+      //----------------------------------------------------------------------
+      //!  Creates an endorsement of the given @c subject public key, signed
+      //!  with the given @c authoritySecretKey, which will expire at
+      //!  @c expires.  The ID of @c authoritySecretKey is used as the
+      //!  authority ID.  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool Create(const Ed25519Key & subject,
+                  const Ed25519Key & authoritySecretKey,
+                  Utils::TimePoint expires);
+      
+      //----------------------------------------------------------------------
+      //!  Returns true if the endorsement is empty.
+      //----------------------------------------------------------------------
+      bool Empty() const
+      { return _signed.Value().empty(); }
+      
+      //----------------------------------------------------------------------
+      //!  Returns the ID of the authority that signed the endorsement.
+      //----------------------------------------------------------------------
+      std::string_view AuthorityId() const
+      { return _authorityId.Value(); }
+
+      //----------------------------------------------------------------------
+      //!  Opens the endorsement using the authority's @c authorityPublicKey.
+      //!  On success, sets @c subject to the endorsed public key, sets
+      //!  @c expires to the expiration time of the endorsement and returns
+      //!  true.  Returns false if the endorsement was not signed with the
+      //!  secret key corresponding to @c authorityPublicKey or is
+      //!  malformed.  Note that this does not check the expiration time.
+      //----------------------------------------------------------------------
+      bool Open(std::string_view authorityPublicKey,
+                Ed25519Key & subject, Utils::TimePoint & expires) const;
+      
+      //----------------------------------------------------------------------
+      //!  Reads the endorsement from the given istream @c is.  Returns
+      //!  @c is.
+      //----------------------------------------------------------------------
+      std::istream & Read(std::istream & is);
+
+      //----------------------------------------------------------------------
+      //!  Writes the endorsement to the given ostream @c os.  Returns @c os.
+      //----------------------------------------------------------------------
+      std::ostream & Write(std::ostream & os) const;
+
+      //----------------------------------------------------------------------
+      //!  Clears the endorsement.
+      //----------------------------------------------------------------------
+      void Clear();
+      
+      //----------------------------------------------------------------------
+      //!  Prints the endorsement to the given ostream @c os in the form
+      //!  used when storing it in a file: the authority ID, the string
+      //!  'ed25519-endorsement' and the base64-encoded signed message.
+      //----------------------------------------------------------------------
+      friend std::ostream &
+      operator << (std::ostream & os, const KeyEndorsement & endorsement);
+
+      //----------------------------------------------------------------------
+      //!  Reads the endorsement from the given istream @c is, in the form
+      //!  emitted by operator <<.
+      //----------------------------------------------------------------------
+      friend std::istream &
+      operator >> (std::istream & is, KeyEndorsement & endorsement);
+      
+    private:
+      //----------------------------------------------------------------------
+      //!  The signed message is the signature followed by the subject key
+      //!  and the expiration time in seconds.
+      //----------------------------------------------------------------------
+      static constexpr size_t  k_maxSignedLength =
+        crypto_sign_BYTES + Ed25519Key::MaxStreamedLength() + sizeof(uint64_t);
+      
+      ShortString<64>                 _authorityId;
+      ShortString<k_maxSignedLength>  _signed;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEKEYENDORSEMENT_HH_
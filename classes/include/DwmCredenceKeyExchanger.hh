@@ -43,29 +43,64 @@
 #define _DWMCREDENCEKEYEXCHANGER_HH_
 
 #include <chrono>
+#include <memory>
 #include <string>
 #include <boost/asio.hpp>
 
+#include "DwmCredenceHandshakeExecutor.hh"
+#include "DwmCredenceKXKeyPairPool.hh"
+#include "DwmCredenceMemoryPipe.hh"
+
 namespace Dwm {
 
   namespace Credence {
 
     //------------------------------------------------------------------------
-    //!  
+    //!  Performs the ephemeral X25519 key exchange at the start of a
+    //!  connection.
     //------------------------------------------------------------------------
     class KeyExchanger
     {
     public:
+      //----------------------------------------------------------------------
+      //!  Exchanges ephemeral public keys with the peer on @c s and stores
+      //!  the agreed shared key in @c agreedKey.  Waits up to @c timeout
+      //!  for the peer's public key.  If @c executor is not nullptr, key
+      //!  generation and key agreement are run by @c executor (see
+      //!  HandshakeExecutor::RunLimited()).  If @c keyPairPool is not
+      //!  nullptr, our ephemeral key pair is taken from it instead of
+      //!  being generated here.  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
       static bool ExchangeKeys(boost::asio::ip::tcp::iostream & s,
-                               std::string & agreedKey,
+                               KXKeyPair::SharedKeyType & agreedKey,
                                std::chrono::milliseconds timeout =
-                               std::chrono::milliseconds(1000));
+                               std::chrono::milliseconds(1000),
+                               HandshakeExecutor *executor = nullptr,
+                               KXKeyPairPool *keyPairPool = nullptr);
 
+      //----------------------------------------------------------------------
+      //!  Like the TCP version, for UNIX domain sockets.
+      //----------------------------------------------------------------------
       static bool
       ExchangeKeys(boost::asio::local::stream_protocol::iostream & s,
-                   std::string & agreedKey,
+                   KXKeyPair::SharedKeyType & agreedKey,
                    std::chrono::milliseconds timeout =
-                   std::chrono::milliseconds(1000));
+                   std::chrono::milliseconds(1000),
+                   HandshakeExecutor *executor = nullptr,
+                   KXKeyPairPool *keyPairPool = nullptr);
+
+      //----------------------------------------------------------------------
+      //!  Like the TCP version, for an in-process MemoryPipe.
+      //----------------------------------------------------------------------
+      static bool ExchangeKeys(MemoryPipe & pipe,
+                               KXKeyPair::SharedKeyType & agreedKey,
+                               std::chrono::milliseconds timeout =
+                               std::chrono::milliseconds(1000),
+                               HandshakeExecutor *executor = nullptr,
+                               KXKeyPairPool *keyPairPool = nullptr);
+
+    private:
+      static std::unique_ptr<KXKeyPair> NewKeyPair(KXKeyPairPool *pool);
     };
     
   }  // namespace Credence
@@ -43,6 +43,7 @@
 #define _DWMCREDENCEKEYSTASH_HH_
 
 #include "DwmCredenceEd25519KeyPair.hh"
+#include "DwmCredenceKeyEndorsement.hh"
 
 namespace Dwm {
 
@@ -85,6 +86,20 @@ namespace Dwm {
       //!  the retrieved Ed25519KeyPair.
       //----------------------------------------------------------------------
       bool IsValid() const;
+
+      //----------------------------------------------------------------------
+      //!  Saves the given endorsement of our public key.  Returns true on
+      //!  success, false on failure.
+      //----------------------------------------------------------------------
+      bool SaveEndorsement(const KeyEndorsement & endorsement) const;
+      
+      //----------------------------------------------------------------------
+      //!  Fetches the endorsement of our public key from the key stash and
+      //!  stores it in @c endorsement.  Returns true on success.  Returns
+      //!  false (and clears @c endorsement) if there is no endorsement in
+      //!  the key stash or it could not be read.
+      //----------------------------------------------------------------------
+      bool GetEndorsement(KeyEndorsement & endorsement) const;
       
     private:
       std::string  _dirName;
@@ -42,10 +42,13 @@
 #ifndef _DWMCREDENCEKNOWNKEYS_HH_
 #define _DWMCREDENCEKNOWNKEYS_HH_
 
+#include <cstdint>
+#include <filesystem>
 #include <iostream>
 #include <map>
 #include <shared_mutex>
 #include <string>
+#include <vector>
 
 namespace Dwm {
 
@@ -57,6 +60,17 @@ namespace Dwm {
     //!  the constructor.  By default, this directory is .credence in the
     //!  user's home directory and the file within that directory is named
     //!  known_keys.
+    //!
+    //!  If the file name given to the constructor names a directory instead
+    //!  of a regular file (e.g. known_keys.d), every regular file in that
+    //!  directory whose name does not start with '.' is loaded as a key
+    //!  file.  The files are loaded in parallel, and merged in lexical
+    //!  order of their names.  If the same ID appears in more than one file
+    //!  with different keys, the key from the file whose name sorts first
+    //!  is used and the others are ignored (and logged).  Each file carries
+    //!  a version that is incremented whenever the file is reloaded, and
+    //!  Reload() only rereads files that have changed since they were last
+    //!  loaded.
     //------------------------------------------------------------------------
     class KnownKeys
     {
@@ -86,9 +100,31 @@ namespace Dwm {
       std::string Find(const std::string & id) const;
 
       //----------------------------------------------------------------------
-      //!  Reloads the keys from persistent storage.
+      //!  Reloads the keys from persistent storage.  When using a directory
+      //!  of key files, only the files that are new or have changed since
+      //!  they were last loaded are reread, and the keys of files that have
+      //!  been removed are dropped.
       //----------------------------------------------------------------------
       void Reload();
+
+      //----------------------------------------------------------------------
+      //!  When using a directory of key files, rereads the single key file
+      //!  @c fileName (a name within the directory, not a path, and not
+      //!  starting with '.') regardless
+      //!  of whether or not it has changed.  If the file no longer exists,
+      //!  its keys are dropped.  If it can't be checked, its keys are
+      //!  kept.  Returns true if the file was reloaded or dropped, false
+      //!  on failure or if we are not using a directory of key files.
+      //----------------------------------------------------------------------
+      bool ReloadFile(const std::string & fileName);
+
+      //----------------------------------------------------------------------
+      //!  When using a directory of key files, returns the version of the
+      //!  key file @c fileName.  The version starts at 1 when the file is
+      //!  first loaded and is incremented each time the file is reloaded.
+      //!  Returns 0 if @c fileName is not loaded.
+      //----------------------------------------------------------------------
+      uint64_t FileVersion(const std::string & fileName) const;
       
       //----------------------------------------------------------------------
       //!  Returns a copy of the encapsulated keys.
@@ -99,7 +135,9 @@ namespace Dwm {
       //!  Reads the keys from the given istream @c is, in machine-readable
       //!  form (for use with StreamIO from libDwm).  Returns @c is.  Note
       //!  that the key content is expected to be in binary form, not base64
-      //!  encoded.
+      //!  encoded.  This replaces all keys and forgets any loaded key files
+      //!  (FileVersion() returns 0 for all of them), so a later Reload()
+      //!  or ReloadFile() starts over from persistent storage.
       //----------------------------------------------------------------------
       std::istream & Read(std::istream & is);
       
@@ -126,12 +164,33 @@ namespace Dwm {
       void ClearKeys();
       
     private:
+      //----------------------------------------------------------------------
+      //!  Holds the keys and change detection data for a single key file
+      //!  in a directory of key files.
+      //----------------------------------------------------------------------
+      struct KeyFile
+      {
+        std::filesystem::file_time_type    modTime;
+        std::uintmax_t                     size;
+        uint64_t                           version;
+        std::map<std::string,std::string>  keys;
+      };
+
       std::string                        _dirName;
       std::string                        _fileName;
       mutable std::shared_mutex          _keysMtx;
       std::map<std::string,std::string>  _keys;
+      std::map<std::string,KeyFile>      _keyFiles;
 
+      std::string Path() const;
       bool LoadKeys();
+      bool LoadKeysDirectory();
+      void MergeKeyFiles();
+      static bool ReadKeyFile(const std::string & path,
+                              std::map<std::string,std::string> & keys);
+      static std::vector<bool>
+      ReadKeyFiles(const std::string & dirPath,
+                   std::vector<std::pair<std::string,KeyFile>> & keyFiles);
     };
     
     
@@ -0,0 +1,101 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceMappedFile.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::MappedFile class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEMAPPEDFILE_HH_
+#define _DWMCREDENCEMAPPEDFILE_HH_
+
+#include <cstdint>
+#include <span>
+#include <string>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A read-only memory mapping of a regular file.  Used to feed large
+    //!  files to StreamSigner and StreamVerifier without reading them into
+    //!  memory; the kernel pages the file in (and out) as needed.
+    //------------------------------------------------------------------------
+    class MappedFile
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Default constructor.
+      //----------------------------------------------------------------------
+      MappedFile();
+
+      //----------------------------------------------------------------------
+      //!  Destructor.  Unmaps the file if it's mapped.
+      //----------------------------------------------------------------------
+      ~MappedFile();
+      
+      MappedFile(const MappedFile &) = delete;
+      MappedFile & operator = (const MappedFile &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Maps the file at the given @c path, unmapping any previously
+      //!  mapped file.  Returns true on success, false on failure.  An
+      //!  empty file is not mapped but is treated as success.
+      //----------------------------------------------------------------------
+      bool Open(const std::string & path);
+
+      //----------------------------------------------------------------------
+      //!  Unmaps the file.
+      //----------------------------------------------------------------------
+      void Close();
+      
+      //----------------------------------------------------------------------
+      //!  Returns the mapped content.
+      //----------------------------------------------------------------------
+      std::span<const uint8_t> Data() const
+      { return std::span<const uint8_t>(_data, _size); }
+      
+    private:
+      const uint8_t  *_data;
+      size_t          _size;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEMAPPEDFILE_HH_
@@ -0,0 +1,165 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceMemoryPipe.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::MemoryPipe class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEMEMORYPIPE_HH_
+#define _DWMCREDENCEMEMORYPIPE_HH_
+
+#include <chrono>
+#include <iostream>
+#include <memory>
+
+#include "DwmCredenceShmInBuffer.hh"
+#include "DwmCredenceShmOutBuffer.hh"
+#include "DwmCredenceShmRing.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  One end of an in-process duplex pipe: two bounded ShmRings in
+    //!  ordinary memory, one per direction.  Create() makes both ends;
+    //!  each is typically handed to a Peer (see Peer::Accept() and
+    //!  Peer::Connect()), which then works as it does over a socket,
+    //!  with no system calls unless a side has to sleep.  Useful for
+    //!  benchmarking the handshake and framing without the kernel, and
+    //!  for components in one process that want to talk through the
+    //!  Peer API.
+    //!
+    //!  Each end must be used by one reader thread and one writer thread
+    //!  at most.  Destroying an end closes the pipe; the other end can
+    //!  still read what was sent before that.
+    //------------------------------------------------------------------------
+    class MemoryPipe
+    {
+    public:
+      static constexpr size_t  k_defaultRingSize = 256 * 1024;
+      static constexpr size_t  k_minRingSize = 4096;
+      static constexpr size_t  k_maxRingSize = 256 * 1024 * 1024;
+      
+      //----------------------------------------------------------------------
+      //!  Creates a pipe with rings of @c ringSize bytes (rounded up to
+      //!  a power of 2 and clamped to k_minRingSize and k_maxRingSize),
+      //!  and returns its ends in @c a and @c b.
+      //----------------------------------------------------------------------
+      static void Create(std::unique_ptr<MemoryPipe> & a,
+                         std::unique_ptr<MemoryPipe> & b,
+                         size_t ringSize = k_defaultRingSize);
+
+      //----------------------------------------------------------------------
+      //!  Closes the pipe.
+      //----------------------------------------------------------------------
+      ~MemoryPipe();
+      
+      MemoryPipe(const MemoryPipe &) = delete;
+      MemoryPipe & operator = (const MemoryPipe &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Returns the size of each ring.
+      //----------------------------------------------------------------------
+      size_t RingSize() const;
+      
+      //----------------------------------------------------------------------
+      //!  Returns the stream for reading from the other end.
+      //----------------------------------------------------------------------
+      std::istream & In()
+      { return _is; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the stream for writing to the other end.  Data is
+      //!  visible to the other end after a flush.
+      //----------------------------------------------------------------------
+      std::ostream & Out()
+      { return _os; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes that can be read from In() without
+      //!  blocking.
+      //----------------------------------------------------------------------
+      size_t BytesReady() const
+      { return _inBuf.BytesReady(); }
+
+      //----------------------------------------------------------------------
+      //!  Waits up to @c timeout for @c numBytes to be readable from
+      //!  In().  Returns true if they are, false on timeout or if the
+      //!  pipe is closed first.
+      //----------------------------------------------------------------------
+      bool WaitForBytesReady(size_t numBytes,
+                             std::chrono::milliseconds timeout)
+      { return _inBuf.WaitForBytesReady(numBytes, timeout); }
+      
+      //----------------------------------------------------------------------
+      //!  Flushes Out() and closes both directions, waking anyone waiting
+      //!  on them at either end.
+      //----------------------------------------------------------------------
+      void Close();
+
+      //----------------------------------------------------------------------
+      //!  Closes the direction we read from, waking a reader blocked in
+      //!  In().
+      //----------------------------------------------------------------------
+      void CloseReceive();
+
+      //----------------------------------------------------------------------
+      //!  Returns true if both directions have been closed (by either
+      //!  end).
+      //----------------------------------------------------------------------
+      bool Closed() const;
+      
+    private:
+      struct Shared;
+
+      std::shared_ptr<Shared>  _shared;
+      ShmRing                  _inRing;
+      ShmRing                  _outRing;
+      ShmInBuffer              _inBuf;
+      ShmOutBuffer             _outBuf;
+      std::istream             _is;
+      std::ostream             _os;
+
+      MemoryPipe(std::shared_ptr<Shared> shared, size_t outIdx);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEMEMORYPIPE_HH_
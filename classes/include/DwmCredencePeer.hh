@@ -42,13 +42,34 @@
 #ifndef _DWMCREDENCEPEER_HH_
 #define _DWMCREDENCEPEER_HH_
 
+extern "C" {
+  #include <sys/types.h>
+}
+
 #include <chrono>
+#include <functional>
+#include <future>
+#include <sstream>
+#include <thread>
 #include <boost/asio.hpp>
 
 #include "DwmStreamIO.hh"
 #include "DwmSysLogger.hh"
+#include "DwmCredenceAdmissionControl.hh"
+#include "DwmCredenceHandshakeExecutor.hh"
+#include "DwmCredenceKeyAuthorities.hh"
 #include "DwmCredenceKeyStash.hh"
 #include "DwmCredenceKnownKeys.hh"
+#include "DwmCredenceKXKeyPair.hh"
+#include "DwmCredenceKXKeyPairPool.hh"
+#include "DwmCredenceMemoryPipe.hh"
+#include "DwmCredencePeerReader.hh"
+#include "DwmCredencePeerWriter.hh"
+#include "DwmCredenceShmChannel.hh"
+#include "DwmCredenceSocketInBuffer.hh"
+#include "DwmCredenceSocketOutBuffer.hh"
+#include "DwmCredenceSpscRing.hh"
+#include "DwmCredenceWriteBehindQueue.hh"
 #include "DwmCredenceXChaCha20Poly1305Istream.hh"
 #include "DwmCredenceXChaCha20Poly1305Ostream.hh"
 
@@ -56,6 +77,8 @@ namespace Dwm {
 
   namespace Credence {
 
+    class Authenticator;
+    
     //------------------------------------------------------------------------
     //!  Encapsulate a network peer.
     //!  Note that once a connection is set up with Accept() or Connect(),
@@ -67,17 +90,90 @@ namespace Dwm {
     class Peer
     {
     public:
+      //----------------------------------------------------------------------
+      //!  Credentials of the process at the other end of a UNIX domain
+      //!  socket, as recorded by the kernel when the connection was made.
+      //!  @c pid is -1 where the platform doesn't report it.
+      //----------------------------------------------------------------------
+      struct Credentials
+      {
+        pid_t  pid;
+        uid_t  uid;
+        gid_t  gid;
+      };
+
+      //----------------------------------------------------------------------
+      //!  Decides if we'll drop encryption with the process having the
+      //!  given credentials.  See EnablePlaintext().
+      //----------------------------------------------------------------------
+      using CredentialCheck = std::function<bool(const Credentials &)>;
+      
+      //----------------------------------------------------------------------
+      //!  Largest chunk sent by SendStream().  ReceiveStream() refuses
+      //!  longer chunks.
+      //----------------------------------------------------------------------
+      static constexpr size_t  k_streamChunkSize = 256 * 1024;
+      
       //----------------------------------------------------------------------
       //!  Default constructor.
       //----------------------------------------------------------------------
       Peer();
 
+      //----------------------------------------------------------------------
+      //!  Disconnects.
+      //----------------------------------------------------------------------
+      ~Peer();
+
       //----------------------------------------------------------------------
       //!  Sets the time we'll wait for the peer to send its public key.
       //!  If not set, a default of 1000 milliseconds (1 second) will be
       //!  used.
       //----------------------------------------------------------------------
       void SetKeyExchangeTimeout(std::chrono::milliseconds ms);
+
+      //----------------------------------------------------------------------
+      //!  Sets the executor used to limit how many of the CPU-heavy parts
+      //!  of handshakes run at once: key generation, key agreement, and
+      //!  signing and verification of challenges in Accept(), Connect()
+      //!  and Authenticate().  These still run on the calling thread,
+      //!  which may wait for a free slot first.  If not set (or set to
+      //!  nullptr), there is no limit.  The executor must outlive the
+      //!  handshake.
+      //----------------------------------------------------------------------
+      void SetHandshakeExecutor(HandshakeExecutor *executor);
+
+      //----------------------------------------------------------------------
+      //!  Sets the pool from which the ephemeral key pairs for key
+      //!  exchanges in Accept() and Connect() are taken.  If not set (or
+      //!  set to nullptr), each key exchange generates its own key pair.
+      //!  The pool must outlive the handshake.
+      //----------------------------------------------------------------------
+      void SetKeyPairPool(KXKeyPairPool *keyPairPool);
+
+      //----------------------------------------------------------------------
+      //!  Sets the admission control used by Accept().  If set, Accept()
+      //!  checks the connection with @c admissionControl before doing any
+      //!  key exchange work, and closes it if it isn't admitted.  An
+      //!  admitted connection holds a handshake slot until Authenticate()
+      //!  finishes (or the connection is closed).  If not set (or set to
+      //!  nullptr), all connections are accepted.  @c admissionControl
+      //!  must outlive the Peer.
+      //----------------------------------------------------------------------
+      void SetAdmissionControl(AdmissionControl *admissionControl);
+
+      //----------------------------------------------------------------------
+      //!  Enables or disables TCP Fast Open in Connect(host, port).  If
+      //!  enabled, our key exchange public key is sent in the SYN and the
+      //!  server's public key arrives in the first segment after the
+      //!  SYN-ACK, saving a round trip on connections to a server we've
+      //!  seen before (the first connection fetches the Fast Open cookie).
+      //!  The server must enable it on its acceptor with
+      //!  Utils::EnableTcpFastOpen().  Falls back to a normal connect
+      //!  where not supported.  Since the TCP handshake completes during
+      //!  the key exchange in this mode, connection failures are
+      //!  reported by the key exchange.  Disabled by default.
+      //----------------------------------------------------------------------
+      void SetTcpFastOpen(bool tcpFastOpen);
       
       //----------------------------------------------------------------------
       //!  Used by a server to accept a new connection on the given TCP socket
@@ -110,6 +206,24 @@ namespace Dwm {
       //----------------------------------------------------------------------
       bool Connect(const std::string & path,
                    std::chrono::milliseconds timeOut = std::chrono::milliseconds(5000));
+
+      //----------------------------------------------------------------------
+      //!  Used by the accepting side of an in-process connection over
+      //!  one end of a MemoryPipe, while another thread calls Connect()
+      //!  with the other end.  Takes ownership of @c pipe.  The key
+      //!  exchange and everything after it are as over a socket, but
+      //!  admission control is not applied, and Split() and
+      //!  EnableSharedMemory() are not available.
+      //!  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool Accept(std::unique_ptr<MemoryPipe> && pipe);
+
+      //----------------------------------------------------------------------
+      //!  Used by the connecting side of an in-process connection over
+      //!  one end of a MemoryPipe.  See Accept(std::unique_ptr<MemoryPipe>
+      //!  &&).  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool Connect(std::unique_ptr<MemoryPipe> && pipe);
       
       //----------------------------------------------------------------------
       //!  Sets the time we'll wait for the peer to send its ID during
@@ -118,6 +232,16 @@ namespace Dwm {
       //----------------------------------------------------------------------
       void SetIdExchangeTimeout(std::chrono::milliseconds ms);
 
+      //----------------------------------------------------------------------
+      //!  Sets the sizes of the buffers between the encrypted streams and
+      //!  the socket, used from the next Connect() or Accept().  Reads
+      //!  and writes of at least a buffer's worth (a large message)
+      //!  bypass the buffer.  The defaults are
+      //!  SocketInBuffer::k_defaultBufferSize and
+      //!  SocketOutBuffer::k_defaultBufferSize.
+      //----------------------------------------------------------------------
+      void SetSocketBufferSizes(size_t readSize, size_t writeSize);
+
       //----------------------------------------------------------------------
       //!  Using the given @c keyStash and @c knownKeys, authenticate our
       //!  identity to the peer and verify the peer's identity.  This is
@@ -130,6 +254,32 @@ namespace Dwm {
       bool Authenticate(const KeyStash & keyStash,
                         const KnownKeys & knownKeys);
 
+      //----------------------------------------------------------------------
+      //!  Like Authenticate(const KeyStash &, const KnownKeys &), but in
+      //!  endorsement mode.  We send the endorsement of our public key from
+      //!  @c keyStash (if any) along with our ID, and a peer whose ID is not
+      //!  in @c knownKeys is accepted if it presents an unexpired
+      //!  endorsement of its key signed by one of the authorities in
+      //!  @c authorities.  Keys revoked in @c authorities are rejected.
+      //!  Both peers must use endorsement mode.
+      //!  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool Authenticate(const KeyStash & keyStash,
+                        const KnownKeys & knownKeys,
+                        const KeyAuthorities & authorities);
+
+      //----------------------------------------------------------------------
+      //!  Like the other Authenticate() members, but using the given
+      //!  @c authenticator.  The authenticator's identity is loaded from
+      //!  its KeyStash on first use, so a server can keep one
+      //!  Authenticator and use it for every accepted peer, from any
+      //!  number of threads.  Our ID exchange timeout and handshake
+      //!  executor are used, not the authenticator's.  All messages go
+      //!  over this peer's encrypted streams.
+      //!  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool Authenticate(Authenticator & authenticator);
+
       //----------------------------------------------------------------------
       //!  If Authenticate() was used, returns the peer's identifier.
       //----------------------------------------------------------------------
@@ -146,6 +296,9 @@ namespace Dwm {
       requires IsStreamWritable<T>
       bool Send(const T & msg)
       {
+        if (_writeBehind) {
+          return SendAsync(msg).get();
+        }
         bool  rc = false;
         if (_xos) {
           if (StreamIO::Write(*_xos, msg)) {
@@ -168,6 +321,162 @@ namespace Dwm {
         return rc;
       }
       
+      //----------------------------------------------------------------------
+      //!  Enables write-behind mode with the given @c config: messages
+      //!  given to SendAsync() are queued and written by a background
+      //!  thread, so a slow receiver doesn't stall the sender (until the
+      //!  queue fills).  Send() goes through the same queue to keep
+      //!  messages in order, but still waits for its message to be
+      //!  written.  Must be connected.  Returns true on success (or if
+      //!  already enabled), false on failure.
+      //----------------------------------------------------------------------
+      bool EnableWriteBehind(const WriteBehindQueue::Config & config =
+                             WriteBehindQueue::Config());
+
+      //----------------------------------------------------------------------
+      //!  Waits for everything queued by SendAsync() to be written, then
+      //!  leaves write-behind mode.
+      //----------------------------------------------------------------------
+      void DisableWriteBehind();
+
+      //----------------------------------------------------------------------
+      //!  Returns true if write-behind mode is enabled.
+      //----------------------------------------------------------------------
+      bool WriteBehind() const
+      { return (_writeBehind != nullptr); }
+      
+      //----------------------------------------------------------------------
+      //!  Serializes @c msg and queues it for sending, returning a future
+      //!  for the result.  What happens when the queue is full depends on
+      //!  the FullPolicy in the config given to EnableWriteBehind().
+      //!  Without write-behind mode, sends @c msg before returning.
+      //!  Same requirements on T as Send().
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamWritable<T>
+      std::future<bool> SendAsync(const T & msg)
+      {
+        if (_writeBehind) {
+          std::ostringstream  os;
+          if (StreamIO::Write(os, msg)) {
+            return _writeBehind->Push(std::move(os).str());
+          }
+          FSyslog(LOG_ERR, "Failed to serialize message for {}",
+                  EndPointString());
+        }
+        std::promise<bool>  promised;
+        promised.set_value(_writeBehind ? false : Send(msg));
+        return promised.get_future();
+      }
+
+      //----------------------------------------------------------------------
+      //!  Like SendAsync(const T &), but calls @c callback with the
+      //!  result instead of returning a future.  In write-behind mode,
+      //!  @c callback is called from the writer thread (or from this
+      //!  thread if @c msg is rejected), so it should be short.  Returns
+      //!  false if @c msg was rejected or failed immediately.
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamWritable<T>
+      bool SendAsync(const T & msg, WriteBehindQueue::Callback callback)
+      {
+        if (_writeBehind) {
+          std::ostringstream  os;
+          if (StreamIO::Write(os, msg)) {
+            return _writeBehind->Push(std::move(os).str(),
+                                      std::move(callback));
+          }
+          FSyslog(LOG_ERR, "Failed to serialize message for {}",
+                  EndPointString());
+        }
+        bool  rc = (_writeBehind ? false : Send(msg));
+        if (callback) {
+          callback(rc);
+        }
+        return rc;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns the write-behind queue counters (depth, wait times and
+      //!  so on).  All zero if write-behind mode is not enabled.
+      //----------------------------------------------------------------------
+      WriteBehindQueue::Counters WriteBehindStats() const;
+
+      //----------------------------------------------------------------------
+      //!  Moves traffic with a peer on the same host off the UNIX domain
+      //!  socket and onto a pair of rings in shared memory (see
+      //!  ShmChannel), so sending and receiving need no system calls
+      //!  unless a side has to sleep.  Both sides must call this after
+      //!  Authenticate(), with nothing in flight in either direction and
+      //!  no receive pump or write-behind queue running.  The side that
+      //!  called Connect() creates the rings, @c ringSize bytes each.
+      //!  Messages are still encrypted, and Send(), Receive() and the
+      //!  rest work as before; Split() does not.
+      //!
+      //!  Returns true if both sides switched.  If either side can't
+      //!  (over TCP, or on a platform without memfd), both stay on the
+      //!  socket and this returns false.  If the exchange fails part way,
+      //!  the connection is closed.
+      //----------------------------------------------------------------------
+      bool EnableSharedMemory(size_t ringSize =
+                              ShmChannel::k_defaultRingSize);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if traffic is going through shared memory.
+      //----------------------------------------------------------------------
+      bool SharedMemory() const
+      { return (_shm != nullptr); }
+
+      //----------------------------------------------------------------------
+      //!  Fetches the credentials of the process at the other end of our
+      //!  UNIX domain socket into @c creds (our own over a MemoryPipe).
+      //!  Returns false if we're not connected over a UNIX domain socket
+      //!  or MemoryPipe, or the platform can't tell us.  Note the kernel
+      //!  records the credentials when the connection is made, and a pid
+      //!  may since have been reused.
+      //----------------------------------------------------------------------
+      bool PeerCredentials(Credentials & creds) const;
+      
+      //----------------------------------------------------------------------
+      //!  Stops encrypting traffic with a peer on the same host.  On a
+      //!  UNIX domain socket the kernel already keeps the traffic private
+      //!  and intact, and can tell us who the peer is, so encryption only
+      //!  costs CPU.  Both sides must call this after Authenticate(),
+      //!  with nothing in flight in either direction and no receive pump
+      //!  running.  Each side agrees only if the connection is a UNIX
+      //!  domain socket (or a MemoryPipe), the peer's key has been
+      //!  authenticated, no write-behind queue is enabled and @c check
+      //!  approves the peer's credentials (see PeerCredentials()).  If
+      //!  @c check is empty, the peer must be running as our effective
+      //!  user.  The agreement is exchanged over the encrypted channel,
+      //!  so it can't be forged.
+      //!
+      //!  Returns true if both sides agreed; messages are then framed
+      //!  without encryption or MAC, and Send(), Receive() and the rest
+      //!  work as before.  Returns false (staying encrypted) otherwise.
+      //!  Over TCP this always returns false: the exchange still happens,
+      //!  so the other side isn't left waiting, but we always decline.
+      //!  May be combined with EnableSharedMemory(), in either order.
+      //----------------------------------------------------------------------
+      bool EnablePlaintext(const CredentialCheck & check = nullptr);
+
+      //----------------------------------------------------------------------
+      //!  Returns true if traffic is no longer encrypted.
+      //----------------------------------------------------------------------
+      bool Plaintext() const
+      { return _plaintext; }
+      
+      //----------------------------------------------------------------------
+      //!  Sends @c msg, which must already be serialized (for example by
+      //!  StreamIO::Write() to a std::ostringstream).  If @c flush is
+      //!  false, @c msg is only buffered, and goes out in the same
+      //!  encrypted frame as whatever else is written before the next
+      //!  flush.  In write-behind mode, @c msg is queued like any other
+      //!  message (and @c flush is moot) and this waits until it has been
+      //!  written.  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool SendSerialized(std::string_view msg, bool flush = true);
+      
       //----------------------------------------------------------------------
       //!  Receives the given @c msg from the peer.  Returns true on success,
       //!  false on failure.  Note that T must be supported directly by a
@@ -201,11 +510,132 @@ namespace Dwm {
         return rc;
       }
 
+      //----------------------------------------------------------------------
+      //!  Sends @c size bytes read from @c is, for ReceiveStream() on the
+      //!  other side.  The data goes out in encrypted chunks of up to
+      //!  k_streamChunkSize bytes, so memory use doesn't depend on
+      //!  @c size.  If @c is can't supply @c size bytes, the receiver is
+      //!  told the transfer failed, so the connection stays usable.
+      //!  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool SendStream(std::istream & is, uint64_t size);
+
+      //----------------------------------------------------------------------
+      //!  Like SendStream(std::istream &, uint64_t), reading @c size bytes
+      //!  from the file descriptor @c fd starting at @c offset with
+      //!  pread() (the file offset of @c fd is not changed).  Where
+      //!  supported, the kernel is told we're reading sequentially, and
+      //!  if @c dropCache is true, pages we've sent are dropped from the
+      //!  page cache so a huge file doesn't push everything else out.
+      //----------------------------------------------------------------------
+      bool SendStream(int fd, uint64_t size, off_t offset = 0,
+                      bool dropCache = false);
+
+      //----------------------------------------------------------------------
+      //!  Receives data sent with SendStream() and writes it to @c os,
+      //!  one chunk at a time.  If @c size is not nullptr, the size the
+      //!  sender announced is stored in it.  Returns true on success,
+      //!  false on failure.
+      //----------------------------------------------------------------------
+      bool ReceiveStream(std::ostream & os, uint64_t *size = nullptr);
+
+      //----------------------------------------------------------------------
+      //!  Like ReceiveStream(std::ostream &, uint64_t *), writing to the
+      //!  file descriptor @c fd.  If @c dropCache is true, written pages
+      //!  are flushed and dropped from the page cache where supported.
+      //!  On Linux the flushes run in the background; elsewhere each one
+      //!  blocks the receive with an fdatasync() every 8 MiB.
+      //----------------------------------------------------------------------
+      bool ReceiveStream(int fd, uint64_t *size = nullptr,
+                         bool dropCache = false);
+      
+      //----------------------------------------------------------------------
+      //!  Starts a thread that receives T messages and pushes them into
+      //!  @c queue, so the application can take them with
+      //!  SpscRing::TryPop() or SpscRing::PopBatch() without waiting on
+      //!  the network.  When @c queue is full, the thread waits for room.
+      //!  On end of file or a receive failure, the thread closes @c queue
+      //!  with SpscRing::State::e_eof or SpscRing::State::e_failed and
+      //!  exits; messages received before that can still be popped.
+      //!  While the pump runs, nothing else may receive from the Peer.
+      //!  @c queue must outlive the pump.  Returns true on success,
+      //!  false if not connected or a pump is already running.
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamReadable<T>
+      bool StartReceivePump(SpscRing<T> & queue)
+      {
+        bool  rc = false;
+        if (_receivePump.joinable()) {
+          Syslog(LOG_ERR, "Receive pump already running");
+        }
+        else if (_xis) {
+          using State = typename SpscRing<T>::State;
+          _stopReceivePump = [&queue] { queue.Close(State::e_stopped); };
+          _receivePump = std::thread([this, &queue] {
+            for (;;) {
+              T  msg;
+              if (! Receive(msg)) {
+                queue.Close(_xis->Eof() ? State::e_eof : State::e_failed);
+                break;
+              }
+              if (! queue.Push(std::move(msg))) {
+                break;
+              }
+            }
+          });
+          rc = true;
+        }
+        else {
+          Syslog(LOG_ERR, "Invalid encrypted input stream");
+        }
+        return rc;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Stops the receive pump started by StartReceivePump(), if any.
+      //!  This shuts down the receive side of the connection (the thread
+      //!  may be blocked in a receive), so nothing more can be received;
+      //!  sending still works.  The pump's queue is closed with
+      //!  SpscRing::State::e_stopped unless it was already closed.
+      //----------------------------------------------------------------------
+      void StopReceivePump();
+      
       //----------------------------------------------------------------------
       //!  Returns true if a Receive() of @c numBytes or greater would block.
+      //!  Counts data we've already read from the socket but not yet
+      //!  received, as well as data waiting in the socket.
       //----------------------------------------------------------------------
       bool ReceiveWouldBlock(size_t numBytes);
       
+      //----------------------------------------------------------------------
+      //!  Returns true if we have encrypted streams to the peer and the
+      //!  peer has not closed the connection.  Does not block.  Useful
+      //!  to check an idle connection before reusing it.
+      //----------------------------------------------------------------------
+      bool IsConnected();
+      
+      //----------------------------------------------------------------------
+      //!  Shuts down the connection in both directions, without releasing
+      //!  anything.  A Receive() blocked in another thread will return
+      //!  false.  Call Disconnect() once no other thread is using the
+      //!  Peer.
+      //----------------------------------------------------------------------
+      void Shutdown();
+      
+      //----------------------------------------------------------------------
+      //!  Splits the connection into a @c reader and a @c writer that
+      //!  each have their own buffers over the same socket, so one thread
+      //!  can receive while another sends without any locking.  The
+      //!  connection must be fully set up (after Authenticate(), if used),
+      //!  and nothing may be in flight in other threads.  Anything already
+      //!  received but not yet consumed goes to @c reader.  On success the
+      //!  Peer is left disconnected; the connection is closed when both
+      //!  @c reader and @c writer are destroyed.  Returns true on success,
+      //!  false on failure.
+      //----------------------------------------------------------------------
+      bool Split(PeerReader & reader, PeerWriter & writer);
+      
       //----------------------------------------------------------------------
       //!  Disconnects the peer.
       //----------------------------------------------------------------------
@@ -220,14 +650,42 @@ namespace Dwm {
     private:
       std::chrono::milliseconds                        _keyExchangeTimeout;
       std::chrono::milliseconds                        _idExchangeTimeout;
+      HandshakeExecutor                               *_handshakeExecutor;
+      KXKeyPairPool                                   *_keyPairPool;
+      AdmissionControl                                *_admissionControl;
+      AdmissionControl::Ticket                         _admissionTicket;
+      bool                                             _tcpFastOpen;
+      bool                                             _initiator;
+      bool                                             _plaintext;
+      size_t                                           _readBufferSize;
+      size_t                                           _writeBufferSize;
       boost::asio::ip::tcp::endpoint                   _endPoint;
       boost::asio::local::stream_protocol::endpoint    _lendPoint;
       std::string                                      _theirId;
-      std::string                                      _agreedKey;
+      KXKeyPair::SharedKeyType                         _agreedKey;
       std::unique_ptr<boost::asio::ip::tcp::iostream>  _ios;
       std::unique_ptr<boost::asio::local::stream_protocol::iostream>  _lios;
+      std::unique_ptr<MemoryPipe>                      _pipe;
+      std::unique_ptr<SocketInBuffer>                  _inBuf;
+      std::unique_ptr<std::istream>                    _is;
+      std::unique_ptr<SocketOutBuffer>                 _outBuf;
+      std::unique_ptr<std::ostream>                    _os;
+      std::unique_ptr<ShmChannel>                      _shm;
       std::unique_ptr<XChaCha20Poly1305::Istream>      _xis;
       std::unique_ptr<XChaCha20Poly1305::Ostream>      _xos;
+      std::unique_ptr<WriteBehindQueue>                _writeBehind;
+      std::thread                                      _receivePump;
+      std::function<void()>                            _stopReceivePump;
+
+      bool Admit(boost::asio::ip::tcp::socket & s);
+      bool OpenStreams(std::iostream & s, int fd);
+      bool OpenPipe(std::unique_ptr<MemoryPipe> && pipe);
+      bool SendChunks(uint64_t size,
+                      const std::function<ssize_t(char *,size_t)> & read);
+      bool ReceiveChunks(const std::function<bool(const std::string &)> &
+                         write, uint64_t *size);
+      bool ConnectFastOpen(const std::string & host, uint16_t port);
+      bool Admit(boost::asio::local::stream_protocol::socket & s);
     };
     
   }  // namespace Credence
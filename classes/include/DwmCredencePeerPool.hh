@@ -0,0 +1,309 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerPool.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerPool class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPEERPOOL_HH_
+#define _DWMCREDENCEPEERPOOL_HH_
+
+#include <chrono>
+#include <cstdint>
+#include <deque>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <vector>
+
+#include "DwmCredenceAuthenticator.hh"
+#include "DwmCredenceKeyStash.hh"
+#include "DwmCredenceKnownKeys.hh"
+#include "DwmCredencePeer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A client-side pool of connected and authenticated Peers, so that
+    //!  short transactions with the same server don't each pay for a
+    //!  connection, key exchange and authentication.
+    //!
+    //!  Peers are pooled by destination: TCP host and port, or UNIX
+    //!  domain socket path, plus the server ID we expect.  Get() hands
+    //!  out an idle Peer for the destination if there is one, else
+    //!  connects and authenticates a new one.  The returned Lease puts
+    //!  the Peer back in the pool when it's destroyed (or Return() is
+    //!  called), unless Discard() was called.  Call Discard() whenever a
+    //!  Send() or Receive() fails, since the Peer's streams can't be
+    //!  trusted after that.
+    //!
+    //!  Each destination keeps at most MaxIdle() idle Peers; extras are
+    //!  disconnected when returned.  Idle Peers older than IdleTimeout()
+    //!  are disconnected instead of reused, and an idle Peer is checked
+    //!  with Peer::IsConnected() (and for unread data) before it's handed
+    //!  out again, since the server may have closed it in the meantime.
+    //!
+    //!  All members are thread safe.  Connecting and authenticating are
+    //!  done without holding the pool's lock.  The pool must outlive all
+    //!  of its Leases.
+    //------------------------------------------------------------------------
+    class PeerPool
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+      
+      //----------------------------------------------------------------------
+      //!  Counts of Get() results and of Peers removed from the pool.
+      //----------------------------------------------------------------------
+      struct Counters
+      {
+        uint64_t                   hits;             //!< reused idle Peer
+        uint64_t                   misses;           //!< new Peer
+        uint64_t                   connectFailures;  //!< includes auth
+        uint64_t                   expired;          //!< idle too long
+        uint64_t                   stale;            //!< closed by server
+        uint64_t                   overflows;        //!< returned to full
+        std::chrono::milliseconds  totalReusedAge;   //!< sum over hits
+        std::chrono::milliseconds  maxReusedAge;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  A Peer on loan from a PeerPool.
+      //----------------------------------------------------------------------
+      class Lease
+      {
+      public:
+        Lease() : _pool(nullptr), _key(), _peer(), _created(), _reused(false)
+        { }
+        Lease(const Lease &) = delete;
+        Lease & operator = (const Lease &) = delete;
+        Lease(Lease && lease) noexcept;
+        Lease & operator = (Lease && lease) noexcept;
+        ~Lease()  { Return(); }
+
+        //--------------------------------------------------------------------
+        //!  Returns true if we hold a Peer.
+        //--------------------------------------------------------------------
+        explicit operator bool () const  { return (nullptr != _peer); }
+        
+        Peer & operator * () const     { return *_peer; }
+        Peer * operator -> () const    { return _peer.get(); }
+
+        //--------------------------------------------------------------------
+        //!  Returns true if the Peer came from the pool's idle Peers, false
+        //!  if it was newly connected.
+        //--------------------------------------------------------------------
+        bool Reused() const  { return _reused; }
+
+        //--------------------------------------------------------------------
+        //!  Returns the time since the Peer was connected.
+        //--------------------------------------------------------------------
+        Clock::duration Age() const
+        { return (_peer ? (Clock::now() - _created) : Clock::duration(0)); }
+        
+        //--------------------------------------------------------------------
+        //!  Returns the Peer to the pool.  Does nothing if we don't hold a
+        //!  Peer.
+        //--------------------------------------------------------------------
+        void Return();
+
+        //--------------------------------------------------------------------
+        //!  Disconnects the Peer instead of returning it to the pool.
+        //--------------------------------------------------------------------
+        void Discard();
+        
+      private:
+        friend class PeerPool;
+        
+        PeerPool               *_pool;
+        std::string             _key;
+        std::unique_ptr<Peer>   _peer;
+        Clock::time_point       _created;
+        bool                    _reused;
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Construct with the given @c keyStash and @c knownKeys, used to
+      //!  authenticate every Peer.  Each destination will keep at most
+      //!  @c maxIdle idle Peers, for at most @c idleTimeout.
+      //----------------------------------------------------------------------
+      PeerPool(const KeyStash & keyStash, const KnownKeys & knownKeys,
+               size_t maxIdle = 4,
+               std::chrono::milliseconds idleTimeout =
+               std::chrono::milliseconds(60000));
+
+      //----------------------------------------------------------------------
+      //!  Disconnects all idle Peers.
+      //----------------------------------------------------------------------
+      ~PeerPool();
+
+      PeerPool(const PeerPool &) = delete;
+      PeerPool & operator = (const PeerPool &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Sets the timeout for Peer::Connect() of new Peers.
+      //----------------------------------------------------------------------
+      void SetConnectTimeout(std::chrono::milliseconds ms);
+
+      //----------------------------------------------------------------------
+      //!  If @c tcpFastOpen is true, new TCP Peers use TCP Fast Open.
+      //!  See Peer::SetTcpFastOpen().
+      //----------------------------------------------------------------------
+      void SetTcpFastOpen(bool tcpFastOpen);
+
+      //----------------------------------------------------------------------
+      //!  Sets the handshake executor for new Peers.  See
+      //!  Peer::SetHandshakeExecutor().
+      //----------------------------------------------------------------------
+      void SetHandshakeExecutor(HandshakeExecutor *executor);
+
+      //----------------------------------------------------------------------
+      //!  Sets the ephemeral key pair pool for new Peers.  See
+      //!  Peer::SetKeyPairPool().
+      //----------------------------------------------------------------------
+      void SetKeyPairPool(KXKeyPairPool *keyPairPool);
+      
+      //----------------------------------------------------------------------
+      //!  Returns a Lease on an authenticated Peer connected to @c host at
+      //!  @c port.  If @c expectedId is not empty, the server must
+      //!  authenticate with that ID.  On failure, returns an empty Lease.
+      //----------------------------------------------------------------------
+      Lease Get(const std::string & host, uint16_t port,
+                const std::string & expectedId = "");
+
+      //----------------------------------------------------------------------
+      //!  Like Get(host, port, expectedId), for a UNIX domain socket at
+      //!  @c path.
+      //----------------------------------------------------------------------
+      Lease Get(const std::string & path,
+                const std::string & expectedId = "");
+
+      //----------------------------------------------------------------------
+      //!  Connects and authenticates up to @c count Peers to @c host at
+      //!  @c port in parallel and adds them to the idle Peers, without
+      //!  going over MaxIdle().  Returns the number of Peers added.
+      //----------------------------------------------------------------------
+      size_t Prewarm(const std::string & host, uint16_t port,
+                     const std::string & expectedId, size_t count);
+
+      //----------------------------------------------------------------------
+      //!  Like Prewarm(host, port, expectedId, count), for a UNIX domain
+      //!  socket at @c path.
+      //----------------------------------------------------------------------
+      size_t Prewarm(const std::string & path,
+                     const std::string & expectedId, size_t count);
+
+      //----------------------------------------------------------------------
+      //!  Disconnects idle Peers that have been idle longer than
+      //!  IdleTimeout().  Get() does this for its own destination; call
+      //!  this periodically to also clean up destinations no longer used.
+      //----------------------------------------------------------------------
+      void Prune();
+
+      //----------------------------------------------------------------------
+      //!  Disconnects all idle Peers.
+      //----------------------------------------------------------------------
+      void Clear();
+      
+      //----------------------------------------------------------------------
+      //!  Returns the number of idle Peers, over all destinations.
+      //----------------------------------------------------------------------
+      size_t NumIdle() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of idle Peers per destination.
+      //----------------------------------------------------------------------
+      size_t MaxIdle() const
+      { return _maxIdle; }
+
+      //----------------------------------------------------------------------
+      //!  Returns how long a Peer may be idle before it's disconnected.
+      //----------------------------------------------------------------------
+      std::chrono::milliseconds IdleTimeout() const
+      { return _idleTimeout; }
+      
+      //----------------------------------------------------------------------
+      //!  Returns a snapshot of the counters.
+      //----------------------------------------------------------------------
+      Counters Stats() const;
+      
+    private:
+      struct IdlePeer
+      {
+        std::unique_ptr<Peer>  peer;
+        Clock::time_point      created;
+        Clock::time_point      lastUsed;
+      };
+
+      //  Destinations are keyed by a string; see Key().
+      using IdleMap = std::map<std::string,std::deque<IdlePeer>>;
+      
+      const size_t                                 _maxIdle;
+      const std::chrono::milliseconds              _idleTimeout;
+      Authenticator                                _authenticator;
+      mutable std::mutex                           _mtx;
+      IdleMap                                      _idle;
+      std::chrono::milliseconds                    _connectTimeout;
+      bool                                         _tcpFastOpen;
+      HandshakeExecutor                           *_handshakeExecutor;
+      KXKeyPairPool                               *_keyPairPool;
+      Counters                                     _counters;
+
+      static std::string Key(const std::string & host, uint16_t port,
+                             const std::string & expectedId);
+      static std::string Key(const std::string & path,
+                             const std::string & expectedId);
+      Lease GetIdle(const std::string & key);
+      std::unique_ptr<Peer> NewPeer(const std::string & hostOrPath,
+                                    uint16_t port,
+                                    const std::string & expectedId);
+      bool Authenticate(Peer & peer);
+      size_t Fill(const std::string & key, const std::string & hostOrPath,
+                  uint16_t port, const std::string & expectedId,
+                  size_t count);
+      bool Return(const std::string & key, std::unique_ptr<Peer> peer,
+                  Clock::time_point created);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPEERPOOL_HH_
@@ -0,0 +1,163 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerReader.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerReader class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPEERREADER_HH_
+#define _DWMCREDENCEPEERREADER_HH_
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "DwmStreamIO.hh"
+#include "DwmSysLogger.hh"
+#include "DwmCredenceSocketInBuffer.hh"
+#include "DwmCredenceXChaCha20Poly1305Istream.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    class Peer;
+    
+    //------------------------------------------------------------------------
+    //!  The receive half of a Peer, obtained from Peer::Split().  It has
+    //!  its own buffers, so it can be used from one thread while the
+    //!  matching PeerWriter is used from another, with no locking.  A
+    //!  PeerReader must only be used by one thread at a time.  The
+    //!  connection is closed when both the PeerReader and the PeerWriter
+    //!  are destroyed.
+    //------------------------------------------------------------------------
+    class PeerReader
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Constructs an unusable PeerReader, to be filled in by
+      //!  Peer::Split().
+      //----------------------------------------------------------------------
+      PeerReader();
+
+      PeerReader(PeerReader && reader);
+      PeerReader & operator = (PeerReader && reader);
+      PeerReader(const PeerReader &) = delete;
+      PeerReader & operator = (const PeerReader &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Returns true if we have a connection to read from.
+      //----------------------------------------------------------------------
+      bool Valid() const
+      { return (_xis != nullptr); }
+      
+      //----------------------------------------------------------------------
+      //!  Receives the given @c msg from the peer.  Returns true on success,
+      //!  false on failure.  Same requirements on T as Peer::Receive().
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamReadable<T>
+      bool Receive(T & msg)
+      {
+        bool  rc = false;
+        if (_xis) {
+          if (StreamIO::Read(*_xis, msg)) {
+            rc = true;
+          }
+          else {
+            if (_xis->Eof()) {
+              FSyslog(LOG_INFO, "EOF on read from {} at {}",
+                      _theirId, _endPoint);
+            }
+            else {
+              FSyslog(LOG_ERR, "Failed to read message from {}", _endPoint);
+            }
+          }
+        }
+        else {
+          Syslog(LOG_ERR, "Invalid encrypted input stream");
+        }
+        return rc;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if we've reached end of file on the connection.
+      //----------------------------------------------------------------------
+      bool Eof() const
+      { return (_xis ? _xis->Eof() : true); }
+      
+      //----------------------------------------------------------------------
+      //!  Shuts down the receive side of the connection.  On most
+      //!  platforms this makes a Receive() blocked in another thread
+      //!  return false.
+      //----------------------------------------------------------------------
+      void Shutdown();
+      
+      //----------------------------------------------------------------------
+      //!  Returns the peer's identifier, if the Peer was authenticated
+      //!  before Split().
+      //----------------------------------------------------------------------
+      const std::string & Id() const
+      { return _theirId; }
+
+      //----------------------------------------------------------------------
+      //!  Returns a string representation of the peer endpoint.
+      //----------------------------------------------------------------------
+      const std::string & EndPointString() const
+      { return _endPoint; }
+      
+    private:
+      //  Keeps the socket open; shared with our PeerWriter.  Declared
+      //  first so it's destroyed last.
+      std::shared_ptr<std::iostream>                _socket;
+      int                                           _fd;
+      std::string                                   _theirId;
+      std::string                                   _endPoint;
+      std::unique_ptr<SocketInBuffer>               _buf;
+      std::unique_ptr<std::istream>                 _is;
+      std::unique_ptr<XChaCha20Poly1305::Istream>   _xis;
+
+      void Clear();
+      
+      friend class Peer;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPEERREADER_HH_
@@ -0,0 +1,222 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerRpcClient.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerRpcClient class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPEERRPCCLIENT_HH_
+#define _DWMCREDENCEPEERRPCCLIENT_HH_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <future>
+#include <map>
+#include <mutex>
+#include <set>
+#include <string>
+#include <thread>
+#include <utility>
+
+#include "DwmCredencePeer.hh"
+#include "DwmCredencePeerReader.hh"
+#include "DwmCredencePeerWriter.hh"
+#include "DwmCredencePeerRpcMessages.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  The client side of request/response RPC over an authenticated
+    //!  Peer, for use with PeerRpcServer on the other side.
+    //!
+    //!  Calls are pipelined: up to MaxInFlight() requests may be sent
+    //!  before their responses arrive, and responses may arrive in any
+    //!  order.  Each request carries an ID that its response echoes.
+    //!  CallAsync() returns a future for the response; Call() waits for
+    //!  it.  Both may be used from many threads at once.  When
+    //!  MaxInFlight() calls are outstanding, further calls wait for a
+    //!  free slot (up to their deadline).
+    //!
+    //!  Each call has a deadline.  If the response hasn't arrived by the
+    //!  deadline, the call completes with Status::e_timeout and a late
+    //!  response is dropped.  If the connection fails, outstanding calls
+    //!  complete with Status::e_disconnected.
+    //!
+    //!  Request and response messages may be any type usable with
+    //!  Peer::Send() and Peer::Receive().  Start() splits the Peer (see
+    //!  Peer::Split()), so the reader thread and callers sending requests
+    //!  each have their own half of the connection; the Peer is left
+    //!  disconnected, and the client owns the connection.
+    //------------------------------------------------------------------------
+    class PeerRpcClient
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+      using Status = PeerRpcResponse::Status;
+      
+      //----------------------------------------------------------------------
+      //!  Construct for the given authenticated @c peer, which must
+      //!  outlive the call to Start(), allowing @c maxInFlight outstanding
+      //!  calls.
+      //----------------------------------------------------------------------
+      PeerRpcClient(Peer & peer, size_t maxInFlight = 16);
+
+      //----------------------------------------------------------------------
+      //!  Stops the client.
+      //----------------------------------------------------------------------
+      ~PeerRpcClient();
+
+      PeerRpcClient(const PeerRpcClient &) = delete;
+      PeerRpcClient & operator = (const PeerRpcClient &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Starts the threads that receive responses and expire calls.
+      //!  Returns true on success (or if already started), false on
+      //!  failure.
+      //----------------------------------------------------------------------
+      bool Start();
+
+      //----------------------------------------------------------------------
+      //!  Shuts down the Peer's connection and stops the threads.
+      //!  Outstanding calls complete with Status::e_disconnected.
+      //----------------------------------------------------------------------
+      void Stop();
+
+      //----------------------------------------------------------------------
+      //!  Sends @c request to @c method and returns a future for the
+      //!  response.  The call completes with Status::e_timeout if no
+      //!  response arrives within @c timeout (which includes any wait for
+      //!  an in-flight slot).
+      //----------------------------------------------------------------------
+      template <typename Req>
+      requires IsStreamWritable<Req>
+      std::future<PeerRpcResponse>
+      CallAsync(uint32_t method, const Req & request,
+                std::chrono::milliseconds timeout =
+                std::chrono::milliseconds(5000))
+      {
+        std::string  body;
+        if (! PeerRpcEncode(request, body)) {
+          return Completed(PeerRpcResponse(0, Status::e_failed));
+        }
+        return CallRaw(method, std::move(body), timeout);
+      }
+
+      //----------------------------------------------------------------------
+      //!  Sends @c request to @c method, waits for the response and
+      //!  deserializes it into @c response.  Returns true on success,
+      //!  false on failure.  If @c status is not nullptr, the call's
+      //!  status is stored in it.
+      //----------------------------------------------------------------------
+      template <typename Req, typename Resp>
+      requires IsStreamWritable<Req> && IsStreamReadable<Resp>
+      bool Call(uint32_t method, const Req & request, Resp & response,
+                std::chrono::milliseconds timeout =
+                std::chrono::milliseconds(5000),
+                Status *status = nullptr)
+      {
+        PeerRpcResponse  rpcResponse =
+          CallAsync(method, request, timeout).get();
+        if (nullptr != status) {
+          *status = rpcResponse.GetStatus();
+        }
+        return rpcResponse.Decode(response);
+      }
+
+      //----------------------------------------------------------------------
+      //!  Like CallAsync(), but with an already serialized request
+      //!  @c body.
+      //----------------------------------------------------------------------
+      std::future<PeerRpcResponse>
+      CallRaw(uint32_t method, std::string && body,
+              std::chrono::milliseconds timeout);
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of outstanding calls.
+      //----------------------------------------------------------------------
+      size_t InFlight() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of outstanding calls.
+      //----------------------------------------------------------------------
+      size_t MaxInFlight() const
+      { return _maxInFlight; }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the connection failed or the client was
+      //!  stopped.
+      //----------------------------------------------------------------------
+      bool Closed() const;
+      
+    private:
+      struct Pending
+      {
+        std::promise<PeerRpcResponse>  promise;
+        Clock::time_point              deadline;
+      };
+      
+      Peer                                         &_peer;
+      const size_t                                  _maxInFlight;
+      mutable std::mutex                            _mtx;
+      std::condition_variable                       _cv;
+      std::mutex                                    _sendMtx;
+      std::map<uint64_t,Pending>                    _pending;
+      std::set<std::pair<Clock::time_point,uint64_t>>  _deadlines;
+      uint64_t                                      _nextId;
+      bool                                          _run;
+      bool                                          _closed;
+      PeerReader                                    _peerReader;
+      PeerWriter                                    _peerWriter;
+      std::thread                                   _readerThread;
+      std::thread                                   _reaper;
+
+      static std::future<PeerRpcResponse>
+      Completed(PeerRpcResponse && response);
+      void Complete(uint64_t id, PeerRpcResponse && response);
+      void ReaderLoop();
+      void ReaperLoop();
+      void Close();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPEERRPCCLIENT_HH_
@@ -0,0 +1,216 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerRpcMessages.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerRpcRequest and Dwm::Credence::PeerRpcResponse
+//!    class declarations
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPEERRPCMESSAGES_HH_
+#define _DWMCREDENCEPEERRPCMESSAGES_HH_
+
+#include <cstdint>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "DwmStreamIO.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A request sent by PeerRpcClient to PeerRpcServer.  The body is the
+    //!  serialized form of the application's request message.
+    //------------------------------------------------------------------------
+    class PeerRpcRequest
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Default constructor.
+      //----------------------------------------------------------------------
+      PeerRpcRequest();
+
+      //----------------------------------------------------------------------
+      //!  Construct from the given request @c id, @c method and @c body.
+      //----------------------------------------------------------------------
+      PeerRpcRequest(uint64_t id, uint32_t method, std::string && body);
+
+      //----------------------------------------------------------------------
+      //!  Returns the request ID, which the response will carry.
+      //----------------------------------------------------------------------
+      uint64_t Id() const  { return _id; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the method number.
+      //----------------------------------------------------------------------
+      uint32_t Method() const  { return _method; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the serialized body.
+      //----------------------------------------------------------------------
+      const std::string & Body() const  { return _body; }
+
+      //----------------------------------------------------------------------
+      //!  Deserializes the body into @c msg.  Returns true on success,
+      //!  false on failure.
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamReadable<T>
+      bool Decode(T & msg) const
+      {
+        std::istringstream  is(_body);
+        return (StreamIO::Read(is, msg) ? true : false);
+      }
+      
+      //----------------------------------------------------------------------
+      //!  Reads the request from the given istream @c is.  Returns @c is.
+      //----------------------------------------------------------------------
+      std::istream & Read(std::istream & is);
+
+      //----------------------------------------------------------------------
+      //!  Writes the request to the given ostream @c os.  Returns @c os.
+      //----------------------------------------------------------------------
+      std::ostream & Write(std::ostream & os) const;
+      
+    private:
+      uint64_t     _id;
+      uint32_t     _method;
+      std::string  _body;
+    };
+
+    //------------------------------------------------------------------------
+    //!  A response sent by PeerRpcServer to PeerRpcClient, or made up by
+    //!  PeerRpcClient when a call could not be completed (see Status).
+    //------------------------------------------------------------------------
+    class PeerRpcResponse
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Call results.
+      //----------------------------------------------------------------------
+      enum class Status : uint8_t {
+        e_ok            = 0,   //!< handler succeeded
+        e_failed        = 1,   //!< handler failed
+        e_unknownMethod = 2,   //!< no handler for the method
+        e_busy          = 3,   //!< server's queue was full
+        e_timeout       = 4,   //!< deadline passed (client side)
+        e_disconnected  = 5    //!< connection lost (client side)
+      };
+
+      //----------------------------------------------------------------------
+      //!  Default constructor.  The status is e_disconnected.
+      //----------------------------------------------------------------------
+      PeerRpcResponse();
+
+      //----------------------------------------------------------------------
+      //!  Construct from the given request @c id, @c status and @c body.
+      //----------------------------------------------------------------------
+      PeerRpcResponse(uint64_t id, Status status, std::string && body = "");
+
+      //----------------------------------------------------------------------
+      //!  Returns the ID of the request this responds to.
+      //----------------------------------------------------------------------
+      uint64_t Id() const  { return _id; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the status.
+      //----------------------------------------------------------------------
+      Status GetStatus() const  { return _status; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the serialized body.
+      //----------------------------------------------------------------------
+      const std::string & Body() const  { return _body; }
+
+      //----------------------------------------------------------------------
+      //!  Deserializes the body into @c msg.  Returns true on success,
+      //!  false if the status is not e_ok or on failure.
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamReadable<T>
+      bool Decode(T & msg) const
+      {
+        bool  rc = false;
+        if (Status::e_ok == _status) {
+          std::istringstream  is(_body);
+          rc = (StreamIO::Read(is, msg) ? true : false);
+        }
+        return rc;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns a string for the given @c status.
+      //----------------------------------------------------------------------
+      static const char *StatusString(Status status);
+      
+      //----------------------------------------------------------------------
+      //!  Reads the response from the given istream @c is.  Returns @c is.
+      //----------------------------------------------------------------------
+      std::istream & Read(std::istream & is);
+
+      //----------------------------------------------------------------------
+      //!  Writes the response to the given ostream @c os.  Returns @c os.
+      //----------------------------------------------------------------------
+      std::ostream & Write(std::ostream & os) const;
+      
+    private:
+      uint64_t     _id;
+      Status       _status;
+      std::string  _body;
+    };
+
+    //------------------------------------------------------------------------
+    //!  Serializes @c msg into @c body.  Returns true on success, false on
+    //!  failure.
+    //------------------------------------------------------------------------
+    template <typename T>
+    requires IsStreamWritable<T>
+    bool PeerRpcEncode(const T & msg, std::string & body)
+    {
+      std::ostringstream  os;
+      bool  rc = (StreamIO::Write(os, msg) ? true : false);
+      body = rc ? std::move(os).str() : std::string();
+      return rc;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPEERRPCMESSAGES_HH_
@@ -0,0 +1,188 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerRpcServer.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerRpcServer class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPEERRPCSERVER_HH_
+#define _DWMCREDENCEPEERRPCSERVER_HH_
+
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include "DwmCredencePeer.hh"
+#include "DwmCredencePeerReader.hh"
+#include "DwmCredencePeerWriter.hh"
+#include "DwmCredencePeerRpcMessages.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  The server side of request/response RPC over an authenticated
+    //!  Peer, for use with PeerRpcClient on the other side.
+    //!
+    //!  Requests are read by one thread and run by a pool of worker
+    //!  threads, so a slow call doesn't hold up the ones behind it and
+    //!  responses go back in the order they finish.  The request queue
+    //!  is bounded; when it's full, a request is answered right away
+    //!  with Status::e_busy (backpressure, as in HandshakeExecutor).
+    //!
+    //!  Register all handlers before Start().  Start() splits the Peer
+    //!  (see Peer::Split()), so the reader thread and the workers'
+    //!  responses each have their own half of the connection; the Peer
+    //!  is left disconnected, and the server owns the connection.
+    //------------------------------------------------------------------------
+    class PeerRpcServer
+    {
+    public:
+      using Status = PeerRpcResponse::Status;
+      
+      //----------------------------------------------------------------------
+      //!  A handler for serialized requests.  It should deserialize
+      //!  @c request, serialize its response into @c response and return
+      //!  true, or return false on failure.
+      //----------------------------------------------------------------------
+      using Handler = std::function<bool(const PeerRpcRequest & request,
+                                         std::string & response)>;
+      
+      //----------------------------------------------------------------------
+      //!  Construct for the given authenticated @c peer, which must
+      //!  outlive the call to Start(), with @c numWorkers worker threads
+      //!  and room for @c maxQueued requests waiting for a worker.
+      //----------------------------------------------------------------------
+      PeerRpcServer(Peer & peer, size_t numWorkers = 4,
+                    size_t maxQueued = 256);
+
+      //----------------------------------------------------------------------
+      //!  Stops the server.
+      //----------------------------------------------------------------------
+      ~PeerRpcServer();
+
+      PeerRpcServer(const PeerRpcServer &) = delete;
+      PeerRpcServer & operator = (const PeerRpcServer &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Registers @c handler for @c method.
+      //----------------------------------------------------------------------
+      void Register(uint32_t method, Handler handler);
+
+      //----------------------------------------------------------------------
+      //!  Registers @c handler for @c method, with deserialization of the
+      //!  request and serialization of the response done for it.  Used
+      //!  as Register<Req,Resp>(method, handler).
+      //----------------------------------------------------------------------
+      template <typename Req, typename Resp>
+      requires IsStreamReadable<Req> && IsStreamWritable<Resp>
+      void Register(uint32_t method,
+                    std::function<bool(const Req &, Resp &)> handler)
+      {
+        Register(method,
+                 [handler] (const PeerRpcRequest & request,
+                            std::string & response) {
+                   bool  rc = false;
+                   Req   req;
+                   if (request.Decode(req)) {
+                     Resp  resp;
+                     if (handler(req, resp)) {
+                       rc = PeerRpcEncode(resp, response);
+                     }
+                   }
+                   return rc;
+                 });
+      }
+
+      //----------------------------------------------------------------------
+      //!  Starts the reader and worker threads.  Returns true on success
+      //!  (or if already started), false on failure.
+      //----------------------------------------------------------------------
+      bool Start();
+
+      //----------------------------------------------------------------------
+      //!  Shuts down the Peer's connection and stops the threads.
+      //!  Queued requests are dropped.
+      //----------------------------------------------------------------------
+      void Stop();
+
+      //----------------------------------------------------------------------
+      //!  Waits until the client closes the connection (or the server is
+      //!  stopped).
+      //----------------------------------------------------------------------
+      void Wait();
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the connection was closed or the server was
+      //!  stopped.
+      //----------------------------------------------------------------------
+      bool Closed() const;
+      
+    private:
+      Peer                          &_peer;
+      const size_t                   _numWorkers;
+      const size_t                   _maxQueued;
+      std::map<uint32_t,Handler>     _handlers;
+      mutable std::mutex             _mtx;
+      std::condition_variable        _cv;
+      std::mutex                     _sendMtx;
+      std::deque<PeerRpcRequest>     _requests;
+      bool                           _run;
+      bool                           _closed;
+      PeerReader                     _peerReader;
+      PeerWriter                     _peerWriter;
+      std::thread                    _readerThread;
+      std::vector<std::thread>       _workers;
+
+      bool Respond(PeerRpcResponse && response);
+      void ReaderLoop();
+      void WorkerLoop();
+      void Close();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPEERRPCSERVER_HH_
@@ -0,0 +1,155 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerWriter.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerWriter class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPEERWRITER_HH_
+#define _DWMCREDENCEPEERWRITER_HH_
+
+#include <iostream>
+#include <memory>
+#include <string>
+
+#include "DwmStreamIO.hh"
+#include "DwmSysLogger.hh"
+#include "DwmCredenceSocketOutBuffer.hh"
+#include "DwmCredenceXChaCha20Poly1305Ostream.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    class Peer;
+    
+    //------------------------------------------------------------------------
+    //!  The send half of a Peer, obtained from Peer::Split().  It has its
+    //!  own buffers, so it can be used from one thread while the matching
+    //!  PeerReader is used from another, with no locking.  A PeerWriter
+    //!  must only be used by one thread at a time.  The connection is
+    //!  closed when both the PeerWriter and the PeerReader are destroyed.
+    //------------------------------------------------------------------------
+    class PeerWriter
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Constructs an unusable PeerWriter, to be filled in by
+      //!  Peer::Split().
+      //----------------------------------------------------------------------
+      PeerWriter();
+
+      PeerWriter(PeerWriter && writer);
+      PeerWriter & operator = (PeerWriter && writer);
+      PeerWriter(const PeerWriter &) = delete;
+      PeerWriter & operator = (const PeerWriter &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Returns true if we have a connection to write to.
+      //----------------------------------------------------------------------
+      bool Valid() const
+      { return (_xos != nullptr); }
+      
+      //----------------------------------------------------------------------
+      //!  Sends the given @c msg to the peer.  Returns true on success,
+      //!  false on failure.  Same requirements on T as Peer::Send().
+      //----------------------------------------------------------------------
+      template <typename T>
+      requires IsStreamWritable<T>
+      bool Send(const T & msg)
+      {
+        bool  rc = false;
+        if (_xos) {
+          if (StreamIO::Write(*_xos, msg)) {
+            if (_xos->flush()) {
+              rc = true;
+            }
+            else {
+              FSyslog(LOG_ERR, "Failed to flush encrypted stream to {}",
+                      _endPoint);
+            }
+          }
+          else {
+            FSyslog(LOG_ERR, "Failed to send message to {}", _endPoint);
+          }
+        }
+        else {
+          Syslog(LOG_ERR, "Invalid encrypted output stream");
+        }
+        return rc;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Shuts down the send side of the connection.  The peer will see
+      //!  end of file after receiving everything we've sent.
+      //----------------------------------------------------------------------
+      void Shutdown();
+      
+      //----------------------------------------------------------------------
+      //!  Returns the peer's identifier, if the Peer was authenticated
+      //!  before Split().
+      //----------------------------------------------------------------------
+      const std::string & Id() const
+      { return _theirId; }
+
+      //----------------------------------------------------------------------
+      //!  Returns a string representation of the peer endpoint.
+      //----------------------------------------------------------------------
+      const std::string & EndPointString() const
+      { return _endPoint; }
+      
+    private:
+      //  Keeps the socket open; shared with our PeerReader.  Declared
+      //  first so it's destroyed last.
+      std::shared_ptr<std::iostream>                _socket;
+      int                                           _fd;
+      std::string                                   _theirId;
+      std::string                                   _endPoint;
+      std::unique_ptr<SocketOutBuffer>              _buf;
+      std::unique_ptr<std::ostream>                 _os;
+      std::unique_ptr<XChaCha20Poly1305::Ostream>   _xos;
+
+      void Clear();
+      
+      friend class Peer;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPEERWRITER_HH_
@@ -0,0 +1,155 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePrefixTrie.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PrefixTrie class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEPREFIXTRIE_HH_
+#define _DWMCREDENCEPREFIXTRIE_HH_
+
+#include <cstdint>
+#include <set>
+#include <vector>
+#include <boost/asio.hpp>
+
+#include "DwmIpPrefix.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A longest prefix match table for IPv4 and IPv6 prefixes, used to
+    //!  check client addresses against allowed clients.  It is a multibit
+    //!  trie with a stride of 4 bits; each node is 16 32-bit entries (one
+    //!  64-byte cache line) holding a child node index and the length of
+    //!  the longest prefix ending at that entry.  Prefixes that don't end
+    //!  on a 4-bit boundary are expanded into the entries they cover.
+    //!  A lookup touches at most 8 nodes for IPv4 and 32 for IPv6, and
+    //!  never allocates.
+    //!
+    //!  A PrefixTrie is built once and then only read, so it may be shared
+    //!  between threads without locking.  To change the prefixes, build a
+    //!  new PrefixTrie and swap it in (see AdmissionControl).
+    //------------------------------------------------------------------------
+    class PrefixTrie
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Constructs an empty trie.
+      //----------------------------------------------------------------------
+      PrefixTrie();
+
+      //----------------------------------------------------------------------
+      //!  Constructs a trie containing @c prefixes.  Invalid prefixes are
+      //!  logged and skipped.
+      //----------------------------------------------------------------------
+      PrefixTrie(const std::set<IpPrefix> & prefixes);
+      
+      //----------------------------------------------------------------------
+      //!  Adds the prefix @c addr / @c maskLen.  IPv4-mapped IPv6
+      //!  addresses are added as IPv4.  Returns true on success, false if
+      //!  @c maskLen is too long for the address family or the trie is
+      //!  full.
+      //----------------------------------------------------------------------
+      bool Add(const boost::asio::ip::address & addr, uint8_t maskLen);
+
+      //----------------------------------------------------------------------
+      //!  Adds the given @c prefix.  Returns true on success, false on
+      //!  failure.
+      //----------------------------------------------------------------------
+      bool Add(const IpPrefix & prefix);
+      
+      //----------------------------------------------------------------------
+      //!  Returns the length of the longest prefix containing @c addr, or
+      //!  -1 if no prefix contains @c addr.  IPv4-mapped IPv6 addresses
+      //!  are looked up as IPv4.
+      //----------------------------------------------------------------------
+      int LongestMatch(const boost::asio::ip::address & addr) const;
+
+      //----------------------------------------------------------------------
+      //!  Returns true if any prefix contains @c addr.
+      //----------------------------------------------------------------------
+      bool Contains(const boost::asio::ip::address & addr) const
+      { return (LongestMatch(addr) >= 0); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of prefixes added.
+      //----------------------------------------------------------------------
+      size_t Size() const
+      { return _size; }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if no prefixes have been added.
+      //----------------------------------------------------------------------
+      bool Empty() const
+      { return (0 == _size); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes used by the trie's nodes.
+      //----------------------------------------------------------------------
+      size_t MemoryUsage() const
+      { return (_nodes.size() * sizeof(Node)); }
+      
+    private:
+      static constexpr uint32_t  k_childMask = 0x00ffffff;
+      static constexpr uint32_t  k_lenShift = 24;
+      static constexpr uint32_t  k_v4Root = 0;
+      static constexpr uint32_t  k_v6Root = 1;
+
+      //  Each entry is a child node index in the low 24 bits (0 for none,
+      //  since a root is never a child) and the longest prefix length
+      //  plus 1 in the high 8 bits (0 for none).
+      struct alignas(64) Node
+      {
+        uint32_t  entries[16];
+      };
+      
+      std::vector<Node>  _nodes;
+      size_t             _size;
+
+      bool Add(uint32_t root, const uint8_t *addr, uint8_t maskLen);
+      int LongestMatch(uint32_t root, const uint8_t *addr,
+                       size_t addrLen) const;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEPREFIXTRIE_HH_
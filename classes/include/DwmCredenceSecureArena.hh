@@ -0,0 +1,155 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSecureArena.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SecureArena class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESECUREARENA_HH_
+#define _DWMCREDENCESECUREARENA_HH_
+
+#include <cstddef>
+#include <cstdint>
+#include <mutex>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A process-wide pool of fixed-size slots for key material.  Slots
+    //!  are carved from slabs that are mapped once, bracketed by
+    //!  inaccessible guard pages, locked into memory (when the memory
+    //!  lock limit permits) and excluded from core dumps where the
+    //!  platform supports it.  Allocating and freeing a slot is a free
+    //!  list operation under a mutex; no system calls are made except
+    //!  when a new slab is needed.
+    //!
+    //!  Slots are zeroed when allocated and again when freed.  If a new
+    //!  slab can't be mapped, Allocate() falls back to sodium_malloc().
+    //!
+    //!  Normally used via SecureString rather than directly.
+    //------------------------------------------------------------------------
+    class SecureArena
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  The size of each slot, in bytes.  Large enough for any key this
+      //!  library handles (an Ed25519 secret key is the largest).
+      //----------------------------------------------------------------------
+      static constexpr size_t  k_slotSize = 64;
+
+      //----------------------------------------------------------------------
+      //!  The number of pages of slots in each slab.
+      //----------------------------------------------------------------------
+      static constexpr size_t  k_slabPages = 4;
+      
+      //----------------------------------------------------------------------
+      //!  Returns the process-wide arena.  It is never destroyed, so
+      //!  objects with static storage duration may safely hold slots.
+      //----------------------------------------------------------------------
+      static SecureArena & Instance();
+
+      SecureArena(const SecureArena &) = delete;
+      SecureArena & operator = (const SecureArena &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Returns a zeroed slot of k_slotSize bytes, or nullptr if no
+      //!  memory is available.
+      //----------------------------------------------------------------------
+      void *Allocate();
+
+      //----------------------------------------------------------------------
+      //!  Zeroes the slot at @c p and returns it to the arena.  @c p must
+      //!  have been returned by Allocate(); a nullptr is ignored.
+      //----------------------------------------------------------------------
+      void Free(void *p);
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of slots currently allocated.
+      //----------------------------------------------------------------------
+      size_t SlotsInUse() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of free slots in existing slabs.
+      //----------------------------------------------------------------------
+      size_t SlotsFree() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of slabs mapped.
+      //----------------------------------------------------------------------
+      size_t NumSlabs() const;
+
+      //----------------------------------------------------------------------
+      //!  Returns true if every slab is locked into memory.
+      //----------------------------------------------------------------------
+      bool Locked() const;
+      
+    private:
+      struct Slab
+      {
+        uint8_t  *map;
+        size_t    mapLen;
+        uint8_t  *data;
+        size_t    dataLen;
+        bool      locked;
+      };
+
+      struct FreeSlot
+      {
+        FreeSlot  *next;
+      };
+      
+      mutable std::mutex  _mtx;
+      std::vector<Slab>   _slabs;      //  sorted by data address
+      FreeSlot           *_freeList;
+      size_t              _inUse;
+      size_t              _free;
+      size_t              _fallbacks;
+
+      SecureArena();
+      static bool SlabBefore(const uint8_t *p, const Slab & slab);
+      bool AddSlab();
+      bool Owns(const void *p) const;
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESECUREARENA_HH_
@@ -0,0 +1,325 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSecureString.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SecureString class template
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESECURESTRING_HH_
+#define _DWMCREDENCESECURESTRING_HH_
+
+#include <cstdint>
+#include <cstring>
+#include <new>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+#include "DwmStreamIO.hh"
+#include "DwmSysLogger.hh"
+#include "DwmCredenceSecureArena.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A string of at most LEN bytes for secret key material.  The
+    //!  content lives in a SecureArena slot (locked, guarded and zeroed
+    //!  when released) instead of the heap or the owning object.  A slot
+    //!  is taken on the first non-empty assignment and returned when the
+    //!  SecureString is destroyed; moves hand the slot over without
+    //!  copying.
+    //!
+    //!  The interface and binary form mirror ShortString, so a
+    //!  SecureString can replace a ShortString without changing the
+    //!  wire format.
+    //------------------------------------------------------------------------
+    template <size_t LEN>
+    requires (LEN <= SecureArena::k_slotSize)
+    class SecureString
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Default constructor.  Does not allocate.
+      //----------------------------------------------------------------------
+      SecureString() : _len(0), _buf(nullptr)  { }
+
+      //----------------------------------------------------------------------
+      //!  Copy constructor.
+      //----------------------------------------------------------------------
+      SecureString(const SecureString & ss)
+          : _len(0), _buf(nullptr)
+      { Set(ss.Value()); }
+
+      //----------------------------------------------------------------------
+      //!  Move constructor.
+      //----------------------------------------------------------------------
+      SecureString(SecureString && ss) noexcept
+          : _len(ss._len), _buf(ss._buf)
+      {
+        ss._len = 0;
+        ss._buf = nullptr;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Construct from the given string_view @c s.  Throws an exception
+      //!  if s.size() is greater than LEN.
+      //----------------------------------------------------------------------
+      SecureString(std::string_view s)
+          : _len(0), _buf(nullptr)
+      {
+        if (s.size() <= LEN) {
+          Set(s);
+        }
+        else {
+          throw std::logic_error("Initializing string too long");
+        }
+      }
+
+      //----------------------------------------------------------------------
+      //!  Destructor.  Zeroes the content and returns the slot.
+      //----------------------------------------------------------------------
+      ~SecureString()
+      {
+        SecureArena::Instance().Free(_buf);
+      }
+
+      //----------------------------------------------------------------------
+      //!  Copy assignment.
+      //----------------------------------------------------------------------
+      SecureString & operator = (const SecureString & ss)
+      {
+        if (&ss != this) {
+          Set(ss.Value());
+        }
+        return *this;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Move assignment.
+      //----------------------------------------------------------------------
+      SecureString & operator = (SecureString && ss) noexcept
+      {
+        if (&ss != this) {
+          SecureArena::Instance().Free(_buf);
+          _len = ss._len;
+          _buf = ss._buf;
+          ss._len = 0;
+          ss._buf = nullptr;
+        }
+        return *this;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Assigns from the given string_view @c s, reusing our slot.
+      //!  Throws an exception if s.size() is greater than LEN.
+      //----------------------------------------------------------------------
+      SecureString & operator = (std::string_view s)
+      {
+        if (s.size() <= LEN) {
+          Set(s);
+        }
+        else {
+          throw std::logic_error("Assigned string too long");
+        }
+        return *this;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns the contained value.
+      //----------------------------------------------------------------------
+      std::string_view Value() const
+      { return std::string_view(_buf, _len); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the contained value.
+      //----------------------------------------------------------------------
+      operator std::string_view () const
+      { return Value(); }
+      
+      //----------------------------------------------------------------------
+      //!  Returns a pointer to the content.  May be nullptr if empty.
+      //----------------------------------------------------------------------
+      const char *Data() const  { return _buf; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the length of the content.
+      //----------------------------------------------------------------------
+      size_t Length() const  { return _len; }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the content is empty.
+      //----------------------------------------------------------------------
+      bool Empty() const  { return (0 == _len); }
+      
+      //----------------------------------------------------------------------
+      //!  Reads the string from the given istream @c is.  Returns @c is.
+      //!  If the length read from @c is is greater than LEN, or no slot
+      //!  can be allocated for the content, the failbit is set on @c is.
+      //----------------------------------------------------------------------
+      std::istream & Read(std::istream & is)
+      {
+        Clear();
+        if (is) {
+          uint8_t  len;
+          if (StreamIO::Read(is, len)) {
+            if (len <= LEN) {
+              if (len) {
+                try {
+                  Reserve();
+                }
+                catch (const std::bad_alloc &) {
+                  is.setstate(std::ios_base::failbit);
+                  Syslog(LOG_ERR, "No memory for SecureString");
+                  return is;
+                }
+                if (is.read(_buf, len)) {
+                  _len = len;
+                }
+                else {
+                  Clear();
+                }
+              }
+            }
+            else {
+              is.setstate(std::ios_base::failbit);
+              FSyslog(LOG_ERR, "SecureString length {} exceeds {}",
+                      len, LEN);
+            }
+          }
+        }
+        return is;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Writes the string to the given ostream @c os.  Returns @c os.
+      //----------------------------------------------------------------------
+      std::ostream & Write(std::ostream & os) const
+      {
+        if (os) {
+          if (StreamIO::Write(os, _len)) {
+            if (_len) {
+              os.write(_buf, _len);
+            }
+          }
+        }
+        return os;
+      }
+
+      //----------------------------------------------------------------------
+      //!  operator ==
+      //----------------------------------------------------------------------
+      bool operator == (const SecureString & s) const
+      {
+        return (s.Value() == Value());
+      }
+
+      //----------------------------------------------------------------------
+      //!  operator <
+      //----------------------------------------------------------------------
+      bool operator < (const SecureString & s) const
+      {
+        return (Value() < s.Value());
+      }
+      
+      //----------------------------------------------------------------------
+      //!  Clears the content.  The storage is zeroed but the slot is kept
+      //!  for reuse by this object.
+      //----------------------------------------------------------------------
+      void Clear()
+      {
+        volatile char  *p = _buf;
+        for (size_t i = 0; i < _len; ++i) {
+          p[i] = '\0';
+        }
+        _len = 0;
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of bytes that the SecureString can
+      //!  hold.  This is the same as the LEN template parameter.
+      //----------------------------------------------------------------------
+      static consteval size_t Size()  { return LEN; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of bytes written by Write().
+      //----------------------------------------------------------------------
+      static consteval size_t MaxStreamedLength()
+      { return sizeof(_len) + LEN; }
+      
+    private:
+      static_assert(LEN <= 0xff);
+      
+      uint8_t   _len;
+      char     *_buf;
+
+      //----------------------------------------------------------------------
+      //!  Takes a slot from the arena if we don't have one.
+      //----------------------------------------------------------------------
+      void Reserve()
+      {
+        if (nullptr == _buf) {
+          _buf = (char *)SecureArena::Instance().Allocate();
+          if (nullptr == _buf) {
+            throw std::bad_alloc();
+          }
+        }
+        return;
+      }
+      
+      //----------------------------------------------------------------------
+      //!  Caller must ensure s.size() <= LEN.
+      //----------------------------------------------------------------------
+      void Set(std::string_view s)
+      {
+        Clear();
+        if (! s.empty()) {
+          Reserve();
+          std::memcpy(_buf, s.data(), s.size());
+        }
+        _len = s.size();
+        return;
+      }
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESECURESTRING_HH_
@@ -0,0 +1,198 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmChannel.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmChannel class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESHMCHANNEL_HH_
+#define _DWMCREDENCESHMCHANNEL_HH_
+
+#include <chrono>
+#include <iostream>
+
+#include "DwmCredenceShmInBuffer.hh"
+#include "DwmCredenceShmOutBuffer.hh"
+#include "DwmCredenceShmRing.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A duplex channel between two processes on the same host, made of
+    //!  two ShmRings in a sealed memfd.  One process creates the memfd
+    //!  and passes it to the other over a connected UNIX domain socket
+    //!  (SCM_RIGHTS); after that, data moves through the rings with no
+    //!  system calls unless one side has to sleep.  The socket is kept
+    //!  open so each side can tell if the other goes away.
+    //!
+    //!  Used by Peer::EnableSharedMemory(), which sets this up over an
+    //!  authenticated connection and then runs its encrypted streams
+    //!  over In() and Out().  Linux only.
+    //------------------------------------------------------------------------
+    class ShmChannel
+    {
+    public:
+      static constexpr size_t  k_defaultRingSize = 1024 * 1024;
+      static constexpr size_t  k_minRingSize = 4096;
+      static constexpr size_t  k_maxRingSize = 256 * 1024 * 1024;
+
+      //----------------------------------------------------------------------
+      //!  Returns true if shared memory channels are supported on this
+      //!  platform.
+      //----------------------------------------------------------------------
+      static bool Supported();
+      
+      //----------------------------------------------------------------------
+      //!  Default constructor.
+      //----------------------------------------------------------------------
+      ShmChannel();
+
+      //----------------------------------------------------------------------
+      //!  Closes the channel and unmaps the shared memory.
+      //----------------------------------------------------------------------
+      ~ShmChannel();
+
+      ShmChannel(const ShmChannel &) = delete;
+      ShmChannel & operator = (const ShmChannel &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Creates the shared memory, with rings of @c ringSize bytes
+      //!  (rounded up to a power of 2 and clamped to k_minRingSize and
+      //!  k_maxRingSize).  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool Create(size_t ringSize);
+
+      //----------------------------------------------------------------------
+      //!  Returns the size of each ring.
+      //----------------------------------------------------------------------
+      size_t RingSize() const
+      { return _ringSize; }
+      
+      //----------------------------------------------------------------------
+      //!  Sends the descriptor of the memory made by Create() over the
+      //!  UNIX domain socket @c socketFd, along with a single byte.
+      //!  Returns true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool SendDescriptor(int socketFd);
+
+      //----------------------------------------------------------------------
+      //!  Waits up to @c timeout for the byte and descriptor sent by the
+      //!  other process's SendDescriptor() on @c socketFd, then maps and
+      //!  checks the memory, which must hold rings of @c ringSize bytes.
+      //!  Nothing may be read from @c socketFd in the meantime.  Returns
+      //!  true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool ReceiveDescriptor(int socketFd, size_t ringSize,
+                             std::chrono::milliseconds timeout);
+
+      //----------------------------------------------------------------------
+      //!  Starts using the channel.  @c creator must be true in the
+      //!  process that called Create() and false in the other.
+      //!  @c socketFd is the UNIX domain socket to the other process,
+      //!  which must stay open.
+      //----------------------------------------------------------------------
+      void Open(bool creator, int socketFd);
+
+      //----------------------------------------------------------------------
+      //!  Returns the stream for reading from the other process.
+      //----------------------------------------------------------------------
+      std::istream & In()
+      { return _is; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the stream for writing to the other process.
+      //----------------------------------------------------------------------
+      std::ostream & Out()
+      { return _os; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes that can be read from In() without
+      //!  blocking.
+      //----------------------------------------------------------------------
+      size_t BytesReady() const;
+
+      //----------------------------------------------------------------------
+      //!  Closes both directions, waking anyone waiting on them in either
+      //!  process.
+      //----------------------------------------------------------------------
+      void Close();
+
+      //----------------------------------------------------------------------
+      //!  Closes the direction we read from, waking a reader blocked in
+      //!  In().
+      //----------------------------------------------------------------------
+      void CloseReceive();
+      
+    private:
+      struct Header
+      {
+        uint64_t  magic;
+        uint32_t  version;
+        uint32_t  unused;
+        uint64_t  ringSize;
+      };
+
+      static constexpr uint64_t  k_magic = 0x44574d4353484d31;  // DWMCSHM1
+      static constexpr uint32_t  k_version = 1;
+      static constexpr size_t    k_controlOffset = 256;
+      static constexpr size_t    k_controlSize = 256;
+      static constexpr size_t    k_dataOffset = 4096;
+      static_assert(sizeof(ShmRing::Control) <= k_controlSize);
+      
+      int            _memFd;
+      void          *_mem;
+      size_t         _memSize;
+      size_t         _ringSize;
+      bool           _open;
+      ShmRing        _inRing;
+      ShmRing        _outRing;
+      ShmInBuffer    _inBuf;
+      ShmOutBuffer   _outBuf;
+      std::istream   _is;
+      std::ostream   _os;
+
+      bool Map();
+      void Unmap();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESHMCHANNEL_HH_
@@ -0,0 +1,105 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmInBuffer.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmInBuffer class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESHMINBUFFER_HH_
+#define _DWMCREDENCESHMINBUFFER_HH_
+
+#include <chrono>
+#include <streambuf>
+
+#include "DwmCredenceShmRing.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A std::streambuf that reads from the consumer side of a ShmRing.
+    //!  The get area points straight into the ring, so nothing is copied
+    //!  until the reader copies it out; what's been read is released to
+    //!  the producer when we move on to the next span.  Reads block until
+    //!  data is available or the ring is closed.
+    //------------------------------------------------------------------------
+    class ShmInBuffer
+      : public std::streambuf
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Construct for the given @c ring, which must be attached before
+      //!  we're used.
+      //----------------------------------------------------------------------
+      ShmInBuffer(ShmRing & ring);
+
+      ShmInBuffer(const ShmInBuffer &) = delete;
+      ShmInBuffer & operator = (const ShmInBuffer &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes that can be read without blocking.
+      //----------------------------------------------------------------------
+      size_t BytesReady() const;
+
+      //----------------------------------------------------------------------
+      //!  Waits up to @c timeout for BytesReady() to reach @c numBytes.
+      //!  Returns true if it did, false on timeout or if the ring is
+      //!  closed first.
+      //----------------------------------------------------------------------
+      bool WaitForBytesReady(size_t numBytes,
+                             std::chrono::milliseconds timeout);
+      
+    protected:
+      int_type underflow() override;
+      std::streamsize xsgetn(char_type *s, std::streamsize n) override;
+      std::streamsize showmanyc() override;
+      
+    private:
+      ShmRing  &_ring;
+
+      //----------------------------------------------------------------------
+      //!  Gives the bytes we've read back to the producer.
+      //----------------------------------------------------------------------
+      void Release();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESHMINBUFFER_HH_
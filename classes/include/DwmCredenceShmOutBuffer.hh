@@ -0,0 +1,91 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmOutBuffer.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmOutBuffer class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESHMOUTBUFFER_HH_
+#define _DWMCREDENCESHMOUTBUFFER_HH_
+
+#include <streambuf>
+
+#include "DwmCredenceShmRing.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A std::streambuf that writes to the producer side of a ShmRing.
+    //!  The put area is free space in the ring, so data is written in
+    //!  place.  It becomes visible to the reader when the put area fills
+    //!  or sync() is called (by flush() on the owning ostream).  Writes
+    //!  block while the ring is full.
+    //------------------------------------------------------------------------
+    class ShmOutBuffer
+      : public std::streambuf
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Construct for the given @c ring, which must be attached before
+      //!  we're used.
+      //----------------------------------------------------------------------
+      ShmOutBuffer(ShmRing & ring);
+
+      ShmOutBuffer(const ShmOutBuffer &) = delete;
+      ShmOutBuffer & operator = (const ShmOutBuffer &) = delete;
+      
+    protected:
+      int_type overflow(int_type c) override;
+      int sync() override;
+      
+    private:
+      ShmRing  &_ring;
+
+      //----------------------------------------------------------------------
+      //!  Hands what's been written to the reader.  Returns false if the
+      //!  ring has been closed.
+      //----------------------------------------------------------------------
+      bool Publish();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESHMOUTBUFFER_HH_
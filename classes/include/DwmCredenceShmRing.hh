@@ -0,0 +1,201 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmRing.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmRing class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESHMRING_HH_
+#define _DWMCREDENCESHMRING_HH_
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A single producer, single consumer byte ring in memory shared by
+    //!  two processes (see ShmChannel), or by two threads of one process
+    //!  (see MemoryPipe).  The control block (indices, wakeup words and
+    //!  a closed flag) lives in the shared memory too; a ShmRing object
+    //!  is just one process's view of it, used by either the producer or
+    //!  the consumer.
+    //!
+    //!  Both sides hand out contiguous spans of the ring so callers can
+    //!  write and read in place.  A side that has to wait spins briefly
+    //!  (so a busy exchange on a multicore host never sleeps) and then
+    //!  sleeps on a futex.
+    //!  While asleep it wakes every so often to check that the other
+    //!  process still holds its end of the UNIX domain socket the ring
+    //!  was set up over, so a crashed peer looks like a closed ring.
+    //!
+    //!  The other process can scribble on the shared memory, so indices
+    //!  are checked before use; a ring with bad indices is closed.
+    //------------------------------------------------------------------------
+    class ShmRing
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  The shared part.  Producer and consumer fields are on separate
+      //!  cache lines.
+      //----------------------------------------------------------------------
+      struct Control
+      {
+        alignas(64) std::atomic<uint64_t>  head;
+        std::atomic<uint32_t>              dataSeq;
+        std::atomic<uint32_t>              consumerWaiting;
+        alignas(64) std::atomic<uint64_t>  tail;
+        std::atomic<uint32_t>              spaceSeq;
+        std::atomic<uint32_t>              producerWaiting;
+        alignas(64) std::atomic<uint32_t>  closed;
+      };
+
+      static_assert(std::atomic<uint64_t>::is_always_lock_free);
+      static_assert(sizeof(std::atomic<uint32_t>) == sizeof(uint32_t));
+
+      //----------------------------------------------------------------------
+      //!  How long to spin before sleeping.  We don't spin at all on a
+      //!  single CPU, where it would only delay the other side.
+      //----------------------------------------------------------------------
+      static constexpr std::chrono::microseconds  k_spinTime =
+        std::chrono::microseconds(20);
+
+      //----------------------------------------------------------------------
+      //!  How often a sleeping side checks that the other process is
+      //!  still there.
+      //----------------------------------------------------------------------
+      static constexpr std::chrono::milliseconds  k_livenessInterval =
+        std::chrono::milliseconds(100);
+      
+      //----------------------------------------------------------------------
+      //!  Initializes the control block at @c control.  Done once, by
+      //!  the process that creates the shared memory.
+      //----------------------------------------------------------------------
+      static void Initialize(void *control);
+      
+      //----------------------------------------------------------------------
+      //!  Default constructor.  Attach() before use.
+      //----------------------------------------------------------------------
+      ShmRing();
+
+      ShmRing(const ShmRing &) = delete;
+      ShmRing & operator = (const ShmRing &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Attaches to the control block at @c control and the @c capacity
+      //!  bytes at @c data.  @c capacity must be a power of 2.
+      //!  @c socketFd is the UNIX domain socket to the other process, or
+      //!  -1 if there is none (within a process).
+      //----------------------------------------------------------------------
+      void Attach(void *control, char *data, size_t capacity, int socketFd);
+
+      //----------------------------------------------------------------------
+      //!  Producer: waits for free space and returns a pointer to it,
+      //!  setting @c len to the contiguous length.  Returns nullptr if
+      //!  the ring is closed (or the other process is gone).
+      //----------------------------------------------------------------------
+      char *WriteSpan(size_t & len);
+
+      //----------------------------------------------------------------------
+      //!  Producer: makes @c len bytes written at the last WriteSpan()
+      //!  visible to the consumer, waking it if it's asleep.
+      //----------------------------------------------------------------------
+      void Produce(size_t len);
+
+      //----------------------------------------------------------------------
+      //!  Consumer: waits for data and returns a pointer to it, setting
+      //!  @c len to the contiguous length.  Returns nullptr once the ring
+      //!  is closed and empty (or the other process is gone).
+      //----------------------------------------------------------------------
+      const char *ReadSpan(size_t & len);
+
+      //----------------------------------------------------------------------
+      //!  Consumer: releases @c len bytes returned by ReadSpan() to the
+      //!  producer, waking it if it's asleep.
+      //----------------------------------------------------------------------
+      void Consume(size_t len);
+
+      //----------------------------------------------------------------------
+      //!  Consumer: returns the number of bytes that can be read without
+      //!  waiting.
+      //----------------------------------------------------------------------
+      size_t Readable() const;
+
+      //----------------------------------------------------------------------
+      //!  Consumer: waits up to @c timeout for at least @c numBytes (or
+      //!  a full ring, if @c numBytes is larger) to be readable.
+      //!  Returns true if they are, false on timeout or if the ring is
+      //!  closed first.
+      //----------------------------------------------------------------------
+      bool WaitReadable(size_t numBytes, std::chrono::milliseconds timeout);
+
+      //----------------------------------------------------------------------
+      //!  Closes the ring, waking both sides.  The consumer can still
+      //!  read what's already in the ring.
+      //----------------------------------------------------------------------
+      void Close();
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the ring has been closed by either side.
+      //----------------------------------------------------------------------
+      bool Closed() const;
+      
+    private:
+      Control   *_control;
+      char      *_data;
+      size_t     _capacity;
+      int        _socketFd;
+      uint64_t   _head;
+      uint64_t   _tail;
+
+      bool PeerAlive() const;
+      template <typename Pred>
+      bool Wait(std::atomic<uint32_t> & seq, std::atomic<uint32_t> & waiting,
+                Pred ready, std::chrono::steady_clock::time_point deadline =
+                std::chrono::steady_clock::time_point::max());
+      void Wake(std::atomic<uint32_t> & seq, std::atomic<uint32_t> & waiting);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESHMRING_HH_
@@ -42,9 +42,11 @@
 #ifndef _DWMCREDENCESHORTSTRING_HH_
 #define _DWMCREDENCESHORTSTRING_HH_
 
+#include <array>
 #include <cstring>       // for strlen()
 #include <iomanip>       // for setw()
 #include <string>
+#include <string_view>
 
 #include "DwmStreamIO.hh"
 #include "DwmSysLogger.hh"
@@ -55,6 +57,11 @@ namespace Dwm {
 
     //------------------------------------------------------------------------
     //!  Encapsulates a string that is restricted to LEN bytes or less.
+    //!  The content is stored inline (no heap allocation), so a ShortString
+    //!  sized for a key keeps the key material inside the object that owns
+    //!  it.  The binary form written by Write() and read by Read() is the
+    //!  length (in the smallest unsigned integer type that can hold LEN)
+    //!  followed by the content.
     //------------------------------------------------------------------------
     template <size_t LEN>
     class ShortString
@@ -63,7 +70,7 @@ namespace Dwm {
       //----------------------------------------------------------------------
       //!  Default constructor.
       //----------------------------------------------------------------------
-      ShortString() : _s()  { }
+      ShortString() : _len(0), _buf()  { }
       
       //----------------------------------------------------------------------
       //!  Copy constructor.
@@ -82,7 +89,7 @@ namespace Dwm {
       void Assign(const ShortString<T> & ss)
         requires (ShortString<T>::Size() <= LEN)
       {
-        _s = ss.Value();
+        Set(ss.Value());
         return;
       }
 
@@ -91,9 +98,18 @@ namespace Dwm {
       //!  s.size() is greater than LEN.
       //----------------------------------------------------------------------
       ShortString(const std::string & s)
+          : ShortString(std::string_view(s))
+      { }
+
+      //----------------------------------------------------------------------
+      //!  Construct from the given string_view @c s.  Throws an exception if
+      //!  s.size() is greater than LEN.
+      //----------------------------------------------------------------------
+      ShortString(std::string_view s)
+          : _len(0), _buf()
       {
         if (s.size() <= LEN) {
-          _s = s;
+          Set(s);
         }
         else {
           throw std::logic_error("Initializing string too long");
@@ -106,6 +122,7 @@ namespace Dwm {
       //!  will be thrown.
       //----------------------------------------------------------------------
       ShortString(const char *s)
+          : _len(0), _buf()
       {
         if (nullptr == s) {
           throw std::logic_error("ShortString can't be constructed"
@@ -114,7 +131,7 @@ namespace Dwm {
         if (LEN < std::strlen(s)) {
           throw std::logic_error("Initializing string too long");
         }
-        _s.assign(s);
+        Set(s);
       }
 
       //----------------------------------------------------------------------
@@ -125,33 +142,52 @@ namespace Dwm {
       //----------------------------------------------------------------------
       //!  Returns the contained string value.
       //----------------------------------------------------------------------
-      const std::string & Value() const  { return _s; }
-      
+      std::string_view Value() const
+      { return std::string_view(_buf.data(), _len); }
+
       //----------------------------------------------------------------------
       //!  Returns a copy of the contained string value.
       //----------------------------------------------------------------------
-      explicit operator std::string () const  { return _s; }
+      explicit operator std::string () const
+      { return std::string(_buf.data(), _len); }
 
+      //----------------------------------------------------------------------
+      //!  Returns a pointer to the content.
+      //----------------------------------------------------------------------
+      const char *Data() const  { return _buf.data(); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the length of the content.
+      //----------------------------------------------------------------------
+      size_t Length() const  { return _len; }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the content is empty.
+      //----------------------------------------------------------------------
+      bool Empty() const  { return (0 == _len); }
+      
       //----------------------------------------------------------------------
       //!  Reads the short string from the given istream @c is.  Returns
-      //!  @c is.
+      //!  @c is.  If the length read from @c is is greater than LEN, the
+      //!  failbit is set on @c is.
       //----------------------------------------------------------------------
       std::istream & Read(std::istream & is)
       {
-        _s.clear();
+        Clear();
         if (is) {
           TypeFromSize<LEN>  len;
           if (StreamIO::Read(is, len)) {
-            if (len) {
-              try {
-                _s.resize(len);
-                is.read(_s.data(), len);
-              }
-              catch (...) {
-                is.setstate(std::ios_base::badbit);
-                FSyslog(LOG_ERR, "Failed to allocate {} bytes", len);
+            if (len <= LEN) {
+              if (len) {
+                if (is.read(_buf.data(), len)) {
+                  _len = len;
+                }
               }
             }
+            else {
+              is.setstate(std::ios_base::failbit);
+              FSyslog(LOG_ERR, "ShortString length {} exceeds {}", len, LEN);
+            }
           }
         }
         return is;
@@ -164,10 +200,9 @@ namespace Dwm {
       std::ostream & Write(std::ostream & os) const
       {
         if (os) {
-          TypeFromSize<LEN>  len = _s.size();
-          if (StreamIO::Write(os, len)) {
-            if (len) {
-              os.write(_s.data(), _s.size());
+          if (StreamIO::Write(os, _len)) {
+            if (_len) {
+              os.write(_buf.data(), _len);
             }
           }
         }
@@ -180,7 +215,7 @@ namespace Dwm {
       friend std::ostream & operator << (std::ostream & os,
                                          const ShortString & shortString)
       {
-        return (os << shortString._s);
+        return (os << shortString.Value());
       }
 
       //----------------------------------------------------------------------
@@ -193,13 +228,13 @@ namespace Dwm {
       friend std::istream & operator >> (std::istream & is,
                                          ShortString & shortString)
       {
-        shortString._s.clear();
+        shortString.Clear();
         std::string  s;
         constexpr size_t  maxChars =
           std::remove_reference_t<decltype(shortString)>::Size() + 1;
         if (is >> std::setw(maxChars) >> s) {
           if (s.size() < maxChars) {
-            shortString._s = s;
+            shortString.Set(s);
           }
           else {
             throw std::logic_error("input too long");
@@ -213,7 +248,7 @@ namespace Dwm {
       //----------------------------------------------------------------------
       bool operator == (const ShortString & s) const
       {
-        return (s._s == _s);
+        return (s.Value() == Value());
       }
 
       //----------------------------------------------------------------------
@@ -221,16 +256,20 @@ namespace Dwm {
       //----------------------------------------------------------------------
       bool operator < (const ShortString & s) const
       {
-        return (_s < s._s);
+        return (Value() < s.Value());
       }
       
       //----------------------------------------------------------------------
-      //!  Clears the contents of the ShortString.
+      //!  Clears the contents of the ShortString.  The storage is zeroed,
+      //!  in a way the compiler won't optimize away.
       //----------------------------------------------------------------------
       void Clear()
       {
-        _s.assign(_s.size(), '\0');
-        _s.clear();
+        volatile char  *p = _buf.data();
+        for (size_t i = 0; i < _len; ++i) {
+          p[i] = '\0';
+        }
+        _len = 0;
         return;
       }
 
@@ -239,12 +278,16 @@ namespace Dwm {
       //!  hold.  This is the same as the LEN template parameter.
       //----------------------------------------------------------------------
       static consteval size_t Size()  { return _size; }
+
+      //----------------------------------------------------------------------
+      //!  Returns the maximum number of bytes written by Write().
+      //----------------------------------------------------------------------
+      static consteval size_t MaxStreamedLength()
+      { return sizeof(TypeFromSize<LEN>) + LEN; }
       
     private:
       static constexpr const size_t _size = LEN;
 
-      std::string             _s;
-
       //----------------------------------------------------------------------
       //!  Support templates so our length encoding during binary I/O can
       //!  use the minimum size type to hold the length.
@@ -262,6 +305,22 @@ namespace Dwm {
 
       template <size_t N>
       using TypeFromSize = typename decltype(TypeForSizeFn<N>())::type;
+
+      TypeFromSize<LEN>       _len;
+      std::array<char,LEN>    _buf;
+
+      //----------------------------------------------------------------------
+      //!  Caller must ensure s.size() <= LEN.
+      //----------------------------------------------------------------------
+      void Set(std::string_view s)
+      {
+        Clear();
+        if (! s.empty()) {
+          std::memcpy(_buf.data(), s.data(), s.size());
+        }
+        _len = s.size();
+        return;
+      }
     };
     
   }  // namespace Credence
@@ -42,7 +42,15 @@
 #ifndef _DWMCREDENCESIGNER_HH_
 #define _DWMCREDENCESIGNER_HH_
 
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <array>
+#include <cstdint>
+#include <span>
 #include <string>
+#include <string_view>
 
 namespace Dwm {
 
@@ -50,17 +58,25 @@ namespace Dwm {
 
     //------------------------------------------------------------------------
     //!  Encapsulates message signing and opening of signed messages.
+    //!  Both combined mode (signature prepended to the message) and
+    //!  detached mode (signature kept separate from the message) are
+    //!  supported.
     //------------------------------------------------------------------------
     class Signer
     {
     public:
+      //----------------------------------------------------------------------
+      //!  A detached Ed25519 signature.
+      //----------------------------------------------------------------------
+      using Signature = std::array<uint8_t,crypto_sign_BYTES>;
+      
       //----------------------------------------------------------------------
       //!  Signs the given @c message with the given @c signingKey, storing
       //!  the signed message in @c signedMessage.  Returns true on success,
       //!  false on failure.
       //----------------------------------------------------------------------
-      static bool Sign(const std::string & message,
-                       const std::string & signingKey,
+      static bool Sign(std::string_view message,
+                       std::string_view signingKey,
                        std::string & signedMessage);
       
       //----------------------------------------------------------------------
@@ -69,9 +85,45 @@ namespace Dwm {
       //!  signed message in @c message.  Returns true on success, false on
       //!  failure.
       //----------------------------------------------------------------------
-      static bool Open(const std::string & signedMessage,
-                       const std::string & publicKey,
+      static bool Open(std::string_view signedMessage,
+                       std::string_view publicKey,
                        std::string & message);
+
+      //----------------------------------------------------------------------
+      //!  Signs the given @c message with the given @c signingKey, storing
+      //!  the detached signature in @c signature.  Returns true on
+      //!  success, false on failure.
+      //----------------------------------------------------------------------
+      static bool SignDetached(std::span<const uint8_t> message,
+                               std::string_view signingKey,
+                               Signature & signature);
+
+      //----------------------------------------------------------------------
+      //!  Just a convenience wrapper for SignDetached() with a string
+      //!  @c message.
+      //----------------------------------------------------------------------
+      static bool SignDetached(std::string_view message,
+                               std::string_view signingKey,
+                               Signature & signature);
+      
+      //----------------------------------------------------------------------
+      //!  Verifies that the given detached @c signature of the given
+      //!  @c message was created by the owner of the given @c publicKey.
+      //!  Returns true if the signature is valid, else returns false.
+      //----------------------------------------------------------------------
+      static bool VerifyDetached(std::span<const uint8_t> message,
+                                 std::span<const uint8_t,crypto_sign_BYTES>
+                                 signature,
+                                 std::string_view publicKey);
+      
+      //----------------------------------------------------------------------
+      //!  Just a convenience wrapper for VerifyDetached() with a string
+      //!  @c message.
+      //----------------------------------------------------------------------
+      static bool VerifyDetached(std::string_view message,
+                                 std::span<const uint8_t,crypto_sign_BYTES>
+                                 signature,
+                                 std::string_view publicKey);
     };
 
   }  // namespace Credence
@@ -0,0 +1,135 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSocketInBuffer.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SocketInBuffer class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESOCKETINBUFFER_HH_
+#define _DWMCREDENCESOCKETINBUFFER_HH_
+
+#include <chrono>
+#include <memory>
+#include <streambuf>
+#include <string_view>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A std::streambuf that reads from a connected socket descriptor.
+    //!  It only reads; writes to the same socket can be done at the same
+    //!  time from another thread through a SocketOutBuffer, since the two
+    //!  share nothing but the descriptor.  Reads block until data is
+    //!  available, even if the descriptor is in non-blocking mode.  The
+    //!  descriptor is not owned.
+    //!
+    //!  Reads fill a buffer of a configurable size (much larger than the
+    //!  one in boost::asio's socket iostreams), and reads of at least a
+    //!  buffer's worth go straight into the caller's memory.  Since data
+    //!  can sit in our buffer where the kernel can't see it, readiness
+    //!  checks should use BytesReady() rather than asking the socket.
+    //------------------------------------------------------------------------
+    class SocketInBuffer
+      : public std::streambuf
+    {
+    public:
+      static constexpr size_t  k_defaultBufferSize = 64 * 1024;
+      
+      //----------------------------------------------------------------------
+      //!  Construct for the given socket descriptor @c fd.  @c pending is
+      //!  data already read from @c fd (for example by another streambuf)
+      //!  that should be returned before anything else.
+      //----------------------------------------------------------------------
+      SocketInBuffer(int fd, std::string_view pending = std::string_view(),
+                     size_t bufferSize = k_defaultBufferSize);
+
+      SocketInBuffer(const SocketInBuffer &) = delete;
+      SocketInBuffer & operator = (const SocketInBuffer &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Returns the size of our buffer.
+      //----------------------------------------------------------------------
+      size_t BufferSize() const
+      { return _bufferSize; }
+      
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes read from the socket and buffered,
+      //!  but not yet consumed.
+      //----------------------------------------------------------------------
+      size_t Buffered() const
+      { return (egptr() - gptr()); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes that can be read without blocking:
+      //!  what's buffered plus what's waiting in the socket.  Returns -1
+      //!  on error.
+      //----------------------------------------------------------------------
+      ssize_t BytesReady() const;
+
+      //----------------------------------------------------------------------
+      //!  Waits up to @c timeout for BytesReady() to reach @c numBytes.
+      //!  Returns true if it does, false on timeout, error or end of
+      //!  file.
+      //----------------------------------------------------------------------
+      bool WaitForBytesReady(size_t numBytes,
+                             std::chrono::milliseconds timeout) const;
+      
+    protected:
+      int_type underflow() override;
+      std::streamsize xsgetn(char_type *s, std::streamsize n) override;
+      std::streamsize showmanyc() override;
+      
+    private:
+      int                             _fd;
+      size_t                          _bufferSize;
+      std::unique_ptr<char_type[]>    _buffer;
+
+      //----------------------------------------------------------------------
+      //!  Reads at most @c len bytes into @c buf, waiting if none are
+      //!  available.  Returns the number of bytes read, 0 on end of file
+      //!  or -1 on error.
+      //----------------------------------------------------------------------
+      ssize_t Recv(char_type *buf, size_t len);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESOCKETINBUFFER_HH_
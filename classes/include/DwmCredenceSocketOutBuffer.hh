@@ -0,0 +1,128 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSocketOutBuffer.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SocketOutBuffer class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESOCKETOUTBUFFER_HH_
+#define _DWMCREDENCESOCKETOUTBUFFER_HH_
+
+#include <memory>
+#include <streambuf>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A std::streambuf that writes to a connected socket descriptor.
+    //!  The write side counterpart of SocketInBuffer.  Data is buffered
+    //!  until the buffer is full or sync() is called (by flush() on the
+    //!  owning ostream).  Writes block until done, even if the descriptor
+    //!  is in non-blocking mode.  The descriptor is not owned.  A write
+    //!  of at least a buffer's worth is sent directly, in the same
+    //!  sendmsg() call as anything already buffered (typically a frame
+    //!  header), so it is neither copied nor split into a tiny segment.
+    //------------------------------------------------------------------------
+    class SocketOutBuffer
+      : public std::streambuf
+    {
+    public:
+      static constexpr size_t  k_defaultBufferSize = 64 * 1024;
+      
+      //----------------------------------------------------------------------
+      //!  Construct for the given socket descriptor @c fd.
+      //----------------------------------------------------------------------
+      SocketOutBuffer(int fd, size_t bufferSize = k_defaultBufferSize);
+
+      //----------------------------------------------------------------------
+      //!  Sends anything still buffered.
+      //----------------------------------------------------------------------
+      ~SocketOutBuffer();
+      
+      SocketOutBuffer(const SocketOutBuffer &) = delete;
+      SocketOutBuffer & operator = (const SocketOutBuffer &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Returns the size of our buffer.
+      //----------------------------------------------------------------------
+      size_t BufferSize() const
+      { return _bufferSize; }
+      
+      //----------------------------------------------------------------------
+      //!  Returns the number of bytes buffered and not yet sent.
+      //----------------------------------------------------------------------
+      size_t Buffered() const
+      { return (pptr() - pbase()); }
+      
+    protected:
+      int_type overflow(int_type c) override;
+      std::streamsize xsputn(const char_type *s, std::streamsize n) override;
+      int sync() override;
+      
+    private:
+      int                             _fd;
+      size_t                          _bufferSize;
+      std::unique_ptr<char_type[]>    _buffer;
+
+      //----------------------------------------------------------------------
+      //!  Sends all @c len bytes at @c buf, waiting as needed.  Returns
+      //!  true on success, false on failure.
+      //----------------------------------------------------------------------
+      bool SendAll(const char_type *buf, size_t len);
+
+      //----------------------------------------------------------------------
+      //!  Sends all @c headLen bytes at @c head followed by all @c len
+      //!  bytes at @c buf, waiting as needed.  Returns true on success,
+      //!  false on failure.
+      //----------------------------------------------------------------------
+      bool SendAll(const char_type *head, size_t headLen,
+                   const char_type *buf, size_t len);
+
+      //----------------------------------------------------------------------
+      //!  Sends the buffered data.  Returns true on success, false on
+      //!  failure.
+      //----------------------------------------------------------------------
+      bool Drain();
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESOCKETOUTBUFFER_HH_
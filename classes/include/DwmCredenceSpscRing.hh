@@ -0,0 +1,283 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSpscRing.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SpscRing class template definition
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESPSCRING_HH_
+#define _DWMCREDENCESPSCRING_HH_
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <vector>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A bounded single-producer, single-consumer ring buffer.  Exactly
+    //!  one thread may push and exactly one thread may pop.  TryPush(),
+    //!  TryPop() and PopBatch() take no locks and make no system calls.
+    //!  Push() and Pop() wait when full or empty, and a thread only
+    //!  sleeps (and is only woken) when it actually has to wait.
+    //!
+    //!  Either side can Close() the ring with a reason.  The consumer can
+    //!  still pop anything left after the producer closes it, so a
+    //!  receiver drains everything that arrived before EOF.  Used with
+    //!  Peer::StartReceivePump().
+    //------------------------------------------------------------------------
+    template <typename T>
+    class SpscRing
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Why the ring was closed.
+      //----------------------------------------------------------------------
+      enum class State : uint8_t {
+        e_open,
+        e_eof,       //!< producer reached end of input
+        e_failed,    //!< producer failed
+        e_stopped    //!< stopped by request
+      };
+
+      //----------------------------------------------------------------------
+      //!  Construct with room for at least @c capacity entries (rounded
+      //!  up to a power of 2).
+      //----------------------------------------------------------------------
+      explicit SpscRing(size_t capacity)
+          : _slots(std::bit_ceil(std::max(capacity, (size_t)1))),
+            _mask(_slots.size() - 1), _head(0), _tail(0),
+            _state(State::e_open), _signal(0), _producerWaiting(false),
+            _consumerWaiting(false)
+      {}
+
+      SpscRing(const SpscRing &) = delete;
+      SpscRing & operator = (const SpscRing &) = delete;
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of entries the ring can hold.
+      //----------------------------------------------------------------------
+      size_t Capacity() const
+      { return _slots.size(); }
+
+      //----------------------------------------------------------------------
+      //!  Returns the number of entries in the ring.  Only a hint when
+      //!  called from a thread other than the producer or consumer.
+      //----------------------------------------------------------------------
+      size_t Size() const
+      {
+        return (_tail.load(std::memory_order_acquire)
+                - _head.load(std::memory_order_acquire));
+      }
+
+      //----------------------------------------------------------------------
+      //!  Producer only.  Moves @c value into the ring if there's room.
+      //!  Returns true on success, false if full or closed.
+      //----------------------------------------------------------------------
+      bool TryPush(T && value)
+      {
+        if (State::e_open != _state.load(std::memory_order_acquire)) {
+          return false;
+        }
+        size_t  tail = _tail.load(std::memory_order_relaxed);
+        if ((tail - _head.load(std::memory_order_acquire)) > _mask) {
+          return false;
+        }
+        _slots[tail & _mask] = std::move(value);
+        _tail.store(tail + 1);
+        Wake(_consumerWaiting);
+        return true;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Producer only.  Like TryPush(), but waits for room.  Returns
+      //!  false if the ring is closed.
+      //----------------------------------------------------------------------
+      bool Push(T && value)
+      {
+        while (! TryPush(std::move(value))) {
+          if (State::e_open != _state.load(std::memory_order_acquire)) {
+            return false;
+          }
+          WaitFor(_producerWaiting, [this] {
+            return ((State::e_open != _state.load())
+                    || ((_tail.load() - _head.load()) <= _mask));
+          });
+        }
+        return true;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Consumer only.  Moves the oldest entry into @c value if there is
+      //!  one.  Returns true on success, false if empty.
+      //----------------------------------------------------------------------
+      bool TryPop(T & value)
+      {
+        size_t  head = _head.load(std::memory_order_relaxed);
+        if (head == _tail.load(std::memory_order_acquire)) {
+          return false;
+        }
+        value = std::move(_slots[head & _mask]);
+        _head.store(head + 1);
+        Wake(_producerWaiting);
+        return true;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Consumer only.  Moves up to @c maxCount entries to @c out, which
+      //!  must be an output iterator.  Cheaper than repeated TryPop()
+      //!  since the producer is told about the freed room once.  Returns
+      //!  the number of entries moved.
+      //----------------------------------------------------------------------
+      template <typename OutputIt>
+      size_t PopBatch(OutputIt out, size_t maxCount)
+      {
+        size_t  head = _head.load(std::memory_order_relaxed);
+        size_t  count = std::min(_tail.load(std::memory_order_acquire) - head,
+                                 maxCount);
+        for (size_t i = 0; i < count; ++i) {
+          *out++ = std::move(_slots[(head + i) & _mask]);
+        }
+        if (count) {
+          _head.store(head + count);
+          Wake(_producerWaiting);
+        }
+        return count;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Consumer only.  Like TryPop(), but waits for an entry.  Returns
+      //!  false if the ring is empty and closed.
+      //----------------------------------------------------------------------
+      bool Pop(T & value)
+      {
+        while (! TryPop(value)) {
+          if (Done()) {
+            return false;
+          }
+          WaitFor(_consumerWaiting, [this] {
+            return ((State::e_open != _state.load())
+                    || (_tail.load() != _head.load()));
+          });
+        }
+        return true;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Closes the ring with the given @c state (which should not be
+      //!  e_open) and wakes both sides.  Only the first Close() counts.
+      //----------------------------------------------------------------------
+      void Close(State state)
+      {
+        State  open = State::e_open;
+        _state.compare_exchange_strong(open, state);
+        _signal.fetch_add(1);
+        _signal.notify_all();
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns e_open, or why the ring was closed.
+      //----------------------------------------------------------------------
+      State GetState() const
+      { return _state.load(std::memory_order_acquire); }
+
+      //----------------------------------------------------------------------
+      //!  Returns true if the ring is closed and there's nothing left to
+      //!  pop.
+      //----------------------------------------------------------------------
+      bool Done() const
+      {
+        return ((State::e_open != _state.load(std::memory_order_acquire))
+                && (_head.load(std::memory_order_acquire)
+                    == _tail.load(std::memory_order_acquire)));
+      }
+      
+    private:
+      std::vector<T>                     _slots;
+      const size_t                       _mask;
+      alignas(64) std::atomic<size_t>    _head;
+      alignas(64) std::atomic<size_t>    _tail;
+      alignas(64) std::atomic<State>     _state;
+      std::atomic<uint32_t>              _signal;
+      std::atomic<bool>                  _producerWaiting;
+      std::atomic<bool>                  _consumerWaiting;
+
+      //----------------------------------------------------------------------
+      //!  Sleeps until @c ready() is true.  @c waiting tells the other
+      //!  side to bump _signal after its next change.  Reading _signal
+      //!  before re-checking @c ready() means a change made between the
+      //!  check and the wait is not missed.
+      //----------------------------------------------------------------------
+      template <typename Pred>
+      void WaitFor(std::atomic<bool> & waiting, Pred ready)
+      {
+        while (! ready()) {
+          uint32_t  signal = _signal.load();
+          waiting.store(true);
+          if (! ready()) {
+            _signal.wait(signal);
+          }
+          waiting.store(false);
+        }
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Wakes the other side if it's waiting.  Our index store before
+      //!  this and the load of @c waiting are sequentially consistent,
+      //!  pairing with the store of @c waiting and the index load in
+      //!  WaitFor(), so at least one side sees the other's store.
+      //----------------------------------------------------------------------
+      void Wake(std::atomic<bool> & waiting)
+      {
+        if (waiting.load()) {
+          _signal.fetch_add(1);
+          _signal.notify_all();
+        }
+        return;
+      }
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESPSCRING_HH_
@@ -0,0 +1,85 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceStreamSigner.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::StreamSigner class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCESTREAMSIGNER_HH_
+#define _DWMCREDENCESTREAMSIGNER_HH_
+
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <cstdint>
+#include <span>
+#include <string_view>
+
+#include "DwmCredenceEd25519phStream.hh"
+#include "DwmCredenceSigner.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  Ed25519ph (pre-hashed) signer.  Unlike Signer, the message does not
+    //!  need to be in memory all at once; it is fed in pieces via the
+    //!  Update() members, from spans, istreams or memory-mapped files.
+    //!  Final() creates the signature.  An Ed25519ph signature is NOT
+    //!  interchangeable with a plain Ed25519 signature of the same message;
+    //!  it must be verified with StreamVerifier.
+    //------------------------------------------------------------------------
+    class StreamSigner
+      : public Ed25519phStream
+    {
+    public:
+      //----------------------------------------------------------------------
+      //!  Creates the signature of everything passed to Update() since
+      //!  construction or the last Final(), using the given @c signingKey.
+      //!  Resets the signer for a new message.  Returns true on success,
+      //!  false on failure.
+      //----------------------------------------------------------------------
+      bool Final(std::string_view signingKey, Signer::Signature & signature);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCESTREAMSIGNER_HH_
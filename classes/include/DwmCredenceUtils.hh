@@ -49,6 +49,7 @@ extern "C" {
 #include <chrono>
 #include <cstdint>
 #include <string>
+#include <string_view>
 #include <boost/asio.hpp>
 #include <boost/version.hpp>
 
@@ -88,6 +89,14 @@ namespace Dwm {
       static ssize_t BytesReady(BoostTcpSocket & sck);
       static ssize_t BytesReady(BoostUnixSocket & sck);
 
+      //----------------------------------------------------------------------
+      //!  Returns true if the given socket @c sck is open and the other
+      //!  end has not closed it and there is no error pending on it.
+      //!  Unread data does not count as closed.  Does not block.
+      //----------------------------------------------------------------------
+      static bool IsConnected(BoostTcpSocket & sck);
+      static bool IsConnected(BoostUnixSocket & sck);
+
       //----------------------------------------------------------------------
       //!  Waits for at least @c numBytes to be ready to read (without
       //!  blocking) from the given socket @c sck.  If @c endTime arrives
@@ -113,19 +122,26 @@ namespace Dwm {
       //----------------------------------------------------------------------
       //!  Returns the base64 representation of the given binary string @c s.
       //----------------------------------------------------------------------
-      static std::string Bin2Base64(const std::string & s);
+      static std::string Bin2Base64(std::string_view s);
 
       //----------------------------------------------------------------------
       //!  Returns the binary representation of the given base64-encoded
       //!  string @c s.
       //----------------------------------------------------------------------
-      static std::string Base642Bin(const std::string & s);
+      static std::string Base642Bin(std::string_view s);
 
       //----------------------------------------------------------------------
       //!  Returns the current user's home directory.
       //----------------------------------------------------------------------
       static std::string UserHomeDirectory();
 
+      //----------------------------------------------------------------------
+      //!  If @c path starts with '~/', returns @c path with the '~'
+      //!  replaced by the current user's home directory.  Else returns
+      //!  @c path.
+      //----------------------------------------------------------------------
+      static std::string ExpandTilde(const std::string & path);
+
       //----------------------------------------------------------------------
       //!  Returns the current user's login name.
       //----------------------------------------------------------------------
@@ -136,7 +152,12 @@ namespace Dwm {
       //----------------------------------------------------------------------
       static std::string HostName();
 
-      static bool ScalarMult(const std::string & sk, const std::string & pk,
+      //----------------------------------------------------------------------
+      //!  Computes the X25519 shared point @c q from our secret key @c sk
+      //!  and their public key @c pk.  Returns true on success, false on
+      //!  failure (including keys of the wrong size).
+      //----------------------------------------------------------------------
+      static bool ScalarMult(std::string_view sk, std::string_view pk,
                              std::string & q);
 
       //----------------------------------------------------------------------
@@ -145,6 +166,29 @@ namespace Dwm {
       //----------------------------------------------------------------------
       static std::string
       EndPointString(const boost::asio::ip::tcp::endpoint & endPoint);
+
+      //----------------------------------------------------------------------
+      //!  Enables TCP Fast Open on the given listening @c acceptor, with
+      //!  room for @c queueLength pending Fast Open connections.  Clients
+      //!  with a valid cookie may then carry data in their SYN, and the
+      //!  accepted socket is readable as soon as the SYN arrives.  Note
+      //!  the host must also allow server-side Fast Open (on Linux, bit
+      //!  0x2 of the net.ipv4.tcp_fastopen sysctl).  Returns true on
+      //!  success, false if not supported or on failure.  Failure is
+      //!  harmless; clients fall back to a normal handshake.
+      //----------------------------------------------------------------------
+      static bool EnableTcpFastOpen(boost::asio::ip::tcp::acceptor & acceptor,
+                                    int queueLength = 256);
+
+      //----------------------------------------------------------------------
+      //!  Enables client-side TCP Fast Open on the given open but not yet
+      //!  connected socket @c sck.  connect() then returns without
+      //!  waiting for the handshake, and the SYN is sent with the data of
+      //!  the first write.  Only supported where TCP_FASTOPEN_CONNECT is
+      //!  available (Linux).  Returns true on success, false if not
+      //!  supported or on failure.
+      //----------------------------------------------------------------------
+      static bool EnableTcpFastOpenConnect(BoostTcpSocket & sck);
     };
     
   }  // namespace Credence
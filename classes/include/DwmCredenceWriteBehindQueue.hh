@@ -0,0 +1,185 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceWriteBehindQueue.hh
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::WriteBehindQueue class declaration
+//---------------------------------------------------------------------------
+
+#ifndef _DWMCREDENCEWRITEBEHINDQUEUE_HH_
+#define _DWMCREDENCEWRITEBEHINDQUEUE_HH_
+
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <ostream>
+#include <string>
+#include <thread>
+
+namespace Dwm {
+
+  namespace Credence {
+
+    //------------------------------------------------------------------------
+    //!  A bounded queue of serialized messages, written to an ostream by
+    //!  a background thread.  This is what Peer uses for SendAsync()
+    //!  after Peer::EnableWriteBehind().
+    //!
+    //!  The writer takes everything queued, writes it and flushes once,
+    //!  so messages queued while the writer is busy share a frame.  Each
+    //!  message's callback is called on the writer thread once the
+    //!  message is written (true) or can't be (false), so callbacks
+    //!  should be short.  Once a write fails, everything queued and
+    //!  everything pushed later fails.
+    //------------------------------------------------------------------------
+    class WriteBehindQueue
+    {
+    public:
+      using Clock = std::chrono::steady_clock;
+      using Callback = std::function<void(bool)>;
+
+      //----------------------------------------------------------------------
+      //!  What Push() does when the queue is full.
+      //----------------------------------------------------------------------
+      enum class FullPolicy {
+        e_block,   //!< wait for room
+        e_fail     //!< fail the message immediately
+      };
+
+      struct Config
+      {
+        size_t      maxMessages = 1024;
+        size_t      maxBytes = 4 * 1024 * 1024;
+        FullPolicy  fullPolicy = FullPolicy::e_block;
+      };
+
+      struct Counters
+      {
+        uint64_t                   queued;      //!< accepted by Push()
+        uint64_t                   sent;        //!< written successfully
+        uint64_t                   failed;      //!< accepted, not written
+        uint64_t                   rejected;    //!< refused by Push()
+        uint64_t                   flushes;     //!< frames written
+        size_t                     depth;       //!< messages now queued
+        size_t                     bytes;       //!< bytes now queued
+        size_t                     maxDepth;
+        std::chrono::microseconds  totalWait;   //!< Push() to written
+        std::chrono::microseconds  maxWait;
+        std::chrono::microseconds  totalBlocked;  //!< Push() waiting room
+      };
+      
+      //----------------------------------------------------------------------
+      //!  Construct to write to @c os, which must outlive the queue.
+      //!  @c peerName is used in log messages.  Starts the writer thread.
+      //----------------------------------------------------------------------
+      WriteBehindQueue(std::ostream & os, const Config & config,
+                       const std::string & peerName);
+
+      //----------------------------------------------------------------------
+      //!  Calls Stop(false).
+      //----------------------------------------------------------------------
+      ~WriteBehindQueue();
+
+      WriteBehindQueue(const WriteBehindQueue &) = delete;
+      WriteBehindQueue & operator = (const WriteBehindQueue &) = delete;
+      
+      //----------------------------------------------------------------------
+      //!  Queues the serialized message @c msg.  @c callback (if not
+      //!  empty) is called with the result.  If the queue is full, waits
+      //!  for room or fails according to the FullPolicy.  A message
+      //!  larger than the byte limit is accepted once the queue is empty.
+      //!  Returns false (after calling @c callback with false) if the
+      //!  message was not queued.
+      //----------------------------------------------------------------------
+      bool Push(std::string && msg, Callback callback);
+
+      //----------------------------------------------------------------------
+      //!  Like Push(std::string &&, Callback), returning a future for the
+      //!  result instead.
+      //----------------------------------------------------------------------
+      std::future<bool> Push(std::string && msg);
+
+      //----------------------------------------------------------------------
+      //!  Stops the writer thread.  If @c drain is true, everything
+      //!  queued is written first.  Otherwise queued messages that
+      //!  haven't been taken by the writer fail; the caller should shut
+      //!  down the connection first so a write in progress doesn't hold
+      //!  us up.  Later Push() calls fail.
+      //----------------------------------------------------------------------
+      void Stop(bool drain);
+
+      //----------------------------------------------------------------------
+      //!  Returns a snapshot of the counters.
+      //----------------------------------------------------------------------
+      Counters Stats() const;
+      
+    private:
+      struct Entry
+      {
+        std::string        msg;
+        Callback           callback;
+        Clock::time_point  queued;
+      };
+      
+      std::ostream             &_os;
+      const Config              _config;
+      const std::string         _peerName;
+      mutable std::mutex        _mtx;
+      std::condition_variable   _notEmpty;
+      std::condition_variable   _notFull;
+      std::deque<Entry>         _queue;
+      size_t                    _depth;    // includes batch being written
+      size_t                    _bytes;    // ditto
+      bool                      _run;
+      bool                      _failed;
+      Counters                  _stats;
+      std::thread               _writer;
+
+      bool HasRoom(size_t msgSize) const;
+      void WriterLoop();
+      bool Write(std::deque<Entry> & batch);
+      void Complete(std::deque<Entry> & batch, bool ok);
+    };
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _DWMCREDENCEWRITEBEHINDQUEUE_HH_
@@ -42,14 +42,23 @@
 #ifndef _DWMCREDENCEX25519KEYPAIR_HH_
 #define _DWMCREDENCEX25519KEYPAIR_HH_
 
+extern "C" {
+  #include <sodium.h>
+}
+
+#include <string>
+#include <string_view>
+
 #include "DwmCredenceEd25519KeyPair.hh"
+#include "DwmCredenceSecureString.hh"
 
 namespace Dwm {
 
   namespace Credence {
 
     //------------------------------------------------------------------------
-    //!  Encapsulates an X25519 key pair.
+    //!  Encapsulates an X25519 key pair.  The secret key is kept in a
+    //!  SecureArena slot.
     //------------------------------------------------------------------------
     class X25519KeyPair
     {
@@ -58,13 +67,13 @@ namespace Dwm {
       ~X25519KeyPair();
       X25519KeyPair(const Ed25519KeyPair & edkp);
       const std::string & PublicKey() const;
-      const std::string & SecretKey() const;
+      std::string_view SecretKey() const;
       void Clear();
       bool operator == (const X25519KeyPair & xkp) const;
       
     private:
-      std::string  _publicKey;
-      std::string  _secretKey;
+      std::string                                       _publicKey;
+      SecureString<crypto_scalarmult_curve25519_BYTES>  _secretKey;
     };
     
   }  // namespace Credence
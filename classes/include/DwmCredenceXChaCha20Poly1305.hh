@@ -42,6 +42,9 @@
 #ifndef _DWMCREDENCEXCHACHA20POLY1305_HH_
 #define _DWMCREDENCEXCHACHA20POLY1305_HH_
 
+#include <string>
+#include <string_view>
+
 #include "DwmCredenceNonce.hh"
 
 namespace Dwm {
@@ -57,7 +60,7 @@ namespace Dwm {
       //!  false.
       //----------------------------------------------------------------------
       bool Encrypt(std::string & cipherText, const std::string & message,
-                   const Nonce & nonce, const std::string & secretKey);
+                   const Nonce & nonce, std::string_view secretKey);
       
       //----------------------------------------------------------------------
       //!  Decrypts the given @c cipherText using the given @c nonce and
@@ -65,7 +68,7 @@ namespace Dwm {
       //!  returns true.  On failure, clears @c message and returns false.
       //----------------------------------------------------------------------
       bool Decrypt(std::string & message, const std::string & cipherText,
-                   const Nonce & nonce, const std::string & secretKey);
+                   const Nonce & nonce, std::string_view secretKey);
       
     }  // namespace XChaCha20Poly1305
     
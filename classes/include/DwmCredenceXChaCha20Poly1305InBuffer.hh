@@ -42,12 +42,18 @@
 #ifndef _DWMCREDENCEXCHACHA20POLY1305INBUFFER_HH_
 #define _DWMCREDENCEXCHACHA20POLY1305INBUFFER_HH_
 
+extern "C" {
+  #include <sodium.h>
+}
+
 #include <iostream>
 #include <memory>
 #include <streambuf>
 #include <string>
+#include <string_view>
 
 #include "DwmCredenceNonce.hh"
+#include "DwmCredenceSecureString.hh"
 
 namespace Dwm {
 
@@ -73,13 +79,41 @@ namespace Dwm {
         //!  decryption key @c key.  @c key must be 32 bytes since we're
         //!  using XChaCha20.
         //--------------------------------------------------------------------
-        InBuffer(std::istream & is, const std::string & key);
+        InBuffer(std::istream & is, std::string_view key);
 
         //--------------------------------------------------------------------
         //!  
         //--------------------------------------------------------------------
         bool Eof() const
-        { return _is.eof(); }
+        { return _is->eof(); }
+
+        //--------------------------------------------------------------------
+        //!  Changes the encrypted istream we read from to @c is.  Data we
+        //!  have already decrypted is kept, so nothing is lost as long as
+        //!  @c is continues where the old istream left off.
+        //--------------------------------------------------------------------
+        void Rebind(std::istream & is)
+        { _is = &is; }
+
+        //--------------------------------------------------------------------
+        //!  Returns the encrypted istream we read from.
+        //--------------------------------------------------------------------
+        std::istream & Source() const
+        { return *_is; }
+
+        //--------------------------------------------------------------------
+        //!  If @c plaintext is true, frames are read as a length and the
+        //!  data, as written by an OutBuffer in plaintext mode (see
+        //!  OutBuffer::SetPlaintext()).  Data already decrypted is kept.
+        //--------------------------------------------------------------------
+        void SetPlaintext(bool plaintext)
+        { _plaintext = plaintext; }
+
+        //--------------------------------------------------------------------
+        //!  Returns true if frames are read without decryption.
+        //--------------------------------------------------------------------
+        bool Plaintext() const
+        { return _plaintext; }
           
       protected:
         //--------------------------------------------------------------------
@@ -88,9 +122,10 @@ namespace Dwm {
         int_type underflow() override;
 
       private:
-        std::istream                  &_is;
-        std::string                    _key;
+        std::istream                  *_is;
+        SecureString<crypto_aead_xchacha20poly1305_ietf_KEYBYTES>  _key;
         std::unique_ptr<char_type[]>   _buffer;
+        bool                           _plaintext;
         static uint64_t                _maxMessageLength;
 
         //--------------------------------------------------------------------
@@ -101,6 +136,11 @@ namespace Dwm {
         //--------------------------------------------------------------------
         int Reload();
 
+        //--------------------------------------------------------------------
+        //!  Reload() for plaintext frames.
+        //--------------------------------------------------------------------
+        int ReloadPlaintext();
+
         //--------------------------------------------------------------------
         //!  Just a helper to read the nonce and encrypted data from the
         //!  istream given in the first argument of our constructor, placing
@@ -74,7 +74,7 @@ namespace Dwm {
         //!  and a 32-byte shared secret key which will be used to decrypt the
         //!  contents of @c is.
         //--------------------------------------------------------------------
-        Istream(std::istream & is, const std::string & key)
+        Istream(std::istream & is, std::string_view key)
             : std::istream(new InBuffer(is, key))
         {}
 
@@ -91,6 +91,25 @@ namespace Dwm {
         //--------------------------------------------------------------------
         bool Eof() const
         { return (dynamic_cast<InBuffer *>(rdbuf()))->Eof(); }
+
+        //--------------------------------------------------------------------
+        //!  Changes the encrypted istream we read from to @c is, keeping
+        //!  any data already decrypted.  See InBuffer::Rebind().
+        //--------------------------------------------------------------------
+        void Rebind(std::istream & is)
+        { (dynamic_cast<InBuffer *>(rdbuf()))->Rebind(is); }
+
+        //--------------------------------------------------------------------
+        //!  Returns the encrypted istream we read from.
+        //--------------------------------------------------------------------
+        std::istream & Source() const
+        { return (dynamic_cast<InBuffer *>(rdbuf()))->Source(); }
+
+        //--------------------------------------------------------------------
+        //!  See InBuffer::SetPlaintext().
+        //--------------------------------------------------------------------
+        void SetPlaintext(bool plaintext)
+        { (dynamic_cast<InBuffer *>(rdbuf()))->SetPlaintext(plaintext); }
       };
     
     }  // namespace XChaCha20Poly1305
@@ -95,7 +95,7 @@ namespace Dwm {
         //!  the 32-byte encryption key.  Notice that all this does is call
         //!  the base constructor with a new instance of an OutBuffer.
         //--------------------------------------------------------------------
-        Ostream(std::ostream & os, const std::string & key)
+        Ostream(std::ostream & os, std::string_view key)
             : std::ostream(new OutBuffer(os, key))
         {}
       
@@ -106,6 +106,19 @@ namespace Dwm {
         {
           delete rdbuf();
         }
+
+        //--------------------------------------------------------------------
+        //!  Changes the destination ostream to @c os.  Call only after a
+        //!  flush.  See OutBuffer::Rebind().
+        //--------------------------------------------------------------------
+        void Rebind(std::ostream & os)
+        { (dynamic_cast<OutBuffer *>(rdbuf()))->Rebind(os); }
+
+        //--------------------------------------------------------------------
+        //!  See OutBuffer::SetPlaintext().
+        //--------------------------------------------------------------------
+        void SetPlaintext(bool plaintext)
+        { (dynamic_cast<OutBuffer *>(rdbuf()))->SetPlaintext(plaintext); }
       };
       
     }  // namespace XChaCha20Poly1305
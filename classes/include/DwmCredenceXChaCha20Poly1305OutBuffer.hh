@@ -42,8 +42,15 @@
 #ifndef _DWMCREDENCEXCHACHA20POLY1305OUTBUFFER_HH_
 #define _DWMCREDENCEXCHACHA20POLY1305OUTBUFFER_HH_
 
+extern "C" {
+  #include <sodium.h>
+}
+
 #include <iostream>
 #include <string>
+#include <string_view>
+
+#include "DwmCredenceSecureString.hh"
 
 namespace Dwm {
 
@@ -72,7 +79,30 @@ namespace Dwm {
         //--------------------------------------------------------------------
         //!  Construct with the given ostream @c os and encryption key @c key.
         //--------------------------------------------------------------------
-        OutBuffer(std::ostream & os, const std::string & key);
+        OutBuffer(std::ostream & os, std::string_view key);
+
+        //--------------------------------------------------------------------
+        //!  Changes the ostream we write encrypted data to to @c os.  Call
+        //!  only when nothing is buffered (after a flush).
+        //--------------------------------------------------------------------
+        void Rebind(std::ostream & os)
+        { _os = &os; }
+
+        //--------------------------------------------------------------------
+        //!  If @c plaintext is true, frames are written as a length and
+        //!  the data, with no nonce, encryption or MAC.  Only for
+        //!  channels that are already private and reliable, such as a
+        //!  UNIX domain socket, and only when the reader does the same
+        //!  (see InBuffer::SetPlaintext()).  Call only after a flush.
+        //--------------------------------------------------------------------
+        void SetPlaintext(bool plaintext)
+        { _plaintext = plaintext; }
+
+        //--------------------------------------------------------------------
+        //!  Returns true if frames are written without encryption.
+        //--------------------------------------------------------------------
+        bool Plaintext() const
+        { return _plaintext; }
         
       protected:
         int_type overflow(int_type c) override;
@@ -80,9 +110,10 @@ namespace Dwm {
         std::streamsize xsputn(const char *p, std::streamsize n) override;
 
       private:
-        std::ostream    & _os;
-        std::string       _key;
+        std::ostream     *_os;
+        SecureString<crypto_aead_xchacha20poly1305_ietf_KEYBYTES>  _key;
         std::string       _plainbuf;
+        bool              _plaintext;
       };
       
 
@@ -0,0 +1,390 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceAdmissionControl.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::AdmissionControl class implementation
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+
+#include "DwmCredenceAdmissionControl.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    AdmissionControl::Ticket::Ticket(Ticket && ticket) noexcept
+        : _admissionControl(ticket._admissionControl)
+    {
+      ticket._admissionControl = nullptr;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    AdmissionControl::Ticket &
+    AdmissionControl::Ticket::operator = (Ticket && ticket) noexcept
+    {
+      if (&ticket != this) {
+        Release();
+        _admissionControl = ticket._admissionControl;
+        ticket._admissionControl = nullptr;
+      }
+      return *this;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::Ticket::Release()
+    {
+      if (nullptr != _admissionControl) {
+        _admissionControl->ReleaseHandshake();
+        _admissionControl = nullptr;
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    AdmissionControl::AdmissionControl()
+        : _allowed(nullptr), _bucketsMtx(), _buckets(), _lru(), _rate(0),
+          _burst(0), _v4Len(32), _v6Len(64), _maxSources(65536),
+          _maxHandshakes(0), _activeHandshakes(0), _admitted(0),
+          _notAllowed(0), _rateLimited(0), _handshakeLimit(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::AllowedClients(const set<IpPrefix> & prefixes)
+    {
+      AllowedClients(make_shared<const PrefixTrie>(prefixes));
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::AllowedClients(shared_ptr<const PrefixTrie> trie)
+    {
+      _allowed.store(std::move(trie));
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    shared_ptr<const PrefixTrie> AdmissionControl::AllowedClients() const
+    {
+      return _allowed.load();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::SetRate(double perSecond, double burst)
+    {
+      lock_guard  lck(_bucketsMtx);
+      _rate = max(perSecond, 0.0);
+      _burst = max(burst, 1.0);
+      _buckets.clear();
+      _lru.clear();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::SetSourcePrefixLengths(uint8_t v4Len,
+                                                  uint8_t v6Len)
+    {
+      lock_guard  lck(_bucketsMtx);
+      _v4Len = min(v4Len, (uint8_t)32);
+      _v6Len = min(v6Len, (uint8_t)128);
+      _buckets.clear();
+      _lru.clear();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::SetMaxSources(size_t maxSources)
+    {
+      lock_guard  lck(_bucketsMtx);
+      _maxSources = max(maxSources, (size_t)1);
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::SetMaxHandshakes(size_t maxHandshakes)
+    {
+      _maxHandshakes = maxHandshakes;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Checks are ordered cheapest first.  The allowed clients check is
+    //!  a read-only trie lookup; the handshake limit is a single atomic; only a
+    //!  source that passes both touches the token buckets.
+    //------------------------------------------------------------------------
+    AdmissionControl::Verdict
+    AdmissionControl::Admit(const boost::asio::ip::address & addr,
+                            Ticket & ticket)
+    {
+      Verdict  rc = Verdict::e_notAllowed;
+      ticket.Release();
+      if (! IsAllowed(addr)) {
+        ++_notAllowed;
+      }
+      else if (! AcquireHandshake(ticket)) {
+        rc = Verdict::e_handshakeLimit;
+        ++_handshakeLimit;
+      }
+      else if (! TakeToken(ToKey(addr))) {
+        ticket.Release();
+        rc = Verdict::e_rateLimited;
+        ++_rateLimited;
+      }
+      else {
+        rc = Verdict::e_admitted;
+        ++_admitted;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    AdmissionControl::Verdict AdmissionControl::Admit(Ticket & ticket)
+    {
+      Verdict  rc = Verdict::e_handshakeLimit;
+      ticket.Release();
+      if (AcquireHandshake(ticket)) {
+        rc = Verdict::e_admitted;
+        ++_admitted;
+      }
+      else {
+        ++_handshakeLimit;
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool AdmissionControl::IsAllowed(const boost::asio::ip::address & addr)
+      const
+    {
+      shared_ptr<const PrefixTrie>  allowed = _allowed.load();
+      return ((nullptr == allowed) || allowed->Empty()
+              || allowed->Contains(addr));
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t AdmissionControl::NumSources() const
+    {
+      lock_guard  lck(_bucketsMtx);
+      return _buckets.size();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    AdmissionControl::Counters AdmissionControl::Stats() const
+    {
+      return Counters{ _admitted.load(), _notAllowed.load(),
+                       _rateLimited.load(), _handshakeLimit.load() };
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    const char *AdmissionControl::VerdictString(Verdict verdict)
+    {
+      switch (verdict) {
+        case Verdict::e_admitted:        return "admitted";
+        case Verdict::e_notAllowed:      return "not allowed";
+        case Verdict::e_rateLimited:     return "rate limited";
+        case Verdict::e_handshakeLimit:  return "handshake limit";
+        default:                         break;
+      }
+      return "unknown";
+    }
+    
+    //------------------------------------------------------------------------
+    //!  IPv4-mapped IPv6 addresses (from a dual-stack socket) are treated
+    //!  as IPv4.
+    //------------------------------------------------------------------------
+    AdmissionControl::SourceKey
+    AdmissionControl::ToKey(const boost::asio::ip::address & addr)
+    {
+      SourceKey  key = {0};
+      if (addr.is_v6() && addr.to_v6().is_v4_mapped()) {
+        auto  bytes =
+          boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped,
+                                           addr.to_v6()).to_bytes();
+        key[0] = 4;
+        memcpy(&key[1], bytes.data(), bytes.size());
+      }
+      else if (addr.is_v4()) {
+        auto  bytes = addr.to_v4().to_bytes();
+        key[0] = 4;
+        memcpy(&key[1], bytes.data(), bytes.size());
+      }
+      else {
+        auto  bytes = addr.to_v6().to_bytes();
+        key[0] = 6;
+        memcpy(&key[1], bytes.data(), bytes.size());
+      }
+      return key;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::Mask(SourceKey & key, uint8_t maskLen)
+    {
+      size_t  addrLen = (key[0] == 4) ? 4 : 16;
+      for (size_t i = 0; i < addrLen; ++i) {
+        if (maskLen >= 8) {
+          maskLen -= 8;
+        }
+        else {
+          key[1 + i] &= (uint8_t)(0xff << (8 - maskLen));
+          maskLen = 0;
+        }
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool AdmissionControl::AcquireHandshake(Ticket & ticket)
+    {
+      size_t  maxHandshakes = _maxHandshakes.load();
+      size_t  active = ++_activeHandshakes;
+      if (maxHandshakes && (active > maxHandshakes)) {
+        --_activeHandshakes;
+        return false;
+      }
+      ticket._admissionControl = this;
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void AdmissionControl::ReleaseHandshake()
+    {
+      --_activeHandshakes;
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  _lru orders sources by last use, so when we're full only the
+    //!  least recently used ones need to be checked for having refilled
+    //!  (gone idle).  That keeps each call O(1) amortized, even in a storm
+    //!  of new sources.
+    //------------------------------------------------------------------------
+    bool AdmissionControl::TakeToken(const SourceKey & addrKey)
+    {
+      lock_guard  lck(_bucketsMtx);
+      if (0 == _rate) {
+        return true;
+      }
+      SourceKey  key = addrKey;
+      Mask(key, (key[0] == 4) ? _v4Len : _v6Len);
+      Clock::time_point  now = Clock::now();
+      auto  it = _buckets.find(key);
+      if (_buckets.end() == it) {
+        chrono::duration<double>  refill(_burst / _rate);
+        while ((_buckets.size() >= _maxSources)
+               && ((now - _buckets.at(_lru.back()).last) >= refill)) {
+          _buckets.erase(_lru.back());
+          _lru.pop_back();
+        }
+        if (_buckets.size() >= _maxSources) {
+          return false;
+        }
+        _lru.push_front(key);
+        it = _buckets.emplace(key, Bucket{ _burst, now, _lru.begin() }).first;
+      }
+      else {
+        _lru.splice(_lru.begin(), _lru, it->second.lru);
+      }
+      Bucket  & bucket = it->second;
+      chrono::duration<double>  elapsed = now - bucket.last;
+      bucket.tokens = min(_burst, bucket.tokens + (elapsed.count() * _rate));
+      bucket.last = now;
+      if (bucket.tokens >= 1.0) {
+        bucket.tokens -= 1.0;
+        return true;
+      }
+      return false;
+    }
+
+    //------------------------------------------------------------------------
+    //!  FNV-1a.
+    //------------------------------------------------------------------------
+    size_t AdmissionControl::SourceKeyHash::operator ()
+      (const SourceKey & key) const
+    {
+      size_t  h = 14695981039346656037ULL;
+      for (auto b : key) {
+        h ^= b;
+        h *= 1099511628211ULL;
+      }
+      return h;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -39,6 +39,8 @@
 //!  \brief Dwm::Credence::Authenticator class implementation
 //---------------------------------------------------------------------------
 
+#include <sstream>
+
 #include "DwmStreamIO.hh"
 #include "DwmSysLogger.hh"
 #include "DwmCredenceAuthenticator.hh"
@@ -55,32 +57,56 @@ namespace Dwm {
     //------------------------------------------------------------------------
     Authenticator::Authenticator(const KeyStash & keyStash,
                                  const KnownKeys & knownKeys)
-        : _keyStash(keyStash), _knownKeys(knownKeys)
+        : _keyStash(keyStash), _knownKeys(knownKeys), _authorities(nullptr),
+          _timeout(1000), _executor(nullptr), _identityMtx(), _identity()
+    {}
+
+    //------------------------------------------------------------------------
+    Authenticator::Authenticator(const KeyStash & keyStash,
+                                 const KnownKeys & knownKeys,
+                                 const KeyAuthorities & authorities)
+        : _keyStash(keyStash), _knownKeys(knownKeys),
+          _authorities(&authorities), _timeout(1000), _executor(nullptr),
+          _identityMtx(), _identity()
     {}
 
     //------------------------------------------------------------------------
     bool Authenticator::Authenticate(boost::asio::ip::tcp::iostream & s,
-                                     const std::string & agreedKey,
+                                     std::string_view agreedKey,
                                      string & theirId)
+    {
+      XChaCha20Poly1305::Istream  xis(s, agreedKey);
+      XChaCha20Poly1305::Ostream  xos(s, agreedKey);
+      return Authenticate(s, xis, xos, theirId, _timeout, _executor);
+    }
+
+    //------------------------------------------------------------------------
+    bool Authenticator::
+    Authenticate(boost::asio::local::stream_protocol::iostream & s,
+                 std::string_view agreedKey, string & theirId)
+    {
+      XChaCha20Poly1305::Istream  xis(s, agreedKey);
+      XChaCha20Poly1305::Ostream  xos(s, agreedKey);
+      return Authenticate(s, xis, xos, theirId, _timeout, _executor);
+    }
+
+    //------------------------------------------------------------------------
+    bool Authenticator::Authenticate(boost::asio::ip::tcp::iostream & s,
+                                     XChaCha20Poly1305::Istream & xis,
+                                     XChaCha20Poly1305::Ostream & xos,
+                                     string & theirId,
+                                     chrono::milliseconds timeout,
+                                     HandshakeExecutor *executor)
     {
       bool  rc = false;
       theirId.clear();
       if (s.socket().is_open()) {
         boost::system::error_code  ec;
-        _endPoint = s.socket().remote_endpoint(ec);
+        auto  endPoint = s.socket().remote_endpoint(ec);
         if (! ec) {
-          _xis = make_unique<XChaCha20Poly1305::Istream>(s, agreedKey);
-          _xos = make_unique<XChaCha20Poly1305::Ostream>(s, agreedKey);
-          if ((nullptr != _xis) && (nullptr != _xos)) {
-            Ed25519KeyPair  myKeys;
-            Ed25519Key      theirPubKey;
-            if (ExchangeIds(s, myKeys, theirPubKey)) {
-              if (ExchangeChallenges(myKeys.SecretKey(), theirPubKey)) {
-                theirId = theirPubKey.Id();
-                rc = true;
-              }
-            }
-          }
+          Handshake  hs = { xis, xos, timeout, executor,
+                            Utils::EndPointString(endPoint) };
+          rc = Authenticate(hs, s.socket(), theirId);
         }
         else {
           Syslog(LOG_ERR, "Failed to get remote_endpoint");
@@ -93,26 +119,18 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool Authenticator::
     Authenticate(boost::asio::local::stream_protocol::iostream & s,
-                 const std::string & agreedKey, string & theirId)
+                 XChaCha20Poly1305::Istream & xis,
+                 XChaCha20Poly1305::Ostream & xos, string & theirId,
+                 chrono::milliseconds timeout, HandshakeExecutor *executor)
     {
       bool  rc = false;
       theirId.clear();
       if (s.socket().is_open()) {
         boost::system::error_code  ec;
-        _lendPoint = s.socket().remote_endpoint(ec);
+        auto  endPoint = s.socket().remote_endpoint(ec);
         if (! ec) {
-          _xis = make_unique<XChaCha20Poly1305::Istream>(s, agreedKey);
-          _xos = make_unique<XChaCha20Poly1305::Ostream>(s, agreedKey);
-          if ((nullptr != _xis) && (nullptr != _xos)) {
-            Ed25519KeyPair  myKeys;
-            Ed25519Key      theirPubKey;
-            if (ExchangeIds(s, myKeys, theirPubKey)) {
-              if (ExchangeChallenges(myKeys.SecretKey(), theirPubKey)) {
-                theirId = theirPubKey.Id();
-                rc = true;
-              }
-            }
-          }
+          Handshake  hs = { xis, xos, timeout, executor, endPoint.path() };
+          rc = Authenticate(hs, s.socket(), theirId);
         }
         else {
           Syslog(LOG_ERR, "Failed to get remote_endpoint");
@@ -121,6 +139,94 @@ namespace Dwm {
       
       return rc;
     }
+
+    //------------------------------------------------------------------------
+    bool Authenticator::Authenticate(MemoryPipe & pipe,
+                                     XChaCha20Poly1305::Istream & xis,
+                                     XChaCha20Poly1305::Ostream & xos,
+                                     string & theirId,
+                                     chrono::milliseconds timeout,
+                                     HandshakeExecutor *executor)
+    {
+      bool  rc = false;
+      theirId.clear();
+      if (! pipe.Closed()) {
+        Handshake  hs = { xis, xos, timeout, executor, "memory pipe" };
+        rc = Authenticate(hs, pipe, theirId);
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  We hold our own reference to the identity for the whole
+    //!  handshake, so a concurrent LoadIdentity() can't pull it out from
+    //!  under us.
+    //------------------------------------------------------------------------
+    template <typename SourceT>
+    bool Authenticator::Authenticate(Handshake & hs, SourceT & src,
+                                     string & theirId)
+    {
+      bool  rc = false;
+      shared_ptr<const Identity>  identity = GetIdentity();
+      if (identity) {
+        Ed25519Key  theirPubKey;
+        if (ExchangeIds(hs, src, *identity, theirPubKey)) {
+          if (ExchangeChallenges(hs, identity->keys.SecretKey(),
+                                 theirPubKey)) {
+            theirId = theirPubKey.Id();
+            rc = true;
+          }
+        }
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  In endorsement mode, our endorsement (or an empty endorsement if we
+    //!  don't have one) is part of the ID message.
+    //------------------------------------------------------------------------
+    bool Authenticator::LoadIdentity()
+    {
+      auto  identity = make_shared<Identity>();
+      if (! _keyStash.Get(identity->keys)) {
+        FSyslog(LOG_ERR, "Failed to get my keys from KeyStash in '{}'",
+                _keyStash.DirName());
+        return false;
+      }
+      ostringstream     os;
+      ShortString<255>  id(identity->keys.PublicKey().Id());
+      if (StreamIO::Write(os, id)) {
+        if (nullptr != _authorities) {
+          KeyEndorsement  myEndorsement;
+          _keyStash.GetEndorsement(myEndorsement);
+          myEndorsement.Write(os);
+        }
+      }
+      if (! os) {
+        Syslog(LOG_ERR, "Failed to serialize ID message");
+        return false;
+      }
+      identity->idMessage = os.str();
+      lock_guard<mutex>  lck(_identityMtx);
+      _identity = std::move(identity);
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    shared_ptr<const Authenticator::Identity> Authenticator::GetIdentity()
+    {
+      {
+        lock_guard<mutex>  lck(_identityMtx);
+        if (_identity) {
+          return _identity;
+        }
+      }
+      LoadIdentity();
+      lock_guard<mutex>  lck(_identityMtx);
+      return _identity;
+    }
     
     //------------------------------------------------------------------------
     void Authenticator::SetIdExchangeTimeout(std::chrono::milliseconds ms)
@@ -130,95 +236,148 @@ namespace Dwm {
     }
 
     //------------------------------------------------------------------------
-    bool Authenticator::ExchangeIds(boost::asio::ip::tcp::iostream & s,
-                                    Ed25519KeyPair & myKeys,
+    void Authenticator::SetExecutor(HandshakeExecutor *executor)
+    {
+      _executor = executor;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The istream under hs.xis may have already read data from the
+    //!  socket into its buffer, where the socket can't see it.
+    //------------------------------------------------------------------------
+    template <typename SocketT>
+    bool Authenticator::WaitForBytesReady(Handshake & hs, SocketT & sck,
+                                          uint32_t numBytes)
+    {
+      std::streamsize  buffered = hs.xis.Source().rdbuf()->in_avail();
+      if (buffered >= numBytes) {
+        return true;
+      }
+      if (buffered > 0) {
+        numBytes -= buffered;
+      }
+      return Utils::WaitForBytesReady(sck, numBytes, hs.timeout);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  The pipe counts what's already in its stream, so there's nothing
+    //!  to subtract.
+    //------------------------------------------------------------------------
+    bool Authenticator::WaitForBytesReady(Handshake & hs, MemoryPipe & pipe,
+                                          uint32_t numBytes)
+    {
+      return pipe.WaitForBytesReady(numBytes, hs.timeout);
+    }
+    
+    //------------------------------------------------------------------------
+    template <typename SourceT>
+    bool Authenticator::ExchangeIds(Handshake & hs, SourceT & src,
+                                    const Identity & identity,
                                     Ed25519Key & theirPubKey)
     {
       bool  rc = false;
-      if (_keyStash.Get(myKeys)) {
-        ShortString<255>  myId(myKeys.PublicKey().Id());
-        if (Send(myId)) {
-          uint32_t  minBytes = crypto_secretbox_NONCEBYTES
-            + crypto_aead_xchacha20poly1305_ietf_ABYTES + 1;
-          if (Utils::WaitForBytesReady(s.socket(), minBytes, _timeout)) {
-            ShortString<255> theirId;
-            string           theirPubKeyStr;
-            if (Receive(theirId)) {
-              theirPubKeyStr = _knownKeys.Find(theirId.Value());
-              if (! theirPubKeyStr.empty()) {
-                theirPubKey = Ed25519Key(theirId.Value(), theirPubKeyStr);
-                rc = true;
-              }
-              else {
-                FSyslog(LOG_ERR, "Unknown ID {} from peer at {}",
-                        theirId.Value(), EndPointString());
-              }
-            }
-            else {
-              FSyslog(LOG_ERR, "Failed to read ID from peer at {}",
-                      EndPointString());
-            }
+      if (SendId(hs, identity)) {
+        uint32_t  minBytes = crypto_secretbox_NONCEBYTES
+          + crypto_aead_xchacha20poly1305_ietf_ABYTES + 1;
+        if (WaitForBytesReady(hs, src, minBytes)) {
+          string          theirId;
+          KeyEndorsement  theirEndorsement;
+          if (ReceiveId(hs, theirId, theirEndorsement)) {
+            rc = FindPeerKey(hs, theirId, theirEndorsement, theirPubKey);
           }
           else {
-            FSyslog(LOG_ERR, "Peer at {} failed to send ID within {}"
-                    " milliseconds", EndPointString(), _timeout.count());
+            FSyslog(LOG_ERR, "Failed to read ID from peer at {}",
+                    hs.endPoint);
           }
         }
         else {
-          FSyslog(LOG_ERR, "Failed to send ID to peer at {}",
-                  EndPointString());
+          FSyslog(LOG_ERR, "Peer at {} failed to send ID within {}"
+                  " milliseconds", hs.endPoint, hs.timeout.count());
         }
       }
       else {
-        FSyslog(LOG_ERR, "Failed to get my keys from KeyStash in '{}'",
-                _keyStash.DirName());
+        FSyslog(LOG_ERR, "Failed to send ID to peer at {}", hs.endPoint);
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Sends the ID message serialized by LoadIdentity().
+    //------------------------------------------------------------------------
+    bool Authenticator::SendId(Handshake & hs, const Identity & identity)
+    {
+      bool  rc = false;
+      if (hs.xos.write(identity.idMessage.data(),
+                       identity.idMessage.size())) {
+        if (hs.xos.flush()) {
+          rc = true;
+        }
+        else {
+          Syslog(LOG_ERR, "Failed to flush xos");
+        }
+      }
+      else {
+        Syslog(LOG_ERR, "Failed to write ID to xos");
       }
       return rc;
     }
 
     //------------------------------------------------------------------------
-    bool Authenticator::
-    ExchangeIds(boost::asio::local::stream_protocol::iostream & s,
-                Ed25519KeyPair & myKeys, Ed25519Key & theirPubKey)
+    //!  
+    //------------------------------------------------------------------------
+    bool Authenticator::ReceiveId(Handshake & hs, string & theirId,
+                                  KeyEndorsement & endorsement)
     {
       bool  rc = false;
-      if (_keyStash.Get(myKeys)) {
-        ShortString<255>  myId(myKeys.PublicKey().Id());
-        if (Send(myId)) {
-          uint32_t  minBytes = crypto_secretbox_NONCEBYTES
-            + crypto_aead_xchacha20poly1305_ietf_ABYTES + 1;
-          if (Utils::WaitForBytesReady(s.socket(), minBytes, _timeout)) {
-            ShortString<255> theirId;
-            string           theirPubKeyStr;                                   
-            if (Receive(theirId)) {
-              theirPubKeyStr = _knownKeys.Find(theirId.Value());
-              if (! theirPubKeyStr.empty()) {
-                theirPubKey = Ed25519Key(theirId.Value(), theirPubKeyStr);
-                rc = true;
-              }
-              else {
-                FSyslog(LOG_ERR, "Unknown ID {} from peer at {}",
-                        theirId.Value(), EndPointString());
-              }
-            }
-            else {
-              FSyslog(LOG_ERR, "Failed to read ID from peer at {}",
-                      EndPointString());
-            }
-          }
-          else {
-            FSyslog(LOG_ERR, "Peer at {} failed to send ID within {}"
-                    " milliseconds", EndPointString(), _timeout.count());
-          }
+      theirId.clear();
+      endorsement.Clear();
+      ShortString<255>  id;
+      if (Receive(hs, id)) {
+        theirId = id.Value();
+        if (nullptr == _authorities) {
+          rc = true;
         }
         else {
-          FSyslog(LOG_ERR, "Failed to send ID to peer at {}",
-                  EndPointString());
+          rc = Receive(hs, endorsement);
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  A peer in our KnownKeys is accepted without looking at its
+    //!  endorsement.  In endorsement mode, any other peer must present a
+    //!  valid endorsement, and no peer may use a revoked key.
+    //------------------------------------------------------------------------
+    bool Authenticator::FindPeerKey(const Handshake & hs,
+                                    const string & theirId,
+                                    const KeyEndorsement & endorsement,
+                                    Ed25519Key & theirPubKey)
+    {
+      bool    rc = false;
+      string  theirPubKeyStr = _knownKeys.Find(theirId);
+      if (! theirPubKeyStr.empty()) {
+        theirPubKey = Ed25519Key(theirId, theirPubKeyStr);
+        rc = true;
+      }
+      else if ((nullptr != _authorities) && (! endorsement.Empty())) {
+        rc = _authorities->Verify(theirId, endorsement, theirPubKey);
+        if (! rc) {
+          FSyslog(LOG_ERR, "Invalid endorsement for {} from peer at {}",
+                  theirId, hs.endPoint);
         }
       }
       else {
-        FSyslog(LOG_ERR, "Failed to get my keys from KeyStash in '{}'",
-                _keyStash.DirName());
+        FSyslog(LOG_ERR, "Unknown ID {} from peer at {}",
+                theirId, hs.endPoint);
+      }
+      if (rc && (nullptr != _authorities)
+          && _authorities->IsRevoked(theirPubKey.Key())) {
+        FSyslog(LOG_ERR, "Revoked key for {} from peer at {}",
+                theirId, hs.endPoint);
+        theirPubKey.Clear();
+        rc = false;
       }
       return rc;
     }
@@ -226,52 +385,65 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Authenticator::ExchangeChallenges(const Ed25519Key & ourSecretKey,
+    bool Authenticator::ExchangeChallenges(Handshake & hs,
+                                           const Ed25519Key & ourSecretKey,
                                            const Ed25519Key & theirPubKey)
     {
       bool  rc = false;
       //  Send our challenge
       Challenge  ourChallenge(true);
-      if (Send(ourChallenge)) {
+      if (Send(hs, ourChallenge)) {
         //  Receive their challenge
         Challenge  theirChallenge;
-        if (Receive(theirChallenge)) {
+        if (Receive(hs, theirChallenge)) {
           //  Send our response
+          using Op = HandshakeExecutor::Operation;
           ChallengeResponse  ourResponse;
-          if (ourResponse.Create(ourSecretKey, theirChallenge)) {
-            if (Send(ourResponse)) {
+          bool               created = false;
+          auto  create = [&] {
+            created = ourResponse.Create(ourSecretKey, theirChallenge);
+          };
+          if (HandshakeExecutor::RunLimited(hs.executor, Op::e_sign, create)
+              && created) {
+            if (Send(hs, ourResponse)) {
               //  Receive their response
               ChallengeResponse  theirResponse;
-              if (Receive(theirResponse)) {
-                if (theirResponse.Verify(theirPubKey, ourChallenge)) {
+              if (Receive(hs, theirResponse)) {
+                bool  verified = false;
+                auto  verify = [&] {
+                  verified = theirResponse.Verify(theirPubKey, ourChallenge);
+                };
+                if (HandshakeExecutor::RunLimited(hs.executor, Op::e_verify,
+                                                  verify)
+                    && verified) {
                   rc = true;
                   FSyslog(LOG_INFO, "Authenticated {} at {}",
-                          theirPubKey.Id(), EndPointString());
+                          theirPubKey.Id(), hs.endPoint);
                 }
                 else {
                   FSyslog(LOG_INFO, "Failed to authenticate {} at {}",
-                          theirPubKey.Id(), EndPointString());
+                          theirPubKey.Id(), hs.endPoint);
                 }
               }
               else {
                 FSyslog(LOG_ERR, "Failed to read challenge response from"
-                        " {} at {}", theirPubKey.Id(), EndPointString());
+                        " {} at {}", theirPubKey.Id(), hs.endPoint);
               }
             }
             else {
               FSyslog(LOG_ERR, "Failed to send challenge response to"
-                      " {} at {}", theirPubKey.Id(), EndPointString());
+                      " {} at {}", theirPubKey.Id(), hs.endPoint);
             }
           }
         }
         else {
           FSyslog(LOG_ERR, "Failed to read challenge from {} at {}",
-                  theirPubKey.Id(), EndPointString());
+                  theirPubKey.Id(), hs.endPoint);
         }
       }
       else {
         FSyslog(LOG_ERR, "Failed to send challenge to {} at {}",
-                theirPubKey.Id(), EndPointString());
+                theirPubKey.Id(), hs.endPoint);
       }
 
       return rc;
@@ -280,43 +452,19 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Authenticator::Send(const string & msg)
+    bool Authenticator::Send(Handshake & hs, const HasStreamWrite auto & msg)
     {
       bool  rc = false;
-      if (_xos) {
-        if (StreamIO::Write(*_xos, msg)) {
-          if (_xos->flush()) {
-            rc = true;
-          }
-          else {
-            Syslog(LOG_ERR, "Failed to flush _xos");
-          }
+      if (msg.Write(hs.xos)) {
+        if (hs.xos.flush()) {
+          rc = true;
         }
         else {
-          Syslog(LOG_ERR, "Failed to write msg to _xos");
+          Syslog(LOG_ERR, "Failed to flush xos");
         }
       }
-      return rc;
-    }
-    
-    //------------------------------------------------------------------------
-    //!  
-    //------------------------------------------------------------------------
-    bool Authenticator::Send(const HasStreamWrite auto & msg)
-    {
-      bool  rc = false;
-      if (_xos) {
-        if (msg.Write(*_xos)) {
-          if (_xos->flush()) {
-            rc = true;
-          }
-          else {
-            Syslog(LOG_ERR, "Failed to flush _xos");
-          }
-        }
-        else {
-          Syslog(LOG_ERR, "Failed to write msg to _xos");
-        }
+      else {
+        Syslog(LOG_ERR, "Failed to write msg to xos");
       }
       return rc;
     }
@@ -324,45 +472,18 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Authenticator::Receive(string & msg)
+    bool Authenticator::Receive(Handshake & hs, HasStreamRead auto & msg)
     {
       bool  rc = false;
-      if (_xis) {
-        if (StreamIO::Read(*_xis, msg)) {
-          rc = true;
-        }
-        else {
-          Syslog(LOG_ERR, "Failed to read msg from _xis");
-        }
+      if (msg.Read(hs.xis)) {
+        rc = true;
       }
-      return rc;
-    }
-    
-    //------------------------------------------------------------------------
-    //!  
-    //------------------------------------------------------------------------
-    bool Authenticator::Receive(HasStreamRead auto & msg)
-    {
-      bool  rc = false;
-      if (_xis) {
-        if (msg.Read(*_xis)) {
-          rc = true;
-        }
-        else {
-          Syslog(LOG_ERR, "Failed to read msg from _xis");
-        }
+      else {
+        Syslog(LOG_ERR, "Failed to read msg from xis");
       }
       return rc;
     }
 
-    //------------------------------------------------------------------------
-    //!  
-    //------------------------------------------------------------------------
-    std::string Authenticator::EndPointString() const
-    {
-      return Utils::EndPointString(_endPoint);
-    }
-    
   }  // namespace Credence
 
 }  // namespace Dwm
@@ -56,24 +56,36 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    Challenge::Challenge(bool init)
+    Challenge::Challenge(bool init, bool detached)
         : _challenge()
     {
       if (init) {
-        string  buf(32, '\0');
-        randombytes_buf((void *)buf.data(), 32);
-        _challenge = buf;
+        char  buf[k_randomBytes + 1];
+        randombytes_buf(buf, k_randomBytes);
+        buf[k_randomBytes] = (char)k_featureDetached;
+        _challenge = string_view(buf, (detached ? sizeof(buf)
+                                       : k_randomBytes));
       }
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    Challenge::operator const string & () const
+    Challenge::operator string_view () const
     {
       return _challenge.Value();
     }
     
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Challenge::AcceptsDetached() const
+    {
+      string_view  s = _challenge.Value();
+      return ((s.size() == (k_randomBytes + 1))
+              && (((uint8_t)s[k_randomBytes]) & k_featureDetached));
+    }
+    
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -59,13 +59,33 @@ namespace Dwm {
     {
       bool  rc = false;
       if (! signingKey.Key().empty()) {
-        if (! ((string)challenge).empty()) {
-          rc = Signer::Sign(challenge, signingKey.Key(), _response);
+        string_view  challengeData(challenge);
+        if (! challengeData.empty()) {
+          if (challenge.AcceptsDetached()) {
+            Signer::Signature  sig;
+            if (Signer::SignDetached(challengeData, signingKey.Key(), sig)) {
+              _response.assign((const char *)sig.data(), sig.size());
+              rc = true;
+            }
+          }
+          else {
+            rc = Signer::Sign(challengeData, signingKey.Key(), _response);
+          }
         }
       }
       return rc;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ChallengeResponse::Detached() const
+    {
+      //  A combined-mode response is the signature followed by a non-empty
+      //  challenge, so it's always longer than a detached signature.
+      return (_response.size() == crypto_sign_BYTES);
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -98,21 +118,28 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     bool ChallengeResponse::Verify(const Ed25519Key & publicKey,
-                                   const string & challengeString) const
+                                   string_view challengeString) const
     {
-      bool    rc = false;
-      string  signedContent;
-      if (Signer::Open(_response, publicKey.Key(), signedContent)) {
-        if (challengeString == signedContent) {
-          rc = true;
-        }
-        else {
-          FSyslog(LOG_ERR, "Challenge content mismatch: {} != {}",
-                  Utils::Bin2Base64(challengeString),
-                  Utils::Bin2Base64(signedContent));
-        }
+      bool  rc = false;
+      if (Detached()) {
+        span<const uint8_t,crypto_sign_BYTES>
+          sig((const uint8_t *)_response.data(), crypto_sign_BYTES);
+        rc = Signer::VerifyDetached(challengeString, sig, publicKey.Key());
       }
       else {
+        string  signedContent;
+        if (Signer::Open(_response, publicKey.Key(), signedContent)) {
+          if (challengeString == signedContent) {
+            rc = true;
+          }
+          else {
+            FSyslog(LOG_ERR, "Challenge content mismatch: {} != {}",
+                    Utils::Bin2Base64(challengeString),
+                    Utils::Bin2Base64(signedContent));
+          }
+        }
+      }
+      if (! rc) {
         FSyslog(LOG_ERR, "ChallengeResponse::Verify({},{}) failed",
                 Utils::Bin2Base64(publicKey.Key()),
                 Utils::Bin2Base64(challengeString));
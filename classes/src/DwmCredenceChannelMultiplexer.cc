@@ -0,0 +1,494 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceChannelMultiplexer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ChannelMultiplexer class implementation
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+
+#include "DwmStreamIO.hh"
+#include "DwmSysLogger.hh"
+#include "DwmCredenceChannelMultiplexer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    namespace {
+
+      //----------------------------------------------------------------------
+      //!  What goes over the Peer.  A data frame carries a chunk of a
+      //!  message, and is flagged if it's the last chunk.  A credit frame
+      //!  lets the other side send more on a channel.
+      //----------------------------------------------------------------------
+      struct Frame
+      {
+        enum class Type : uint8_t {
+          e_data   = 0,
+          e_credit = 1
+        };
+
+        Type         type = Type::e_data;
+        uint32_t     channel = 0;
+        bool         last = false;
+        uint32_t     credit = 0;
+        std::string  payload;
+
+        std::istream & Read(std::istream & is)
+        {
+          uint8_t  t;
+          if (StreamIO::Read(is, t) && StreamIO::Read(is, channel)) {
+            type = (Type)t;
+            switch (type) {
+              case Type::e_data:
+                if (StreamIO::Read(is, last)) {
+                  StreamIO::Read(is, payload);
+                }
+                break;
+              case Type::e_credit:
+                StreamIO::Read(is, credit);
+                break;
+              default:
+                is.setstate(std::ios_base::failbit);
+                FSyslog(LOG_ERR, "Invalid channel frame type {}", t);
+                break;
+            }
+          }
+          return is;
+        }
+
+        std::ostream & Write(std::ostream & os) const
+        {
+          if (StreamIO::Write(os, (uint8_t)type)
+              && StreamIO::Write(os, channel)) {
+            if (Type::e_data == type) {
+              if (StreamIO::Write(os, last)) {
+                StreamIO::Write(os, payload);
+              }
+            }
+            else {
+              StreamIO::Write(os, credit);
+            }
+          }
+          return os;
+        }
+      };
+      
+    }  // anonymous namespace
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ChannelMultiplexer::ChannelMultiplexer(Peer & peer, uint32_t window,
+                                           uint32_t chunkSize,
+                                           uint32_t maxMessageSize,
+                                           uint32_t maxChannels)
+        : _peer(peer), _window(max(window, 1U)),
+          _chunkSize(max(chunkSize, 1U)), _maxMessageSize(maxMessageSize),
+          _maxChannels(max(maxChannels, 1U)), _mtx(), _sendCv(), _recvCv(),
+          _doneCv(), _channels(), _inFlight(nullptr), _lastSent(0),
+          _run(false),
+          _closed(false), _peerReader(), _peerWriter(), _writerThread(),
+          _readerThread()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ChannelMultiplexer::~ChannelMultiplexer()
+    {
+      Stop();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ChannelMultiplexer::Start()
+    {
+      lock_guard<mutex>  lck(_mtx);
+      if (! _run) {
+        if (_closed) {
+          Syslog(LOG_ERR, "ChannelMultiplexer can't be restarted");
+          return false;
+        }
+        if (! _peer.Split(_peerReader, _peerWriter)) {
+          Syslog(LOG_ERR, "ChannelMultiplexer failed to split Peer");
+          return false;
+        }
+        _run = true;
+        _writerThread = thread(&ChannelMultiplexer::WriterLoop, this);
+        _readerThread = thread(&ChannelMultiplexer::ReaderLoop, this);
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Shutting down the connection wakes the reader (and the writer,
+    //!  if it's blocked sending).
+    //------------------------------------------------------------------------
+    void ChannelMultiplexer::Stop()
+    {
+      {
+        lock_guard<mutex>  lck(_mtx);
+        if (! _run) {
+          return;
+        }
+        _run = false;
+      }
+      Close();
+      _peerReader.Shutdown();
+      _peerWriter.Shutdown();
+      if (_writerThread.joinable()) {
+        _writerThread.join();
+      }
+      if (_readerThread.joinable()) {
+        _readerThread.join();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ChannelMultiplexer::SetPriority(uint32_t channel, uint8_t priority)
+    {
+      lock_guard<mutex>  lck(_mtx);
+      Channel  *ch = GetChannel(channel);
+      if (nullptr != ch) {
+        ch->priority = priority;
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ChannelMultiplexer::Send(uint32_t channel, string_view msg)
+    {
+      if (msg.size() > _maxMessageSize) {
+        FSyslog(LOG_ERR, "Message of {} bytes on channel {} exceeds"
+                " maximum of {}", msg.size(), channel, _maxMessageSize);
+        return false;
+      }
+      Outgoing  out { msg, 0, false };
+      unique_lock<mutex>  lck(_mtx);
+      if (_closed || (! _run)) {
+        return false;
+      }
+      Channel  *chp = GetChannel(channel);
+      if (nullptr == chp) {
+        return false;
+      }
+      Channel  & ch = *chp;
+      ch.outgoing.push_back(&out);
+      _sendCv.notify_one();
+      //  If we're closed while the writer is sending our last chunk, we
+      //  must wait for it to let go of out before we return.
+      _doneCv.wait(lck, [&] {
+        return (out.done || (_closed && (_inFlight != &out)));
+      });
+      if (! out.done) {
+        //  The writer is gone; make sure it can't see us anymore.
+        auto  it = find(ch.outgoing.begin(), ch.outgoing.end(), &out);
+        if (it != ch.outgoing.end()) {
+          ch.outgoing.erase(it);
+        }
+      }
+      return out.done;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ChannelMultiplexer::Receive(uint32_t channel, string & msg)
+    {
+      bool  rc = false;
+      unique_lock<mutex>  lck(_mtx);
+      Channel  *chp = GetChannel(channel);
+      if (nullptr == chp) {
+        return rc;
+      }
+      Channel  & ch = *chp;
+      _recvCv.wait(lck, [&] { return ((! ch.incoming.empty()) || _closed); });
+      if (! ch.incoming.empty()) {
+        msg = std::move(ch.incoming.front().msg);
+        Grant(ch, ch.incoming.front().credit);
+        ch.incoming.pop_front();
+        rc = true;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ChannelMultiplexer::Receive(uint32_t channel, string & msg,
+                                     std::chrono::milliseconds timeout)
+    {
+      bool  rc = false;
+      unique_lock<mutex>  lck(_mtx);
+      Channel  *chp = GetChannel(channel);
+      if (nullptr == chp) {
+        return rc;
+      }
+      Channel  & ch = *chp;
+      _recvCv.wait_for(lck, timeout, [&] {
+        return ((! ch.incoming.empty()) || _closed);
+      });
+      if (! ch.incoming.empty()) {
+        msg = std::move(ch.incoming.front().msg);
+        Grant(ch, ch.incoming.front().credit);
+        ch.incoming.pop_front();
+        rc = true;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ChannelMultiplexer::Closed() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _closed;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Returns nullptr if @c channel doesn't exist and we already have
+    //!  _maxChannels channels.  Caller must hold _mtx.
+    //------------------------------------------------------------------------
+    ChannelMultiplexer::Channel *
+    ChannelMultiplexer::GetChannel(uint32_t channel)
+    {
+      auto  it = _channels.find(channel);
+      if (it == _channels.end()) {
+        if (_channels.size() >= _maxChannels) {
+          FSyslog(LOG_ERR, "Channel {} would exceed maximum of {} channels",
+                  channel, _maxChannels);
+          return nullptr;
+        }
+        it = _channels.emplace(channel, Channel()).first;
+        it->second.sendCredit = _window;
+      }
+      return &it->second;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Picks the channel to send the next chunk from: the highest
+    //!  priority channel with something to send and credit to send it,
+    //!  and among those the first after the one we last sent from.
+    //!  Caller must hold _mtx.
+    //------------------------------------------------------------------------
+    ChannelMultiplexer::Channel *
+    ChannelMultiplexer::NextToSend(uint32_t & channel)
+    {
+      Channel  *rc = nullptr;
+      int       bestRank = 0;
+      for (auto & [id, ch] : _channels) {
+        if (ch.outgoing.empty()) {
+          continue;
+        }
+        const Outgoing  *out = ch.outgoing.front();
+        if ((0 == ch.sendCredit) && (out->offset < out->msg.size())) {
+          continue;
+        }
+        int  rank = ((id > _lastSent) ? 0 : 1);
+        if ((nullptr == rc) || (ch.priority > rc->priority)
+            || ((ch.priority == rc->priority) && (rank < bestRank))) {
+          rc = &ch;
+          bestRank = rank;
+          channel = id;
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Caller must hold _mtx.
+    //------------------------------------------------------------------------
+    void ChannelMultiplexer::Grant(Channel & ch, uint32_t credit)
+    {
+      if (credit) {
+        ch.received -= credit;
+        ch.creditToGrant += credit;
+        _sendCv.notify_one();
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Credit frames go before data, since the other side may be
+    //!  waiting for them.  While we send the last chunk of a message
+    //!  without holding _mtx, _inFlight keeps its Send() call waiting.
+    //------------------------------------------------------------------------
+    void ChannelMultiplexer::WriterLoop()
+    {
+      unique_lock<mutex>  lck(_mtx);
+      while (_run && (! _closed)) {
+        Frame      frame;
+        Outgoing  *done = nullptr;
+        bool       haveFrame = false;
+        for (auto & [id, ch] : _channels) {
+          if (ch.creditToGrant) {
+            frame.type = Frame::Type::e_credit;
+            frame.channel = id;
+            frame.credit = ch.creditToGrant;
+            ch.creditToGrant = 0;
+            haveFrame = true;
+            break;
+          }
+        }
+        if (! haveFrame) {
+          uint32_t  id;
+          Channel  *ch = NextToSend(id);
+          if (nullptr != ch) {
+            Outgoing  *out = ch->outgoing.front();
+            size_t     len = min({out->msg.size() - out->offset,
+                                  (size_t)_chunkSize,
+                                  (size_t)ch->sendCredit});
+            frame.type = Frame::Type::e_data;
+            frame.channel = id;
+            frame.payload.assign(out->msg.substr(out->offset, len));
+            out->offset += len;
+            ch->sendCredit -= len;
+            frame.last = (out->offset == out->msg.size());
+            if (frame.last) {
+              ch->outgoing.pop_front();
+              done = out;
+              _inFlight = out;
+            }
+            _lastSent = id;
+            haveFrame = true;
+          }
+        }
+        if (! haveFrame) {
+          _sendCv.wait(lck);
+          continue;
+        }
+        lck.unlock();
+        bool  sent = _peerWriter.Send(frame);
+        lck.lock();
+        if (nullptr != done) {
+          done->done = sent;
+          _inFlight = nullptr;
+          _doneCv.notify_all();
+        }
+        if (! sent) {
+          break;
+        }
+      }
+      lck.unlock();
+      Close();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Credit for a chunk of a message that isn't complete yet is given
+    //!  back right away.  Credit for the last chunk is given back when
+    //!  the message is consumed by Receive().  Since that lets a message
+    //!  outgrow the window, we bound reassembly by _maxMessageSize.
+    //------------------------------------------------------------------------
+    void ChannelMultiplexer::ReaderLoop()
+    {
+      for (;;) {
+        Frame  frame;
+        if (! _peerReader.Receive(frame)) {
+          break;
+        }
+        lock_guard<mutex>  lck(_mtx);
+        Channel  *chp = GetChannel(frame.channel);
+        if (nullptr == chp) {
+          FSyslog(LOG_ERR, "Peer {} named too many channels", _peerReader.Id());
+          break;
+        }
+        Channel  & ch = *chp;
+        if (Frame::Type::e_data == frame.type) {
+          if (frame.payload.size() > (_window - ch.received)) {
+            FSyslog(LOG_ERR, "Peer {} exceeded window on channel {}",
+                    _peerReader.Id(), frame.channel);
+            break;
+          }
+          if (frame.payload.size() > (_maxMessageSize - ch.partial.size())) {
+            FSyslog(LOG_ERR, "Peer {} exceeded maximum message size on"
+                    " channel {}", _peerReader.Id(), frame.channel);
+            break;
+          }
+          uint32_t  len = frame.payload.size();
+          ch.received += len;
+          ch.partial.append(frame.payload);
+          if (frame.last) {
+            ch.incoming.push_back(Incoming { std::move(ch.partial), len });
+            ch.partial.clear();
+            _recvCv.notify_all();
+          }
+          else {
+            Grant(ch, len);
+          }
+        }
+        else {
+          if (frame.credit > (_window - min(ch.sendCredit, _window))) {
+            FSyslog(LOG_ERR, "Peer {} granted excess credit on channel {}",
+                    _peerReader.Id(), frame.channel);
+            break;
+          }
+          ch.sendCredit += frame.credit;
+          _sendCv.notify_one();
+        }
+      }
+      Close();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ChannelMultiplexer::Close()
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _closed = true;
+      _sendCv.notify_all();
+      _recvCv.notify_all();
+      _doneCv.notify_all();
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -39,6 +39,10 @@
 //!  \brief Dwm::Credence::Ed25519Key class implementation
 //---------------------------------------------------------------------------
 
+extern "C" {
+  #include <sodium.h>
+}
+
 #include "DwmStreamIO.hh"
 #include "DwmCredenceEd25519Key.hh"
 #include "DwmCredenceShortString.hh"
@@ -50,8 +54,7 @@ namespace Dwm {
   namespace Credence {
 
     //------------------------------------------------------------------------
-    Ed25519Key::Ed25519Key(const std::string & id,
-                           const std::string & key)
+    Ed25519Key::Ed25519Key(std::string_view id, std::string_view key)
         : _id(id), _key(key)
     { }
 
@@ -66,9 +69,11 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    std::string Ed25519Key::KeyBase64(const std::string & keyBase64)
+    std::string Ed25519Key::KeyBase64(std::string_view keyBase64)
     {
-      _key = Utils::Base642Bin(keyBase64);
+      std::string  key = Utils::Base642Bin(keyBase64);
+      _key = key;
+      sodium_memzero(key.data(), key.size());
       return KeyBase64();
     }
     
@@ -79,10 +84,10 @@ namespace Dwm {
       _key.Clear();
       ShortString<decltype(_id)::Size()>  id;
       if (StreamIO::Read(is, id)) {
-        ShortString<decltype(_key)::Size()>  key;
+        decltype(_key)  key;
         if (StreamIO::Read(is, key)) {
           _id = id;
-          _key = key;
+          _key = std::move(key);
         }
       }
       return is;
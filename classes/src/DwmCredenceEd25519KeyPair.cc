@@ -57,17 +57,20 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     Ed25519KeyPair::Ed25519KeyPair(const string & id)
-        : _publicKey(id, std::string(crypto_sign_ed25519_PUBLICKEYBYTES, '\0')),
-          _secretKey(id, std::string(crypto_sign_ed25519_SECRETKEYBYTES, '\0'))
+        : _publicKey(), _secretKey()
     {
-      if (_publicKey.Id().empty()) {
-        _publicKey.Id(Utils::UserName() + '@' + Utils::HostName());
+      string  keyId(id);
+      if (keyId.empty()) {
+        keyId = Utils::UserName() + '@' + Utils::HostName();
       }
-      if (_secretKey.Id().empty()) {
-        _secretKey.Id(Utils::UserName() + '@' + Utils::HostName());
-      }
-      crypto_sign_ed25519_keypair((uint8_t *)_publicKey.Key().data(),
-                                  (uint8_t *)_secretKey.Key().data());
+      uint8_t  pk[crypto_sign_ed25519_PUBLICKEYBYTES];
+      uint8_t  sk[crypto_sign_ed25519_SECRETKEYBYTES];
+      crypto_sign_ed25519_keypair(pk, sk);
+      _publicKey = Ed25519Key(keyId, string_view((const char *)pk,
+                                                 sizeof(pk)));
+      _secretKey = Ed25519Key(keyId, string_view((const char *)sk,
+                                                 sizeof(sk)));
+      sodium_memzero(sk, sizeof(sk));
     }
 
     //------------------------------------------------------------------------
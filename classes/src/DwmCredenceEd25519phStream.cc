@@ -0,0 +1,127 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceEd25519phStream.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::Ed25519phStream class implementation
+//---------------------------------------------------------------------------
+
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceMappedFile.hh"
+#include "DwmCredenceEd25519phStream.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    Ed25519phStream::Ed25519phStream()
+    {
+      crypto_sign_init(&_state);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    Ed25519phStream::~Ed25519phStream()
+    {
+      sodium_memzero(&_state, sizeof(_state));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Ed25519phStream::Reset()
+    {
+      crypto_sign_init(&_state);
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Ed25519phStream::Update(span<const uint8_t> data)
+    {
+      return (crypto_sign_update(&_state, data.data(), data.size()) == 0);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Ed25519phStream::Update(istream & is)
+    {
+      bool            rc = false;
+      vector<uint8_t> buf(64 * 1024);
+      while (is) {
+        is.read((char *)buf.data(), buf.size());
+        if (is.gcount() > 0) {
+          if (! Update(span<const uint8_t>(buf.data(), is.gcount()))) {
+            Syslog(LOG_ERR, "crypto_sign_update() failed");
+            return rc;
+          }
+        }
+      }
+      if (is.eof() && (! is.bad())) {
+        rc = true;
+      }
+      else {
+        Syslog(LOG_ERR, "Failed to read stream");
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Ed25519phStream::UpdateFile(const string & path)
+    {
+      bool        rc = false;
+      MappedFile  mappedFile;
+      if (mappedFile.Open(path)) {
+        rc = Update(mappedFile.Data());
+      }
+      return rc;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,173 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceGroupSender.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::GroupSender class implementation
+//---------------------------------------------------------------------------
+
+#include "DwmCredenceGroupSender.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    GroupSender::GroupSender(Peer & peer)
+        : _peer(peer), _head(nullptr), _flushing(false), _messages(0),
+          _frames(0), _failures(0), _maxBatch(0)
+    { }
+
+    //------------------------------------------------------------------------
+    //!  Whoever wins _flushing writes one batch, then clears _flushing
+    //!  and wakes everyone waiting.  Senders whose message is done
+    //!  return; the rest compete to flush the next batch.  A sender that
+    //!  queued just after the flusher took its batch sees _flushing
+    //!  cleared (atomic wait() doesn't miss a change that happened
+    //!  before it was called), so nothing is stranded.
+    //------------------------------------------------------------------------
+    bool GroupSender::SendSerialized(string_view msg)
+    {
+      Node  node;
+      node.msg = msg;
+      node.ok = false;
+      node.done.store(false, memory_order_relaxed);
+      node.next = _head.load(memory_order_relaxed);
+      while (! _head.compare_exchange_weak(node.next, &node,
+                                           memory_order_release,
+                                           memory_order_relaxed)) {
+      }
+      while (! node.done.load(memory_order_acquire)) {
+        bool  expected = false;
+        if (_flushing.compare_exchange_strong(expected, true,
+                                              memory_order_acq_rel)) {
+          FlushBatch();
+          _flushing.store(false, memory_order_release);
+          _flushing.notify_all();
+        }
+        else {
+          _flushing.wait(true, memory_order_acquire);
+        }
+      }
+      return node.ok;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    GroupSender::Counters GroupSender::Stats() const
+    {
+      Counters  counters;
+      counters.messages = _messages.load(memory_order_relaxed);
+      counters.frames = _frames.load(memory_order_relaxed);
+      counters.failures = _failures.load(memory_order_relaxed);
+      counters.maxBatch = _maxBatch.load(memory_order_relaxed);
+      return counters;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The queue is a stack (newest first), so reverse what we take to
+    //!  send in arrival order.
+    //------------------------------------------------------------------------
+    void GroupSender::FlushBatch()
+    {
+      Node  *node = _head.exchange(nullptr, memory_order_acquire);
+      if (nullptr == node) {
+        return;
+      }
+      Node      *first = nullptr;
+      uint64_t   batchSize = 0;
+      while (node) {
+        Node  *next = node->next;
+        node->next = first;
+        first = node;
+        node = next;
+        ++batchSize;
+      }
+      
+      Node    *frameStart = first;
+      size_t   frameSize = 0;
+      bool     ok = true;
+      for (node = first; node; ) {
+        Node  *next = node->next;
+        ok = ok && _peer.SendSerialized(node->msg, false);
+        frameSize += node->msg.size();
+        if ((nullptr == next) || (frameSize >= k_maxFrameSize)) {
+          ok = ok && _peer.SendSerialized(string_view(), true);
+          _frames.fetch_add(1, memory_order_relaxed);
+          Complete(frameStart, next, ok);
+          frameStart = next;
+          frameSize = 0;
+        }
+        node = next;
+      }
+      
+      uint64_t  maxBatch = _maxBatch.load(memory_order_relaxed);
+      while ((batchSize > maxBatch)
+             && (! _maxBatch.compare_exchange_weak(maxBatch, batchSize,
+                                                   memory_order_relaxed))) {
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Once done is set the sender may return and its Node goes away,
+    //!  so we must not touch a Node after setting its done.
+    //------------------------------------------------------------------------
+    void GroupSender::Complete(Node *first, Node *end, bool ok)
+    {
+      uint64_t  count = 0;
+      while (first != end) {
+        Node  *next = first->next;
+        first->ok = ok;
+        first->done.store(true, memory_order_release);
+        first = next;
+        ++count;
+      }
+      _messages.fetch_add(count, memory_order_relaxed);
+      if (! ok) {
+        _failures.fetch_add(count, memory_order_relaxed);
+      }
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
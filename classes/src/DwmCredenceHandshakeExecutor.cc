@@ -0,0 +1,212 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceHandshakeExecutor.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::HandshakeExecutor class implementation
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <exception>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceHandshakeExecutor.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static uint64_t Nanoseconds(HandshakeExecutor::Clock::duration d)
+    {
+      return chrono::duration_cast<chrono::nanoseconds>(d).count();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    HandshakeExecutor::HandshakeExecutor(size_t maxRunning, size_t maxWaiting)
+        : _maxRunning(maxRunning), _maxWaiting(maxWaiting), _mtx(), _cv(),
+          _running(0), _waiting(0), _run(false), _stats()
+    {
+      if (0 == _maxRunning) {
+        _maxRunning = std::max(thread::hardware_concurrency(), 1U);
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    HandshakeExecutor::~HandshakeExecutor()
+    {
+      Stop();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool HandshakeExecutor::Start()
+    {
+      unique_lock  lck(_mtx);
+      _run = true;
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Waiters see _run cleared and leave.  We only wait for running
+    //!  operations, and give up waiting if Start() is called meanwhile
+    //!  since the executor is then in use again.
+    //------------------------------------------------------------------------
+    void HandshakeExecutor::Stop()
+    {
+      unique_lock  lck(_mtx);
+      _run = false;
+      _cv.notify_all();
+      _cv.wait(lck, [this] {
+        return (_run || ((0 == _running) && (0 == _waiting)));
+      });
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool HandshakeExecutor::RunLimited(Operation op, function<void()> fn)
+    {
+      bool               rc = false;
+      Clock::time_point  queued = Clock::now();
+      {
+        unique_lock  lck(_mtx);
+        if (_run
+            && ((_running < _maxRunning) || (_waiting < _maxWaiting))) {
+          ++_waiting;
+          _cv.wait(lck, [this] {
+            return ((! _run) || (_running < _maxRunning));
+          });
+          --_waiting;
+          if (_run) {
+            ++_running;
+            rc = true;
+          }
+          else {
+            //  Stop() may be waiting for us to leave.
+            _cv.notify_all();
+          }
+        }
+        if (! rc) {
+          ++(_stats[(size_t)op].rejected);
+        }
+      }
+      if (! rc) {
+        //  Rejections are counted in _stats; logging them louder would
+        //  add syslog cost just when we're shedding load.
+        Syslog(LOG_DEBUG, "HandshakeExecutor busy or stopped");
+        return rc;
+      }
+      
+      Clock::time_point  started = Clock::now();
+      try {
+        fn();
+      }
+      catch (const exception & ex) {
+        FSyslog(LOG_ERR, "Handshake operation failed: {}", ex.what());
+        rc = false;
+      }
+      catch (...) {
+        Syslog(LOG_ERR, "Handshake operation failed");
+        rc = false;
+      }
+      Clock::time_point  finished = Clock::now();
+      uint64_t  waitNs = Nanoseconds(started - queued);
+      uint64_t  runNs = Nanoseconds(finished - started);
+      
+      unique_lock  lck(_mtx);
+      --_running;
+      OperationStats  & stats = _stats[(size_t)op];
+      ++stats.completed;
+      stats.totalWaitNs += waitNs;
+      stats.totalRunNs += runNs;
+      stats.maxWaitNs = std::max(stats.maxWaitNs, waitNs);
+      stats.maxRunNs = std::max(stats.maxRunNs, runNs);
+      //  Wakes a waiter for our slot, and Stop() if it's waiting for us.
+      _cv.notify_all();
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool HandshakeExecutor::RunLimited(HandshakeExecutor *executor,
+                                       Operation op, function<void()> fn)
+    {
+      bool  rc = false;
+      if (executor) {
+        rc = executor->RunLimited(op, std::move(fn));
+      }
+      else {
+        fn();
+        rc = true;
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    HandshakeExecutor::OperationStats
+    HandshakeExecutor::Stats(Operation op) const
+    {
+      unique_lock  lck(_mtx);
+      return _stats[(size_t)op];
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t HandshakeExecutor::Waiting() const
+    {
+      unique_lock  lck(_mtx);
+      return _waiting;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
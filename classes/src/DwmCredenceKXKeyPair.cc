@@ -45,7 +45,6 @@ extern "C" {
 
 #include "DwmCredenceKXKeyPair.hh"
 #include "DwmCredenceGenericHash.hh"
-#include "DwmCredenceUtils.hh"
 
 namespace Dwm {
 
@@ -62,8 +61,9 @@ namespace Dwm {
       uint8_t  skbuf[crypto_box_SECRETKEYBYTES];
       randombytes_buf(skbuf, sizeof(skbuf));
       crypto_scalarmult_base(pkbuf, skbuf);
-      _publicKey = string((const char *)pkbuf, crypto_box_PUBLICKEYBYTES);
-      _secretKey = string((const char *)skbuf, crypto_box_SECRETKEYBYTES);
+      _publicKey = string_view((const char *)pkbuf, sizeof(pkbuf));
+      _secretKey = string_view((const char *)skbuf, sizeof(skbuf));
+      sodium_memzero(skbuf, sizeof(skbuf));
     }
       
     //------------------------------------------------------------------------
@@ -78,13 +78,13 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    const ShortString<255> & KXKeyPair::PublicKey() const
+    const KXKeyPair::PublicKeyType & KXKeyPair::PublicKey() const
     { return _publicKey; }
     
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    const ShortString<255> & KXKeyPair::SecretKey() const
+    const KXKeyPair::SecretKeyType & KXKeyPair::SecretKey() const
     { return _secretKey; }
 
     //------------------------------------------------------------------------
@@ -96,14 +96,18 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    string KXKeyPair::SharedKey(const string & theirPublicKey) const
+    KXKeyPair::SharedKeyType
+    KXKeyPair::SharedKey(string_view theirPublicKey) const
     {
-      string   rc;
-      string   scalarmult_q;
-      if (Utils::ScalarMult(_secretKey.Value(), theirPublicKey,
-                            scalarmult_q)) {
+      SharedKeyType  rc;
+      uint8_t        q[crypto_scalarmult_BYTES];
+      if ((_secretKey.Length() == crypto_scalarmult_SCALARBYTES)
+          && (theirPublicKey.size() == crypto_scalarmult_BYTES)
+          && (crypto_scalarmult(q, (const uint8_t *)_secretKey.Data(),
+                                (const uint8_t *)theirPublicKey.data())
+              == 0)) {
         GenericHash<crypto_generichash_BYTES>  h;
-        h.Update(scalarmult_q);
+        h.Update(string_view((const char *)q, sizeof(q)));
         if (_publicKey.Value() < theirPublicKey) {
           h.Update(_publicKey.Value());
           h.Update(theirPublicKey);
@@ -112,8 +116,12 @@ namespace Dwm {
           h.Update(theirPublicKey);
           h.Update(_publicKey.Value());
         }
-        rc = h.Final();
+        uint8_t  shared[crypto_generichash_BYTES];
+        h.Final(shared);
+        rc = string_view((const char *)shared, sizeof(shared));
+        sodium_memzero(shared, sizeof(shared));
       }
+      sodium_memzero(q, sizeof(q));
       return rc;
     }
 
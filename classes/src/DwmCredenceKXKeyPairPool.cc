@@ -0,0 +1,171 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceKXKeyPairPool.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KXKeyPairPool class implementation
+//---------------------------------------------------------------------------
+
+#include <system_error>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceKXKeyPairPool.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    KXKeyPairPool::KXKeyPairPool(size_t capacity)
+        : _capacity(capacity), _startStopMtx(), _mtx(), _cv(), _keyPairs(),
+          _thread(), _run(false)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    KXKeyPairPool::~KXKeyPairPool()
+    {
+      Stop();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  _startStopMtx is held until we're done, so we can't start a new
+    //!  thread while Stop() is still joining the old one.
+    //------------------------------------------------------------------------
+    bool KXKeyPairPool::Start()
+    {
+      bool  rc = false;
+      lock_guard   startStopLck(_startStopMtx);
+      unique_lock  lck(_mtx);
+      if (! _run) {
+        _run = true;
+        try {
+          _thread = thread(&KXKeyPairPool::Run, this);
+          rc = true;
+        }
+        catch (const system_error & ex) {
+          _run = false;
+          FSyslog(LOG_ERR, "Failed to start KXKeyPairPool thread: {}",
+                  ex.what());
+        }
+      }
+      else {
+        rc = true;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  _mtx can't be held while joining, since the thread needs it to
+    //!  finish.  _startStopMtx keeps Start() (and another Stop()) out
+    //!  until the join is done.
+    //------------------------------------------------------------------------
+    void KXKeyPairPool::Stop()
+    {
+      lock_guard  startStopLck(_startStopMtx);
+      {
+        unique_lock  lck(_mtx);
+        _run = false;
+      }
+      _cv.notify_all();
+      if (_thread.joinable()) {
+        _thread.join();
+      }
+      unique_lock  lck(_mtx);
+      _keyPairs.clear();
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    unique_ptr<KXKeyPair> KXKeyPairPool::Get()
+    {
+      unique_ptr<KXKeyPair>  rc;
+      {
+        unique_lock  lck(_mtx);
+        if (! _keyPairs.empty()) {
+          rc = std::move(_keyPairs.front());
+          _keyPairs.pop_front();
+        }
+      }
+      _cv.notify_one();
+      if (! rc) {
+        rc = make_unique<KXKeyPair>();
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t KXKeyPairPool::Size() const
+    {
+      unique_lock  lck(_mtx);
+      return _keyPairs.size();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void KXKeyPairPool::Run()
+    {
+      Syslog(LOG_DEBUG, "KXKeyPairPool thread started");
+      unique_lock  lck(_mtx);
+      while (_run) {
+        _cv.wait(lck, [this]
+                 { return ((! _run) || (_keyPairs.size() < _capacity)); });
+        while (_run && (_keyPairs.size() < _capacity)) {
+          //  Generate without holding the lock, so Get() never waits on
+          //  key generation.
+          lck.unlock();
+          auto  keyPair = make_unique<KXKeyPair>();
+          lck.lock();
+          _keyPairs.push_back(std::move(keyPair));
+        }
+      }
+      Syslog(LOG_DEBUG, "KXKeyPairPool thread done");
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
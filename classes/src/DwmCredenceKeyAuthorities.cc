@@ -0,0 +1,197 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceKeyAuthorities.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KeyAuthorities class implementation
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <cstring>
+#include <fstream>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceKeyAuthorities.hh"
+#include "DwmCredenceUtils.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    KeyAuthorities::KeyAuthorities(const string & dirName,
+                                   const string & authoritiesFileName,
+                                   const string & revokedFileName)
+        : _dirName(Utils::ExpandTilde(dirName)),
+          _revokedFileName(revokedFileName),
+          _authorities(dirName, authoritiesFileName), _revokedMtx(),
+          _revoked()
+    {
+      LoadRevoked();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    KeyAuthorities::KeyAuthorities(const KeyAuthorities & keyAuthorities)
+        : _dirName(keyAuthorities._dirName),
+          _revokedFileName(keyAuthorities._revokedFileName),
+          _authorities(keyAuthorities._authorities), _revokedMtx()
+    {
+      std::shared_lock  lck(keyAuthorities._revokedMtx);
+      _revoked = keyAuthorities._revoked;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyAuthorities::Verify(string_view id,
+                                const KeyEndorsement & endorsement,
+                                Ed25519Key & publicKey) const
+    {
+      bool  rc = false;
+      publicKey.Clear();
+      if (endorsement.Empty()) {
+        FSyslog(LOG_ERR, "Empty endorsement for {}", id);
+        return rc;
+      }
+      string  authorityKey =
+        _authorities.Find(string(endorsement.AuthorityId()));
+      if (authorityKey.empty()) {
+        FSyslog(LOG_ERR, "Unknown authority {} in endorsement for {}",
+                endorsement.AuthorityId(), id);
+        return rc;
+      }
+      if (IsRevoked(authorityKey)) {
+        FSyslog(LOG_ERR, "Authority {} in endorsement for {} is revoked",
+                endorsement.AuthorityId(), id);
+        return rc;
+      }
+      Ed25519Key        subject;
+      Utils::TimePoint  expires;
+      if (endorsement.Open(authorityKey, subject, expires)) {
+        if (subject.Id() != id) {
+          FSyslog(LOG_ERR, "Endorsement for {} presented by {}",
+                  subject.Id(), id);
+        }
+        else if (expires <= Utils::Clock::now()) {
+          FSyslog(LOG_ERR, "Endorsement for {} by {} has expired",
+                  id, endorsement.AuthorityId());
+        }
+        else if (IsRevoked(subject.Key())) {
+          FSyslog(LOG_ERR, "Endorsed key for {} is revoked", id);
+        }
+        else {
+          publicKey = subject;
+          rc = true;
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyAuthorities::IsRevoked(string_view publicKey) const
+    {
+      bool  rc = false;
+      if (publicKey.size() == sizeof(RawKey)) {
+        RawKey  rawKey;
+        memcpy(rawKey.data(), publicKey.data(), rawKey.size());
+        std::shared_lock  lck(_revokedMtx);
+        rc = std::binary_search(_revoked.begin(), _revoked.end(), rawKey);
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void KeyAuthorities::Reload()
+    {
+      _authorities.Reload();
+      LoadRevoked();
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void KeyAuthorities::LoadRevoked()
+    {
+      vector<RawKey>  revoked;
+      string          path(_dirName + '/' + _revokedFileName);
+      ifstream        is(path);
+      if (is) {
+        while (is) {
+          Ed25519Key  pk;
+          if (is >> pk) {
+            if (pk.Key().size() == sizeof(RawKey)) {
+              RawKey  rawKey;
+              memcpy(rawKey.data(), pk.Key().data(), rawKey.size());
+              revoked.push_back(rawKey);
+            }
+          }
+          else if (is.eof() || is.bad()) {
+            break;
+          }
+          else if (is.fail()) {
+            is.clear();
+            is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
+          }
+        }
+        std::sort(revoked.begin(), revoked.end());
+        revoked.erase(std::unique(revoked.begin(), revoked.end()),
+                      revoked.end());
+        FSyslog(LOG_INFO, "Loaded {} revoked keys from {}",
+                revoked.size(), path);
+      }
+      else {
+        //  Having no revoked keys is normal.
+        FSyslog(LOG_DEBUG, "No revoked keys in {}", path);
+      }
+      std::unique_lock  lck(_revokedMtx);
+      _revoked = std::move(revoked);
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,210 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceKeyEndorsement.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KeyEndorsement class implementation
+//---------------------------------------------------------------------------
+
+#include <sstream>
+
+#include "DwmStreamIO.hh"
+#include "DwmSysLogger.hh"
+#include "DwmCredenceKeyEndorsement.hh"
+#include "DwmCredenceSigner.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyEndorsement::Create(const Ed25519Key & subject,
+                                const Ed25519Key & authoritySecretKey,
+                                Utils::TimePoint expires)
+    {
+      bool  rc = false;
+      Clear();
+      if (subject.Id().empty() || subject.Key().empty()) {
+        Syslog(LOG_ERR, "Can't endorse an empty key");
+        return rc;
+      }
+      ostringstream  os;
+      uint64_t  expSecs =
+        chrono::duration_cast<chrono::seconds>(expires.time_since_epoch())
+        .count();
+      if (subject.Write(os) && StreamIO::Write(os, expSecs)) {
+        string  signedMsg;
+        if (Signer::Sign(os.str(), authoritySecretKey.Key(), signedMsg)) {
+          if (signedMsg.size() <= k_maxSignedLength) {
+            _authorityId = authoritySecretKey.Id();
+            _signed = signedMsg;
+            rc = true;
+          }
+          else {
+            FSyslog(LOG_ERR, "Endorsement of {} by {} is too long",
+                    subject.Id(), authoritySecretKey.Id());
+          }
+        }
+        else {
+          FSyslog(LOG_ERR, "Failed to sign endorsement of {}", subject.Id());
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyEndorsement::Open(string_view authorityPublicKey,
+                              Ed25519Key & subject,
+                              Utils::TimePoint & expires) const
+    {
+      bool  rc = false;
+      subject.Clear();
+      if (Empty() || authorityPublicKey.empty()) {
+        return rc;
+      }
+      string  content;
+      if (Signer::Open(_signed.Value(), authorityPublicKey, content)) {
+        istringstream  is(content);
+        uint64_t       expSecs;
+        if (subject.Read(is) && StreamIO::Read(is, expSecs)) {
+          expires = Utils::TimePoint(chrono::seconds(expSecs));
+          rc = true;
+        }
+        else {
+          FSyslog(LOG_ERR, "Malformed endorsement from authority {}",
+                  _authorityId.Value());
+          subject.Clear();
+        }
+      }
+      else {
+        FSyslog(LOG_ERR, "Endorsement signature from authority {} is"
+                " invalid", _authorityId.Value());
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    istream & KeyEndorsement::Read(istream & is)
+    {
+      Clear();
+      if (is) {
+        if (StreamIO::Read(is, _authorityId)) {
+          StreamIO::Read(is, _signed);
+        }
+      }
+      return is;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ostream & KeyEndorsement::Write(ostream & os) const
+    {
+      if (StreamIO::Write(os, _authorityId)) {
+        StreamIO::Write(os, _signed);
+      }
+      return os;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void KeyEndorsement::Clear()
+    {
+      _authorityId.Clear();
+      _signed.Clear();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ostream & operator << (ostream & os, const KeyEndorsement & endorsement)
+    {
+      os << endorsement._authorityId << " ed25519-endorsement "
+         << Utils::Bin2Base64(endorsement._signed.Value());
+      return os;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    istream & operator >> (istream & is, KeyEndorsement & endorsement)
+    {
+      endorsement.Clear();
+      if (is) {
+        ShortString<decltype(endorsement._authorityId)::Size()>  authorityId;
+        ShortString<32>                                          tag;
+        ShortString<((decltype(endorsement._signed)::Size() * 4) / 3) + 3>
+          signedMsg;
+        try {
+          is >> authorityId >> tag >> signedMsg;
+        }
+        catch (std::logic_error & ex) {
+          is.setstate(std::ios_base::failbit);
+          return is;
+        }
+        if ((! authorityId.Value().empty())
+            && (tag.Value() == "ed25519-endorsement")
+            && (! signedMsg.Value().empty())) {
+          string  bin = Utils::Base642Bin(signedMsg.Value());
+          if ((! bin.empty())
+              && (bin.size() <= decltype(endorsement._signed)::Size())) {
+            endorsement._authorityId = authorityId;
+            endorsement._signed = bin;
+          }
+          else {
+            is.setstate(std::ios_base::failbit);
+          }
+        }
+        else {
+          is.setstate(std::ios_base::failbit);
+        }
+      }
+      return is;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -50,6 +50,14 @@ namespace Dwm {
 
   namespace Credence {
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    std::unique_ptr<KXKeyPair> KeyExchanger::NewKeyPair(KXKeyPairPool *pool)
+    {
+      return (pool ? pool->Get() : std::make_unique<KXKeyPair>());
+    }
+    
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -80,45 +88,54 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     bool KeyExchanger::ExchangeKeys(boost::asio::ip::tcp::iostream & s,
-                                    std::string & agreedKey,
-                                    std::chrono::milliseconds timeout)
+                                    KXKeyPair::SharedKeyType & agreedKey,
+                                    std::chrono::milliseconds timeout,
+                                    HandshakeExecutor *executor,
+                                    KXKeyPairPool *keyPairPool)
     {
       bool  rc = false;
-      agreedKey.clear();
+      agreedKey.Clear();
       if (s.socket().is_open()) {
-        boost::system::error_code  ec;
-        boost::asio::ip::tcp::endpoint  endPoint =
-          s.socket().remote_endpoint(ec);
-        if (! ec) {
-          KXKeyPair  kxKeys;
-          if (StreamIO::Write(s, kxKeys.PublicKey())) {
-            s.flush();
-            if (Utils::WaitForBytesReady(s.socket(),
-                                         kxKeys.PublicKeyMinimumStreamedLength(),
-                                         timeout)) {
-              ShortString<255>  theirPubKey;
-              if (StreamIO::Read(s, theirPubKey)) {
-                agreedKey = kxKeys.SharedKey(theirPubKey.Value());
-                rc = true;
-              }
-              else {
-                FSyslog(LOG_ERR, "Failed to read public key from {}",
-                        Utils::EndPointString(endPoint));
-              }
+        //  With TCP Fast Open the socket may not be connected until our
+        //  public key goes out in the SYN, so we don't ask for the peer's
+        //  endpoint until we need it for a log message.
+        auto  peerString = [&s] {
+          boost::system::error_code  ec;
+          auto  endPoint = s.socket().remote_endpoint(ec);
+          return (ec ? std::string("unconnected peer")
+                  : Utils::EndPointString(endPoint));
+        };
+        using Op = HandshakeExecutor::Operation;
+        std::unique_ptr<KXKeyPair>  kxKeys;
+        auto  generate = [&] { kxKeys = NewKeyPair(keyPairPool); };
+        if (! HandshakeExecutor::RunLimited(executor, Op::e_keyGeneration,
+                                            generate)) {
+          return rc;
+        }
+        if (StreamIO::Write(s, kxKeys->PublicKey()) && s.flush()) {
+          size_t  minLen = kxKeys->PublicKeyMinimumStreamedLength();
+          if (Utils::WaitForBytesReady(s.socket(), minLen, timeout)) {
+            KXKeyPair::PublicKeyType  theirPubKey;
+            if (StreamIO::Read(s, theirPubKey)) {
+              auto  agree = [&] {
+                agreedKey = kxKeys->SharedKey(theirPubKey.Value());
+              };
+              rc = (HandshakeExecutor::RunLimited(executor,
+                                                  Op::e_keyAgreement, agree)
+                    && (! agreedKey.Empty()));
             }
             else {
-              FSyslog(LOG_ERR, "Peer at {} failed to send public key within"
-                      " {} milliseconds",
-                      Utils::EndPointString(endPoint), timeout.count());
+              FSyslog(LOG_ERR, "Failed to read public key from {}",
+                      peerString());
             }
           }
           else {
-            FSyslog(LOG_ERR, "Failed to send public key to {}",
-                    Utils::EndPointString(endPoint));
+            FSyslog(LOG_ERR, "Peer at {} failed to send public key within"
+                    " {} milliseconds", peerString(), timeout.count());
           }
         }
         else {
-          Syslog(LOG_ERR, "Failed to get endpoint");
+          FSyslog(LOG_ERR, "Failed to send public key to {}", peerString());
         }
       }
       else {
@@ -133,26 +150,38 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool KeyExchanger::
     ExchangeKeys(boost::asio::local::stream_protocol::iostream & s,
-                 std::string & agreedKey,
-                 std::chrono::milliseconds timeout)
+                 KXKeyPair::SharedKeyType & agreedKey,
+                 std::chrono::milliseconds timeout,
+                 HandshakeExecutor *executor,
+                 KXKeyPairPool *keyPairPool)
     {
       bool  rc = false;
-      agreedKey.clear();
+      agreedKey.Clear();
       if (s.socket().is_open()) {
         boost::system::error_code  ec;
         boost::asio::local::stream_protocol::endpoint  endPoint =
           s.socket().remote_endpoint(ec);
         if (! ec) {
-          KXKeyPair  kxKeys;
-          if (StreamIO::Write(s, kxKeys.PublicKey())) {
+          using Op = HandshakeExecutor::Operation;
+          std::unique_ptr<KXKeyPair>  kxKeys;
+          auto  generate = [&] { kxKeys = NewKeyPair(keyPairPool); };
+          if (! HandshakeExecutor::RunLimited(executor, Op::e_keyGeneration,
+                                              generate)) {
+            return rc;
+          }
+          if (StreamIO::Write(s, kxKeys->PublicKey())) {
             s.flush();
-            if (Utils::WaitForBytesReady(s.socket(),
-                                         kxKeys.PublicKeyMinimumStreamedLength(),
-                                         timeout)) {
-              ShortString<255>  theirPubKey;
+            size_t  minLen = kxKeys->PublicKeyMinimumStreamedLength();
+            if (Utils::WaitForBytesReady(s.socket(), minLen, timeout)) {
+              KXKeyPair::PublicKeyType  theirPubKey;
               if (StreamIO::Read(s, theirPubKey)) {
-                agreedKey = kxKeys.SharedKey(theirPubKey.Value());
-                rc = true;
+                auto  agree = [&] {
+                  agreedKey = kxKeys->SharedKey(theirPubKey.Value());
+                };
+                rc = (HandshakeExecutor::RunLimited(executor,
+                                                    Op::e_keyAgreement,
+                                                    agree)
+                      && (! agreedKey.Empty()));
               }
               else {
                 FSyslog(LOG_ERR, "Failed to read public key from {}",
@@ -180,7 +209,58 @@ namespace Dwm {
 
       return rc;
     }
-    
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyExchanger::ExchangeKeys(MemoryPipe & pipe,
+                                    KXKeyPair::SharedKeyType & agreedKey,
+                                    std::chrono::milliseconds timeout,
+                                    HandshakeExecutor *executor,
+                                    KXKeyPairPool *keyPairPool)
+    {
+      bool  rc = false;
+      agreedKey.Clear();
+      if (! pipe.Closed()) {
+        using Op = HandshakeExecutor::Operation;
+        std::unique_ptr<KXKeyPair>  kxKeys;
+        auto  generate = [&] { kxKeys = NewKeyPair(keyPairPool); };
+        if (! HandshakeExecutor::RunLimited(executor, Op::e_keyGeneration,
+                                            generate)) {
+          return rc;
+        }
+        if (StreamIO::Write(pipe.Out(), kxKeys->PublicKey())
+            && pipe.Out().flush()) {
+          size_t  minLen = kxKeys->PublicKeyMinimumStreamedLength();
+          if (pipe.WaitForBytesReady(minLen, timeout)) {
+            KXKeyPair::PublicKeyType  theirPubKey;
+            if (StreamIO::Read(pipe.In(), theirPubKey)) {
+              auto  agree = [&] {
+                agreedKey = kxKeys->SharedKey(theirPubKey.Value());
+              };
+              rc = (HandshakeExecutor::RunLimited(executor,
+                                                  Op::e_keyAgreement, agree)
+                    && (! agreedKey.Empty()));
+            }
+            else {
+              Syslog(LOG_ERR, "Failed to read public key from memory pipe");
+            }
+          }
+          else {
+            FSyslog(LOG_ERR, "Memory pipe peer failed to send public key"
+                    " within {} milliseconds", timeout.count());
+          }
+        }
+        else {
+          Syslog(LOG_ERR, "Failed to send public key to memory pipe");
+        }
+      }
+      else {
+        Syslog(LOG_ERR, "memory pipe is closed");
+      }
+
+      return rc;
+    }
     
   }  // namespace Credence
 
@@ -48,7 +48,6 @@ extern "C" {
 
 #include <filesystem>
 #include <fstream>
-#include <regex>
 
 #include "DwmCredenceKeyStash.hh"
 #include "DwmCredenceUtils.hh"
@@ -63,17 +62,8 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     KeyStash::KeyStash(const string & dirName)
-        : _dirName(dirName)
-    {
-      static const regex  rgx("^~\\/.*");
-      if (regex_match(_dirName, rgx)) {
-        string  homeDir = Utils::UserHomeDirectory();
-        if (! homeDir.empty()) {
-          regex  rplrgx("^~");
-          _dirName = regex_replace(_dirName, rplrgx, homeDir);
-        }
-      }
-    }
+        : _dirName(Utils::ExpandTilde(dirName))
+    {}
 
     //------------------------------------------------------------------------
     //!  
@@ -123,6 +113,55 @@ namespace Dwm {
       return rc;
     }
     
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyStash::SaveEndorsement(const KeyEndorsement & endorsement) const
+    {
+      namespace fs = std::filesystem;
+      
+      bool  rc = false;
+      if (MakeStashDir()) {
+        string    savePath = _dirName + "/id_ed25519.endorsement";
+        ofstream  os(savePath);
+        if (os) {
+          os << endorsement << '\n';
+          os.close();
+          fs::perms  p =
+            fs::perms::owner_read
+            | fs::perms::owner_write
+            | fs::perms::group_read
+            | fs::perms::others_read;
+          error_code  ec;
+          fs::permissions(savePath, p, ec);
+          if (! ec) {
+            rc = true;
+          }
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KeyStash::GetEndorsement(KeyEndorsement & endorsement) const
+    {
+      bool      rc = false;
+      endorsement.Clear();
+      ifstream  is(_dirName + "/id_ed25519.endorsement");
+      if (is) {
+        if (is >> endorsement) {
+          rc = true;
+        }
+        else {
+          FSyslog(LOG_ERR, "Failed to load endorsement from {}",
+                  _dirName + "/id_ed25519.endorsement");
+        }
+      }
+      return rc;
+    }
+    
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -39,8 +39,10 @@
 //!  \brief Dwm::Credence::KnownKeys class implementation
 //---------------------------------------------------------------------------
 
+#include <algorithm>
+#include <atomic>
 #include <fstream>
-#include <regex>
+#include <thread>
 
 #include "DwmStreamIO.hh"
 #include "DwmSysLogger.hh"
@@ -58,16 +60,9 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     KnownKeys::KnownKeys(const string & dirName, const string & fileName)
-        : _dirName(dirName), _fileName(fileName), _keysMtx()
-    {
-      static const regex  rgx("^~\\/.*");
-      if (regex_match(_dirName, rgx)) {
-        string  homeDir = Utils::UserHomeDirectory();
-        if (! homeDir.empty()) {
-          regex  rplrgx("^~");
-          _dirName = regex_replace(_dirName, rplrgx, homeDir);
-        }
-      }
+        : _dirName(Utils::ExpandTilde(dirName)), _fileName(fileName),
+          _keysMtx()
+    {
       LoadKeys();
     }
 
@@ -75,10 +70,12 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     KnownKeys::KnownKeys(const KnownKeys & knownKeys)
-        : _dirName(knownKeys._dirName), _keysMtx()
+        : _dirName(knownKeys._dirName), _fileName(knownKeys._fileName),
+          _keysMtx()
     {
       std::shared_lock  lck(knownKeys._keysMtx);
       _keys = knownKeys._keys;
+      _keyFiles = knownKeys._keyFiles;
     }
 
     //------------------------------------------------------------------------
@@ -90,7 +87,9 @@ namespace Dwm {
         std::shared_lock  lck(knownKeys._keysMtx);
         std::unique_lock  mylck(_keysMtx);
         _dirName = knownKeys._dirName;
+        _fileName = knownKeys._fileName;
         _keys = knownKeys._keys;
+        _keyFiles = knownKeys._keyFiles;
       }
       return *this;
     }
@@ -130,10 +129,83 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
+    bool KnownKeys::ReloadFile(const string & fileName)
+    {
+      namespace fs = std::filesystem;
+
+      bool        rc = false;
+      //  Same rules as LoadKeysDirectory(): a plain name within the
+      //  directory, and no hidden files.
+      if (fileName.empty() || ('.' == fileName[0])
+          || (fileName.find('/') != string::npos)) {
+        FSyslog(LOG_ERR, "Invalid key file name '{}'", fileName);
+        return rc;
+      }
+      error_code  ec;
+      if (! fs::is_directory(Path(), ec)) {
+        FSyslog(LOG_ERR, "{} is not a directory of key files", Path());
+        return rc;
+      }
+      fs::path  filePath(Path() + '/' + fileName);
+      if (fs::is_regular_file(filePath, ec)) {
+        KeyFile  keyFile;
+        keyFile.modTime = fs::last_write_time(filePath, ec);
+        if (! ec) {
+          keyFile.size = fs::file_size(filePath, ec);
+        }
+        if (ec) {
+          FSyslog(LOG_ERR, "Failed to stat {}", filePath.string());
+        }
+        else if (ReadKeyFile(filePath.string(), keyFile.keys)) {
+          std::unique_lock  lck(_keysMtx);
+          auto  it = _keyFiles.find(fileName);
+          keyFile.version =
+            (it != _keyFiles.end()) ? (it->second.version + 1) : 1;
+          _keyFiles[fileName] = std::move(keyFile);
+          MergeKeyFiles();
+          rc = true;
+        }
+      }
+      else if ((! ec) || (ec == errc::no_such_file_or_directory)) {
+        //  Gone, or no longer a regular file.
+        std::unique_lock  lck(_keysMtx);
+        if (_keyFiles.erase(fileName)) {
+          MergeKeyFiles();
+        }
+        rc = true;
+      }
+      else {
+        //  We can't tell if it's still there; keep what we have from it.
+        FSyslog(LOG_ERR, "Failed to stat {}: {}", filePath.string(),
+                ec.message());
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    uint64_t KnownKeys::FileVersion(const string & fileName) const
+    {
+      uint64_t  rc = 0;
+      std::shared_lock  lck(_keysMtx);
+      auto  it = _keyFiles.find(fileName);
+      if (it != _keyFiles.end()) {
+        rc = it->second.version;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The keys we read didn't come from _keyFiles, so we forget the
+    //!  files.  Else a later ReloadFile() would merge the stale files and
+    //!  silently replace what we read.
+    //------------------------------------------------------------------------
     std::istream & KnownKeys::Read(std::istream & is)
     {
       if (is) {
         std::unique_lock  lck(_keysMtx);
+        _keyFiles.clear();
         StreamIO::Read(is, _keys);
       }
       return is;
@@ -171,22 +243,160 @@ namespace Dwm {
     {
       std::unique_lock  lck(_keysMtx);
       _keys.clear();
+      _keyFiles.clear();
       return;
     }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string KnownKeys::Path() const
+    {
+      return (_dirName + '/' + _fileName);
+    }
     
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     bool KnownKeys::LoadKeys()
     {
+      error_code  ec;
+      if (std::filesystem::is_directory(Path(), ec)) {
+        return LoadKeysDirectory();
+      }
+      map<string,string>  keys;
+      bool  rc = ReadKeyFile(Path(), keys);
+      if (rc) {
+        FSyslog(LOG_INFO, "Loaded {} keys from {}", keys.size(), Path());
+      }
+      std::unique_lock  lck(_keysMtx);
+      _keyFiles.clear();
+      _keys = std::move(keys);
+      return (rc && (! _keys.empty()));
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KnownKeys::LoadKeysDirectory()
+    {
+      namespace fs = std::filesystem;
+
+      //  Find the regular files in the directory that are new or have
+      //  changed since we last loaded them.  Files we can't stat are
+      //  kept in fileNames so we hold on to what we loaded from them
+      //  before.
+      vector<string>                  fileNames;
+      vector<pair<string,KeyFile>>    toLoad;
+      error_code                      ec;
+      {
+        std::shared_lock  lck(_keysMtx);
+        for (fs::directory_iterator dit(Path(), ec), dend;
+             (! ec) && (dit != dend); dit.increment(ec)) {
+          const auto &  entry = *dit;
+          string  fileName = entry.path().filename().string();
+          if (fileName.empty() || ('.' == fileName[0])) {
+            continue;
+          }
+          error_code  entryEc;
+          KeyFile     keyFile;
+          bool        isRegular = entry.is_regular_file(entryEc);
+          if (isRegular) {
+            keyFile.modTime = entry.last_write_time(entryEc);
+            if (! entryEc) {
+              keyFile.size = entry.file_size(entryEc);
+            }
+          }
+          if (entryEc == errc::no_such_file_or_directory) {
+            //  Removed since we read the directory, or a dangling
+            //  symbolic link.  Either way it's gone.
+            continue;
+          }
+          if (entryEc) {
+            FSyslog(LOG_ERR, "Failed to stat {}: {}", entry.path().string(),
+                    entryEc.message());
+            fileNames.push_back(fileName);
+            continue;
+          }
+          if (! isRegular) {
+            continue;
+          }
+          fileNames.push_back(fileName);
+          auto  it = _keyFiles.find(fileName);
+          if ((it == _keyFiles.end())
+              || (it->second.modTime != keyFile.modTime)
+              || (it->second.size != keyFile.size)) {
+            toLoad.push_back({fileName, std::move(keyFile)});
+          }
+        }
+      }
+      if (ec) {
+        FSyslog(LOG_ERR, "Failed to read directory {}: {}", Path(),
+                ec.message());
+      }
+
+      vector<bool>  loaded = ReadKeyFiles(Path(), toLoad);
+
+      //  Only commit files we read successfully, so a failed read is
+      //  retried next time and the keys we had from it stay.  Don't
+      //  forget files that disappeared unless we saw the whole directory.
       std::unique_lock  lck(_keysMtx);
+      if (! ec) {
+        std::sort(fileNames.begin(), fileNames.end());
+        std::erase_if(_keyFiles, [&] (const auto & kf)
+        { return (! std::binary_search(fileNames.begin(), fileNames.end(),
+                                       kf.first)); });
+      }
+      size_t  numLoaded = 0;
+      for (size_t i = 0; i < toLoad.size(); ++i) {
+        if (loaded[i]) {
+          auto  it = _keyFiles.find(toLoad[i].first);
+          toLoad[i].second.version =
+            (it != _keyFiles.end()) ? (it->second.version + 1) : 1;
+          _keyFiles[toLoad[i].first] = std::move(toLoad[i].second);
+          ++numLoaded;
+        }
+      }
+      MergeKeyFiles();
+      FSyslog(LOG_INFO, "Loaded {} keys from {} files in {} ({} reread)",
+              _keys.size(), _keyFiles.size(), Path(), numLoaded);
+      return (! _keys.empty());
+    }
+
+    //------------------------------------------------------------------------
+    //!  Must be called with _keysMtx held exclusively.  _keyFiles is
+    //!  ordered by file name, so the first file to provide a key for a
+    //!  given ID wins.
+    //------------------------------------------------------------------------
+    void KnownKeys::MergeKeyFiles()
+    {
       _keys.clear();
-      ifstream  is(_dirName + '/' + _fileName);
+      for (const auto & kf : _keyFiles) {
+        for (const auto & key : kf.second.keys) {
+          auto  [it, inserted] = _keys.try_emplace(key.first, key.second);
+          if ((! inserted) && (it->second != key.second)) {
+            FSyslog(LOG_WARNING, "Ignoring conflicting key for {} in {}/{}",
+                    key.first, Path(), kf.first);
+          }
+        }
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool KnownKeys::ReadKeyFile(const string & path,
+                                map<string,string> & keys)
+    {
+      bool  rc = false;
+      keys.clear();
+      ifstream  is(path);
       if (is) {
         while (is) {
           Ed25519Key  pk;
           if (is >> pk) {
-            _keys[pk.Id()] = pk.Key();
+            keys[string(pk.Id())] = pk.Key();
           }
           else if (is.eof() || is.bad()) {
             break;
@@ -196,13 +406,50 @@ namespace Dwm {
             is.ignore(std::numeric_limits<std::streamsize>::max(), '\n');
           }
         }
-        FSyslog(LOG_INFO, "Loaded {} keys from {}/{}",
-                _keys.size(), _dirName, _fileName);
+        FSyslog(LOG_DEBUG, "Loaded {} keys from {}", keys.size(), path);
+        rc = true;
       }
       else {
-        FSyslog(LOG_ERR, "Failed to open {}/{}", _dirName, _fileName);
+        FSyslog(LOG_ERR, "Failed to open {}", path);
       }
-      return (! _keys.empty());
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Reads the given key files using a small pool of threads.  Each
+    //!  thread claims the next unread file until all have been read.
+    //!  Returns a flag per file, true if it was read successfully.
+    //------------------------------------------------------------------------
+    vector<bool>
+    KnownKeys::ReadKeyFiles(const string & dirPath,
+                            vector<pair<string,KeyFile>> & keyFiles)
+    {
+      //  vector<bool> packs bits, so threads can't safely write their
+      //  own elements; collect in bytes and convert at the end.
+      vector<uint8_t>  read(keyFiles.size(), 0);
+      size_t  numThreads =
+        std::min<size_t>(keyFiles.size(),
+                         std::max(1U, std::thread::hardware_concurrency()));
+      std::atomic<size_t>  next = 0;
+      auto  reader = [&] () {
+        for (size_t i = next++; i < keyFiles.size(); i = next++) {
+          read[i] = ReadKeyFile(dirPath + '/' + keyFiles[i].first,
+                                keyFiles[i].second.keys);
+        }
+      };
+      if (numThreads > 1) {
+        vector<std::thread>  threads;
+        for (size_t i = 0; i < numThreads; ++i) {
+          threads.emplace_back(reader);
+        }
+        for (auto & thr : threads) {
+          thr.join();
+        }
+      }
+      else {
+        reader();
+      }
+      return vector<bool>(read.begin(), read.end());
     }
 
   }  // namespace Credence
@@ -0,0 +1,137 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceMappedFile.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::MappedFile class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/mman.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <cerrno>
+#include <cstring>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceMappedFile.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    MappedFile::MappedFile()
+        : _data(nullptr), _size(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    MappedFile::~MappedFile()
+    {
+      Close();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool MappedFile::Open(const string & path)
+    {
+      bool  rc = false;
+      Close();
+      int  fd = open(path.c_str(), O_RDONLY);
+      if (fd >= 0) {
+        struct stat  st;
+        if (fstat(fd, &st) == 0) {
+          if (S_ISREG(st.st_mode)) {
+            if (st.st_size > 0) {
+              void  *p = mmap(nullptr, st.st_size, PROT_READ, MAP_SHARED,
+                              fd, 0);
+              if (p != MAP_FAILED) {
+                //  We read front to back, once.
+                posix_madvise(p, st.st_size, POSIX_MADV_SEQUENTIAL);
+                _data = (const uint8_t *)p;
+                _size = st.st_size;
+                rc = true;
+              }
+              else {
+                FSyslog(LOG_ERR, "mmap({}) failed: {}", path,
+                        strerror(errno));
+              }
+            }
+            else {
+              rc = true;
+            }
+          }
+          else {
+            FSyslog(LOG_ERR, "{} is not a regular file", path);
+          }
+        }
+        else {
+          FSyslog(LOG_ERR, "fstat({}) failed: {}", path, strerror(errno));
+        }
+        close(fd);
+      }
+      else {
+        FSyslog(LOG_ERR, "open({}) failed: {}", path, strerror(errno));
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void MappedFile::Close()
+    {
+      if (_data) {
+        munmap((void *)_data, _size);
+        _data = nullptr;
+      }
+      _size = 0;
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
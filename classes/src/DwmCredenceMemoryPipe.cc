@@ -0,0 +1,147 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceMemoryPipe.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::MemoryPipe class implementation
+//---------------------------------------------------------------------------
+
+#include "DwmCredenceMemoryPipe.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  The rings, owned jointly by both ends so either may go first.
+    //------------------------------------------------------------------------
+    struct MemoryPipe::Shared
+    {
+      ShmRing::Control          control[2];
+      size_t                    ringSize;
+      std::unique_ptr<char[]>   data;
+
+      Shared(size_t size)
+          : control{}, ringSize(size), data(new char[2 * size])
+      {
+        ShmRing::Initialize(&control[0]);
+        ShmRing::Initialize(&control[1]);
+      }
+    };
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void MemoryPipe::Create(std::unique_ptr<MemoryPipe> & a,
+                            std::unique_ptr<MemoryPipe> & b,
+                            size_t ringSize)
+    {
+      size_t  size = k_minRingSize;
+      while ((size < ringSize) && (size < k_maxRingSize)) {
+        size <<= 1;
+      }
+      auto  shared = make_shared<Shared>(size);
+      a.reset(new MemoryPipe(shared, 0));
+      b.reset(new MemoryPipe(shared, 1));
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  End @c outIdx writes ring @c outIdx and reads the other.
+    //------------------------------------------------------------------------
+    MemoryPipe::MemoryPipe(std::shared_ptr<Shared> shared, size_t outIdx)
+        : _shared(shared), _inRing(), _outRing(), _inBuf(_inRing),
+          _outBuf(_outRing), _is(&_inBuf), _os(&_outBuf)
+    {
+      size_t  inIdx = 1 - outIdx;
+      size_t  ringSize = _shared->ringSize;
+      _outRing.Attach(&_shared->control[outIdx],
+                      _shared->data.get() + (outIdx * ringSize),
+                      ringSize, -1);
+      _inRing.Attach(&_shared->control[inIdx],
+                     _shared->data.get() + (inIdx * ringSize),
+                     ringSize, -1);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    MemoryPipe::~MemoryPipe()
+    {
+      Close();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t MemoryPipe::RingSize() const
+    {
+      return _shared->ringSize;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void MemoryPipe::Close()
+    {
+      _os.flush();
+      _outRing.Close();
+      _inRing.Close();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void MemoryPipe::CloseReceive()
+    {
+      _inRing.Close();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool MemoryPipe::Closed() const
+    {
+      return (_inRing.Closed() && _outRing.Closed());
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
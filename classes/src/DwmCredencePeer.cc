@@ -39,7 +39,16 @@
 //!  \brief Dwm::Credence::Peer class implementation
 //---------------------------------------------------------------------------
 
+extern "C" {
+  #include <sys/socket.h>
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <cerrno>
 #include <chrono>
+#include <cstring>
+#include <sstream>
 
 #include "DwmCredenceAuthenticator.hh"
 #include "DwmCredenceKeyExchanger.hh"
@@ -56,11 +65,28 @@ namespace Dwm {
     //!  
     //------------------------------------------------------------------------
     Peer::Peer()
-        : _keyExchangeTimeout(1000), _idExchangeTimeout(1000), _endPoint(),
-          _theirId(), _agreedKey(), _ios(nullptr), _lios(nullptr),
-          _xis(nullptr), _xos(nullptr)
+        : _keyExchangeTimeout(1000), _idExchangeTimeout(1000),
+          _handshakeExecutor(nullptr), _keyPairPool(nullptr),
+          _admissionControl(nullptr),
+          _admissionTicket(), _tcpFastOpen(false),
+          _initiator(false), _plaintext(false),
+          _readBufferSize(SocketInBuffer::k_defaultBufferSize),
+          _writeBufferSize(SocketOutBuffer::k_defaultBufferSize),
+          _endPoint(), _theirId(), _agreedKey(), _ios(nullptr),
+          _lios(nullptr), _pipe(nullptr), _inBuf(nullptr), _is(nullptr),
+          _outBuf(nullptr), _os(nullptr), _shm(nullptr), _xis(nullptr),
+          _xos(nullptr),
+          _writeBehind(nullptr), _receivePump(), _stopReceivePump()
     { }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    Peer::~Peer()
+    {
+      Disconnect();
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -71,48 +97,127 @@ namespace Dwm {
     }
 
     //------------------------------------------------------------------------
-    bool Peer::Accept(boost::asio::ip::tcp::socket && s)
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::SetHandshakeExecutor(HandshakeExecutor *executor)
+    {
+      _handshakeExecutor = executor;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::SetKeyPairPool(KXKeyPairPool *keyPairPool)
+    {
+      _keyPairPool = keyPairPool;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::SetAdmissionControl(AdmissionControl *admissionControl)
+    {
+      _admissionControl = admissionControl;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::SetTcpFastOpen(bool tcpFastOpen)
+    {
+      _tcpFastOpen = tcpFastOpen;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::SetSocketBufferSizes(size_t readSize, size_t writeSize)
+    {
+      _readBufferSize = readSize;
+      _writeBufferSize = writeSize;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The key exchange goes through the socket iostream @c s, which may
+    //!  have read past the end of it, so we start our input buffer with
+    //!  whatever @c s has buffered.  @c s is not used for I/O after this;
+    //!  it just keeps the socket open.
+    //------------------------------------------------------------------------
+    bool Peer::OpenStreams(std::iostream & s, int fd)
     {
       using XChaCha20Poly1305::Istream, XChaCha20Poly1305::Ostream;
-      
+
+      string           pending;
+      std::streamsize  avail = s.rdbuf()->in_avail();
+      if (0 < avail) {
+        pending.resize(avail);
+        s.rdbuf()->sgetn(pending.data(), avail);
+      }
+      _inBuf = make_unique<SocketInBuffer>(fd, pending, _readBufferSize);
+      _is = make_unique<std::istream>(_inBuf.get());
+      _outBuf = make_unique<SocketOutBuffer>(fd, _writeBufferSize);
+      _os = make_unique<std::ostream>(_outBuf.get());
+      _xis = make_unique<Istream>(*_is, _agreedKey);
+      _xos = make_unique<Ostream>(*_os, _agreedKey);
+      return ((nullptr != _xis) && (nullptr != _xos));
+    }
+    
+    //------------------------------------------------------------------------
+    bool Peer::Accept(boost::asio::ip::tcp::socket && s)
+    {
       bool  rc = false;
-      _agreedKey.clear();
+      _agreedKey.Clear();
+      _initiator = false;
+      if (! Admit(s)) {
+        return rc;
+      }
       _ios = make_unique<boost::asio::ip::tcp::iostream>(std::move(s));
       if (nullptr != _ios) {
         boost::system::error_code  ec;
         _endPoint = _ios->socket().remote_endpoint(ec);
         if (! ec) {
           if (KeyExchanger::ExchangeKeys(*_ios, _agreedKey,
-                                         _keyExchangeTimeout)) {
-            _xis = make_unique<Istream>(*_ios, _agreedKey);
-            _xos = make_unique<Ostream>(*_ios, _agreedKey);
-            rc = ((nullptr != _xis) && (nullptr != _xos));
+                                         _keyExchangeTimeout,
+                                         _handshakeExecutor, _keyPairPool)) {
+            rc = OpenStreams(*_ios, _ios->socket().native_handle());
           }
         }
       }
+      if (! rc) {
+        _admissionTicket.Release();
+      }
       return rc;
     }
 
     //------------------------------------------------------------------------
     bool Peer::Accept(boost::asio::local::stream_protocol::socket && s)
     {
-      using XChaCha20Poly1305::Istream, XChaCha20Poly1305::Ostream;
-      
       bool  rc = false;
-      _agreedKey.clear();
+      _agreedKey.Clear();
+      _initiator = false;
+      if (! Admit(s)) {
+        return rc;
+      }
       _lios = make_unique<boost::asio::local::stream_protocol::iostream>(std::move(s));
       if (nullptr != _lios) {
         boost::system::error_code  ec;
         _lendPoint = _lios->socket().remote_endpoint(ec);
         if (! ec) {
           if (KeyExchanger::ExchangeKeys(*_lios, _agreedKey,
-                                         _keyExchangeTimeout)) {
-            _xis = make_unique<Istream>(*_lios, _agreedKey);
-            _xos = make_unique<Ostream>(*_lios, _agreedKey);
-            rc = ((nullptr != _xis) && (nullptr != _xos));
+                                         _keyExchangeTimeout,
+                                         _handshakeExecutor, _keyPairPool)) {
+            rc = OpenStreams(*_lios, _lios->socket().native_handle());
           }
         }
       }
+      if (! rc) {
+        _admissionTicket.Release();
+      }
       return rc;
     }
     
@@ -123,27 +228,29 @@ namespace Dwm {
       using namespace boost::asio;
         
       bool  rc = false;
-      _agreedKey.clear();
+      _agreedKey.Clear();
+      _initiator = true;
       if (nullptr == _ios) {
         _ios = make_unique<ip::tcp::iostream>();
         if (nullptr != _ios) {
-          _ios->expires_after(timeOut);
-          try {
-            _ios->connect(host, to_string(port));
-          }
-          catch (...) {
-            _ios = nullptr;
-            return rc;
+          boost::system::error_code  ec;
+          if ((! _tcpFastOpen) || (! ConnectFastOpen(host, port))) {
+            _ios->expires_after(timeOut);
+            try {
+              _ios->connect(host, to_string(port));
+            }
+            catch (...) {
+              _ios = nullptr;
+              return rc;
+            }
+            _endPoint = _ios->socket().remote_endpoint(ec);
           }
           _ios->expires_after(std::chrono::milliseconds(60000));
-          boost::system::error_code  ec;
-          _endPoint = _ios->socket().remote_endpoint(ec);
           if (! ec) {
             if (KeyExchanger::ExchangeKeys(*_ios, _agreedKey,
-                                           _keyExchangeTimeout)) {
-              _xis = make_unique<XChaCha20Poly1305::Istream>(*_ios, _agreedKey);
-              _xos = make_unique<XChaCha20Poly1305::Ostream>(*_ios, _agreedKey);
-              rc = ((nullptr != _xis) && (nullptr != _xos));
+                                           _keyExchangeTimeout,
+                                           _handshakeExecutor, _keyPairPool)) {
+              rc = OpenStreams(*_ios, _ios->socket().native_handle());
             }
           }
         }
@@ -151,13 +258,56 @@ namespace Dwm {
       return rc;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::ConnectFastOpen(const string & host, uint16_t port)
+    {
+      using namespace boost::asio;
+
+      bool  rc = false;
+      boost::system::error_code  ec;
+      ip::tcp::resolver  resolver(_ios->socket().get_executor());
+      auto  endPoints = resolver.resolve(host, to_string(port), ec);
+      if (! ec) {
+        auto  & sck = _ios->socket();
+        for (const auto & entry : endPoints) {
+          sck.open(entry.endpoint().protocol(), ec);
+          if (! ec) {
+            //  connect() returns right away; the SYN goes out with our
+            //  public key when ExchangeKeys() writes it, and any error
+            //  connecting will surface there.
+            if (Utils::EnableTcpFastOpenConnect(sck)) {
+              sck.connect(entry.endpoint(), ec);
+              if (! ec) {
+                _endPoint = entry.endpoint();
+                rc = true;
+                break;
+              }
+            }
+            else {
+              sck.close(ec);
+              break;
+            }
+          }
+          sck.close(ec);
+        }
+      }
+      if (! rc) {
+        FSyslog(LOG_DEBUG, "TCP Fast Open to {}:{} not possible, using"
+                " normal connect", host, port);
+      }
+      return rc;
+    }
+    
     //------------------------------------------------------------------------
     bool Peer::Connect(const string & path, std::chrono::milliseconds timeOut)
     {
       using namespace boost::asio;
         
       bool  rc = false;
-      _agreedKey.clear();
+      _agreedKey.Clear();
+      _initiator = true;
       if (nullptr == _lios) {
         _lios = make_unique<local::stream_protocol::iostream>();
         if (nullptr != _lios) {
@@ -174,24 +324,73 @@ namespace Dwm {
           _lendPoint = _lios->socket().remote_endpoint(ec);
           if (! ec) {
             if (KeyExchanger::ExchangeKeys(*_lios, _agreedKey,
-                                           _keyExchangeTimeout)) {
-              _xis = make_unique<XChaCha20Poly1305::Istream>(*_lios, _agreedKey);
-              _xos = make_unique<XChaCha20Poly1305::Ostream>(*_lios, _agreedKey);
-              rc = ((nullptr != _xis) && (nullptr != _xos));
+                                           _keyExchangeTimeout,
+                                           _handshakeExecutor, _keyPairPool)) {
+              rc = OpenStreams(*_lios, _lios->socket().native_handle());
             }
           }
         }
       }
       return rc;
     }
+
+    //------------------------------------------------------------------------
+    bool Peer::Accept(std::unique_ptr<MemoryPipe> && pipe)
+    {
+      _agreedKey.Clear();
+      _initiator = false;
+      return OpenPipe(std::move(pipe));
+    }
+
+    //------------------------------------------------------------------------
+    bool Peer::Connect(std::unique_ptr<MemoryPipe> && pipe)
+    {
+      _agreedKey.Clear();
+      _initiator = true;
+      return OpenPipe(std::move(pipe));
+    }
+
+    //------------------------------------------------------------------------
+    //!  The pipe's streams need no buffers of ours; the encrypted
+    //!  streams sit right on top of them.
+    //------------------------------------------------------------------------
+    bool Peer::OpenPipe(std::unique_ptr<MemoryPipe> && pipe)
+    {
+      using XChaCha20Poly1305::Istream, XChaCha20Poly1305::Ostream;
+
+      bool  rc = false;
+      if ((nullptr == pipe) || _pipe || _ios || _lios) {
+        return rc;
+      }
+      _pipe = std::move(pipe);
+      if (KeyExchanger::ExchangeKeys(*_pipe, _agreedKey, _keyExchangeTimeout,
+                                     _handshakeExecutor, _keyPairPool)) {
+        _xis = make_unique<Istream>(_pipe->In(), _agreedKey);
+        _xos = make_unique<Ostream>(_pipe->Out(), _agreedKey);
+        rc = ((nullptr != _xis) && (nullptr != _xos));
+      }
+      return rc;
+    }
     
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     void Peer::Disconnect()
     {
+      StopReceivePump();
+      if (_writeBehind) {
+        //  Don't wait for a slow receiver; fail whatever is still queued.
+        Shutdown();
+        _writeBehind->Stop(false);
+        _writeBehind = nullptr;
+      }
       _xos = nullptr;
       _xis = nullptr;
+      _shm = nullptr;
+      _os = nullptr;
+      _outBuf = nullptr;
+      _is = nullptr;
+      _inBuf = nullptr;
       if (_ios) {
         _ios->close();
         _ios = nullptr;
@@ -200,10 +399,99 @@ namespace Dwm {
         _lios->close();
         _lios = nullptr;
       }
-      _agreedKey.clear();
+      if (_pipe) {
+        _pipe->Close();
+        _pipe = nullptr;
+      }
+      _plaintext = false;
+      _agreedKey.Clear();
+      _admissionTicket.Release();
       return;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::Shutdown()
+    {
+      if (_shm) {
+        _shm->Close();
+      }
+      if (_pipe) {
+        _pipe->Close();
+      }
+      boost::system::error_code  ec;
+      if (_ios) {
+        _ios->socket().shutdown(boost::asio::socket_base::shutdown_both, ec);
+      }
+      if (_lios) {
+        _lios->socket().shutdown(boost::asio::socket_base::shutdown_both,
+                                 ec);
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The socket iostream is kept (shared by @c reader and @c writer)
+    //!  only to keep the socket open.  Our socket buffers already work
+    //!  on the raw descriptor, one per direction, so the reader and
+    //!  writer simply take them over along with the encrypted streams
+    //!  that wrap them.
+    //------------------------------------------------------------------------
+    bool Peer::Split(PeerReader & reader, PeerWriter & writer)
+    {
+      bool  rc = false;
+      if (_pipe) {
+        Syslog(LOG_ERR, "Split() called on memory pipe Peer");
+        return rc;
+      }
+      if ((! _xis) || (! _xos) || ((! _ios) && (! _lios))) {
+        Syslog(LOG_ERR, "Split() called on unconnected Peer");
+        return rc;
+      }
+      if (_receivePump.joinable()) {
+        Syslog(LOG_ERR, "Split() called with receive pump running");
+        return rc;
+      }
+      if (_shm) {
+        Syslog(LOG_ERR, "Split() called in shared memory mode");
+        return rc;
+      }
+      DisableWriteBehind();
+      int  fd = _ios ? _ios->socket().native_handle()
+                     : _lios->socket().native_handle();
+      if (! _xos->flush()) {
+        FSyslog(LOG_ERR, "Failed to flush encrypted stream to {}",
+                EndPointString());
+        return rc;
+      }
+      
+      PeerReader  rd;
+      PeerWriter  wr;
+      if (_ios) {
+        rd._socket = std::move(_ios);
+      }
+      else {
+        rd._socket = std::move(_lios);
+      }
+      wr._socket = rd._socket;
+      rd._fd = wr._fd = fd;
+      rd._theirId = wr._theirId = _theirId;
+      rd._endPoint = wr._endPoint = EndPointString();
+      rd._buf = std::move(_inBuf);
+      rd._is = std::move(_is);
+      rd._xis = std::move(_xis);
+      wr._buf = std::move(_outBuf);
+      wr._os = std::move(_os);
+      wr._xos = std::move(_xos);
+      
+      reader = std::move(rd);
+      writer = std::move(wr);
+      Disconnect();
+      rc = true;
+      return rc;
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -218,22 +506,279 @@ namespace Dwm {
     //------------------------------------------------------------------------
     bool Peer::Authenticate(const KeyStash & keyStash,
                             const KnownKeys & knownKeys)
+    {
+      Authenticator  authenticator(keyStash, knownKeys);
+      return Authenticate(authenticator);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::Authenticate(const KeyStash & keyStash,
+                            const KnownKeys & knownKeys,
+                            const KeyAuthorities & authorities)
+    {
+      Authenticator  authenticator(keyStash, knownKeys, authorities);
+      return Authenticate(authenticator);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::Authenticate(Authenticator & authenticator)
     {
       bool  rc = false;
       _theirId.clear();
-      if (_ios) {
-        Authenticator  authenticator(keyStash, knownKeys);
-        authenticator.SetIdExchangeTimeout(_idExchangeTimeout);
-        if (authenticator.Authenticate(*_ios, _agreedKey, _theirId)) {
-          rc = true;
+      if (_xis && _xos) {
+        if (_ios) {
+          rc = authenticator.Authenticate(*_ios, *_xis, *_xos, _theirId,
+                                          _idExchangeTimeout,
+                                          _handshakeExecutor);
+        }
+        else if (_lios) {
+          rc = authenticator.Authenticate(*_lios, *_xis, *_xos, _theirId,
+                                          _idExchangeTimeout,
+                                          _handshakeExecutor);
+        }
+        else if (_pipe) {
+          rc = authenticator.Authenticate(*_pipe, *_xis, *_xos, _theirId,
+                                          _idExchangeTimeout,
+                                          _handshakeExecutor);
+        }
+      }
+      _admissionTicket.Release();
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::EnableWriteBehind(const WriteBehindQueue::Config & config)
+    {
+      bool  rc = false;
+      if (_writeBehind) {
+        rc = true;
+      }
+      else if (_xos) {
+        _writeBehind = make_unique<WriteBehindQueue>(*_xos, config,
+                                                     EndPointString());
+        rc = true;
+      }
+      else {
+        Syslog(LOG_ERR, "EnableWriteBehind() called on unconnected Peer");
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::DisableWriteBehind()
+    {
+      if (_writeBehind) {
+        _writeBehind->Stop(true);
+        _writeBehind = nullptr;
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    WriteBehindQueue::Counters Peer::WriteBehindStats() const
+    {
+      return (_writeBehind ? _writeBehind->Stats()
+              : WriteBehindQueue::Counters());
+    }
+
+    //------------------------------------------------------------------------
+    //!  The exchange, over the encrypted socket streams:
+    //!
+    //!    initiator: ring size (0 to decline)
+    //!    responder: ready (0 to decline); nothing more is read from the
+    //!               socket through our buffer after this
+    //!    initiator: one byte carrying the memfd (SCM_RIGHTS), raw
+    //!    responder: attached (1)
+    //!
+    //!  Once the responder says it's ready, a failure leaves us unsure
+    //!  where the other side is in the socket byte stream, so we
+    //!  disconnect rather than carry on.
+    //------------------------------------------------------------------------
+    bool Peer::EnableSharedMemory(size_t ringSize)
+    {
+      bool  rc = false;
+      if (_shm) {
+        return true;
+      }
+      if ((! _lios) || (! _xis) || (! _xos)) {
+        Syslog(LOG_ERR, "EnableSharedMemory() called without a UNIX"
+               " domain socket connection");
+        return rc;
+      }
+      bool  able = ((! _writeBehind) && (! _receivePump.joinable()));
+      int   sock = _lios->socket().native_handle();
+      auto  shm = make_unique<ShmChannel>();
+      if (_initiator) {
+        uint64_t  offer = 0;
+        if (able && shm->Create(ringSize)) {
+          offer = shm->RingSize();
+        }
+        if ((! Send(offer)) || (0 == offer)) {
+          return rc;
+        }
+        uint8_t  ready = 0;
+        if ((! Receive(ready)) || (! ready)) {
+          return rc;
+        }
+        uint8_t  attached = 0;
+        if ((! shm->SendDescriptor(sock)) || (! Receive(attached))
+            || (! attached)) {
+          FSyslog(LOG_ERR, "Shared memory setup with {} failed",
+                  EndPointString());
+          Disconnect();
+          return rc;
+        }
+        shm->Open(true, sock);
+      }
+      else {
+        uint64_t  offer = 0;
+        if ((! Receive(offer)) || (0 == offer)) {
+          return rc;
+        }
+        uint8_t  ready = (able && ShmChannel::Supported()
+                          && (0 == _inBuf->Buffered())
+                          && (0 >= _xis->rdbuf()->in_avail()));
+        if ((! Send(ready)) || (! ready)) {
+          return rc;
+        }
+        if (! shm->ReceiveDescriptor(sock, offer, _idExchangeTimeout)) {
+          FSyslog(LOG_ERR, "Shared memory setup with {} failed",
+                  EndPointString());
+          Disconnect();
+          return rc;
+        }
+        shm->Open(false, sock);
+        if (! Send((uint8_t)1)) {
+          Disconnect();
+          return rc;
+        }
+      }
+      _xos->Rebind(shm->Out());
+      _xis->Rebind(shm->In());
+      _shm = std::move(shm);
+      rc = true;
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::PeerCredentials(Credentials & creds) const
+    {
+      bool  rc = false;
+      if (_pipe) {
+        creds.pid = getpid();
+        creds.uid = geteuid();
+        creds.gid = getegid();
+        return true;
+      }
+      if (! _lios) {
+        return rc;
+      }
+      int  fd = _lios->socket().native_handle();
+#if defined(SO_PEERCRED) && defined(__linux__)
+      struct ucred  uc;
+      socklen_t     len = sizeof(uc);
+      if (0 == getsockopt(fd, SOL_SOCKET, SO_PEERCRED, &uc, &len)) {
+        creds.pid = uc.pid;
+        creds.uid = uc.uid;
+        creds.gid = uc.gid;
+        rc = true;
+      }
+#else
+      uid_t  uid;
+      gid_t  gid;
+      if (0 == getpeereid(fd, &uid, &gid)) {
+        creds.pid = -1;
+        creds.uid = uid;
+        creds.gid = gid;
+        rc = true;
+      }
+#endif
+      if (! rc) {
+        FSyslog(LOG_ERR, "Failed to get credentials of {}: {}",
+                EndPointString(), strerror(errno));
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Both sides send their answer (encrypted) before reading the
+    //!  other's, then switch both directions if both said yes.  Neither
+    //!  side sends anything else until it has the other's answer, so the
+    //!  first plaintext frame in each direction follows the answer.
+    //------------------------------------------------------------------------
+    bool Peer::EnablePlaintext(const CredentialCheck & check)
+    {
+      bool  rc = false;
+      if (_plaintext) {
+        return true;
+      }
+      if ((! _xis) || (! _xos)) {
+        Syslog(LOG_ERR, "EnablePlaintext() called on unconnected Peer");
+        return rc;
+      }
+      if (_receivePump.joinable()) {
+        Syslog(LOG_ERR, "EnablePlaintext() called with receive pump"
+               " running");
+        return rc;
+      }
+      uint8_t      willing = 0;
+      Credentials  creds;
+      if ((_lios || _pipe) && (! _theirId.empty()) && (! _writeBehind)
+          && PeerCredentials(creds)) {
+        willing = check ? check(creds) : (creds.uid == geteuid());
+        if (! willing) {
+          FSyslog(LOG_INFO, "Declined plaintext with {} (pid {} uid {}"
+                  " gid {})", EndPointString(), creds.pid, creds.uid,
+                  creds.gid);
         }
       }
-      else if (_lios) {
-        Authenticator  authenticator(keyStash, knownKeys);
-        authenticator.SetIdExchangeTimeout(_idExchangeTimeout);
-        if (authenticator.Authenticate(*_lios, _agreedKey, _theirId)) {
-          rc = true;
+      uint8_t  theirs = 0;
+      if (Send(willing) && Receive(theirs) && willing && (1 == theirs)) {
+        _xos->SetPlaintext(true);
+        _xis->SetPlaintext(true);
+        _plaintext = true;
+        rc = true;
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::SendSerialized(std::string_view msg, bool flush)
+    {
+      bool  rc = false;
+      if (_writeBehind) {
+        return _writeBehind->Push(string(msg)).get();
+      }
+      if (_xos) {
+        if (_xos->write(msg.data(), msg.size())) {
+          if ((! flush) || _xos->flush()) {
+            rc = true;
+          }
+          else {
+            FSyslog(LOG_ERR, "Failed to flush encrypted stream to {}",
+                    EndPointString());
+          }
         }
+        else {
+          FSyslog(LOG_ERR, "Failed to send message to {}", EndPointString());
+        }
+      }
+      else {
+        Syslog(LOG_ERR, "Invalid encrypted output stream");
       }
       return rc;
     }
@@ -241,16 +786,153 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Peer::ReceiveWouldBlock(size_t numBytes)
+    bool Peer::SendStream(std::istream & is, uint64_t size)
     {
-      if (_ios) {
-        ssize_t  bytesReady = Utils::BytesReady(_ios->socket());
-        if ((0 <= bytesReady) && (bytesReady < numBytes)) {
-          return true;
+      return SendChunks(size, [&] (char *buf, size_t len) -> ssize_t {
+        is.read(buf, len);
+        return is.gcount();
+      });
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::SendStream(int fd, uint64_t size, off_t offset, bool dropCache)
+    {
+#if defined(POSIX_FADV_SEQUENTIAL)
+      posix_fadvise(fd, offset, size, POSIX_FADV_SEQUENTIAL);
+#endif
+      return SendChunks(size, [&] (char *buf, size_t len) -> ssize_t {
+        ssize_t  rc;
+        do {
+          rc = pread(fd, buf, len, offset);
+        } while ((rc < 0) && (EINTR == errno));
+        if (rc > 0) {
+#if defined(POSIX_FADV_DONTNEED)
+          if (dropCache) {
+            posix_fadvise(fd, offset, rc, POSIX_FADV_DONTNEED);
+          }
+#endif
+          offset += rc;
         }
+        return rc;
+      });
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::ReceiveStream(std::ostream & os, uint64_t *size)
+    {
+      return ReceiveChunks([&] (const string & chunk) {
+        return (os.write(chunk.data(), chunk.size()) ? true : false);
+      }, size);
+    }
+
+    //------------------------------------------------------------------------
+    //!  Clean pages can be dropped right away, but written pages are
+    //!  dirty until they reach the disk.  On Linux, with @c dropCache we
+    //!  start writeback of each k_dropInterval window as it fills and
+    //!  drop the window before it, whose writeback has had a window's
+    //!  worth of time to finish, so we rarely wait on the disk.
+    //!  Elsewhere we fdatasync() and drop every window, which stalls the
+    //!  receive for each flush.  Skipped if @c fd isn't seekable.
+    //------------------------------------------------------------------------
+    bool Peer::ReceiveStream(int fd, uint64_t *size, bool dropCache)
+    {
+      static constexpr uint64_t  k_dropInterval = 8 * 1024 * 1024;
+      off_t     start = dropCache ? lseek(fd, 0, SEEK_CUR) : -1;
+      uint64_t  written = 0;
+      uint64_t  flushed = 0;
+      uint64_t  dropped = 0;
+      return ReceiveChunks([&] (const string & chunk) {
+        const char  *p = chunk.data();
+        size_t       remaining = chunk.size();
+        while (remaining) {
+          ssize_t  rc = write(fd, p, remaining);
+          if (rc < 0) {
+            if (EINTR == errno) {
+              continue;
+            }
+            FSyslog(LOG_ERR, "write({}) failed: {}", fd, strerror(errno));
+            return false;
+          }
+          p += rc;
+          remaining -= rc;
+        }
+        written += chunk.size();
+#if defined(__linux__) && defined(SYNC_FILE_RANGE_WRITE)
+        if ((0 <= start) && ((written - flushed) >= k_dropInterval)) {
+          sync_file_range(fd, start + flushed, written - flushed,
+                          SYNC_FILE_RANGE_WRITE);
+          if (flushed > dropped) {
+            sync_file_range(fd, start + dropped, flushed - dropped,
+                            SYNC_FILE_RANGE_WAIT_BEFORE
+                            | SYNC_FILE_RANGE_WRITE
+                            | SYNC_FILE_RANGE_WAIT_AFTER);
+            posix_fadvise(fd, start + dropped, flushed - dropped,
+                          POSIX_FADV_DONTNEED);
+            dropped = flushed;
+          }
+          flushed = written;
+        }
+#elif defined(POSIX_FADV_DONTNEED)
+        if ((0 <= start) && ((written - dropped) >= k_dropInterval)) {
+          fdatasync(fd);
+          posix_fadvise(fd, start + dropped, written - dropped,
+                        POSIX_FADV_DONTNEED);
+          dropped = written;
+        }
+#endif
+        return true;
+      }, size);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void Peer::StopReceivePump()
+    {
+      if (_receivePump.joinable()) {
+        _stopReceivePump();
+        if (_pipe) {
+          _pipe->CloseReceive();
+        }
+        if (_shm) {
+          _shm->CloseReceive();
+        }
+        boost::system::error_code  ec;
+        if (_ios) {
+          _ios->socket().shutdown(boost::asio::socket_base::shutdown_receive,
+                                  ec);
+        }
+        if (_lios) {
+          _lios->socket().shutdown(boost::asio::socket_base::shutdown_receive,
+                                   ec);
+        }
+        _receivePump.join();
+        _stopReceivePump = nullptr;
       }
-      else if (_lios) {
-        ssize_t  bytesReady = Utils::BytesReady(_lios->socket());
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::ReceiveWouldBlock(size_t numBytes)
+    {
+      if (_xis && (0 < _xis->rdbuf()->in_avail())) {
+        //  Already decrypted, but not yet received.
+        return false;
+      }
+      if (_shm) {
+        return (_shm->BytesReady() < numBytes);
+      }
+      if (_pipe) {
+        return (_pipe->BytesReady() < numBytes);
+      }
+      if (_inBuf) {
+        ssize_t  bytesReady = _inBuf->BytesReady();
         if ((0 <= bytesReady) && (bytesReady < numBytes)) {
           return true;
         }
@@ -258,13 +940,174 @@ namespace Dwm {
       return false;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::IsConnected()
+    {
+      bool  rc = false;
+      if (_xis && _xos) {
+        if (_ios) {
+          rc = Utils::IsConnected(_ios->socket());
+        }
+        else if (_lios) {
+          rc = Utils::IsConnected(_lios->socket());
+        }
+        else if (_pipe) {
+          rc = (! _pipe->Closed());
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The size goes first, then the data in chunks of up to
+    //!  k_streamChunkSize.  Each chunk is its length followed by the raw
+    //!  bytes, so the receiver can check the length before reading the
+    //!  data.  Data chunks are never empty, so an empty chunk tells the
+    //!  receiver we couldn't read everything.  @c read returns the number
+    //!  of bytes read, 0 at end of input or -1 on error.
+    //------------------------------------------------------------------------
+    bool Peer::SendChunks(uint64_t size,
+                          const function<ssize_t(char *,size_t)> & read)
+    {
+      if (! Send(size)) {
+        return false;
+      }
+      string    chunk;
+      uint64_t  remaining = size;
+      while (remaining) {
+        chunk.resize(std::min(remaining, (uint64_t)k_streamChunkSize));
+        size_t  len = 0;
+        while (len < chunk.size()) {
+          ssize_t  rc = read(chunk.data() + len, chunk.size() - len);
+          if (rc <= 0) {
+            break;
+          }
+          len += rc;
+        }
+        if (len < chunk.size()) {
+          FSyslog(LOG_ERR, "Stream to {} ended early at {} of {} bytes",
+                  EndPointString(), (size - remaining) + len, size);
+          Send(uint64_t(0));
+          return false;
+        }
+        ostringstream  hdr;
+        StreamIO::Write(hdr, (uint64_t)len);
+        if (! (SendSerialized(hdr.str(), false)
+               && SendSerialized(chunk, true))) {
+          return false;
+        }
+        remaining -= len;
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  If @c write fails, we keep receiving (and discarding) so the
+    //!  connection stays in step with the sender.  A chunk longer than
+    //!  k_streamChunkSize is refused before we read or allocate for it.
+    //------------------------------------------------------------------------
+    bool Peer::ReceiveChunks(const function<bool(const string &)> & write,
+                             uint64_t *size)
+    {
+      uint64_t  streamSize;
+      if (! Receive(streamSize)) {
+        return false;
+      }
+      if (nullptr != size) {
+        *size = streamSize;
+      }
+      bool      rc = true;
+      string    chunk;
+      uint64_t  remaining = streamSize;
+      while (remaining) {
+        uint64_t  len;
+        if (! Receive(len)) {
+          return false;
+        }
+        if (0 == len) {
+          FSyslog(LOG_ERR, "{} aborted stream at {} of {} bytes",
+                  EndPointString(), streamSize - remaining, streamSize);
+          return false;
+        }
+        if ((len > k_streamChunkSize) || (len > remaining)) {
+          FSyslog(LOG_ERR, "Stream chunk of {} bytes from {} is too long",
+                  len, EndPointString());
+          Disconnect();
+          return false;
+        }
+        chunk.resize(len);
+        if (! _xis->read(chunk.data(), len)) {
+          FSyslog(LOG_ERR, "Failed to read stream chunk from {}",
+                  EndPointString());
+          return false;
+        }
+        if (rc && (! write(chunk))) {
+          rc = false;
+        }
+        remaining -= chunk.size();
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Rejections are logged at LOG_DEBUG, since under a connection storm
+    //!  logging each one would be a cost of its own.
+    //------------------------------------------------------------------------
+    bool Peer::Admit(boost::asio::ip::tcp::socket & s)
+    {
+      bool  rc = true;
+      if (nullptr != _admissionControl) {
+        using Verdict = AdmissionControl::Verdict;
+        boost::system::error_code  ec;
+        auto     remote = s.remote_endpoint(ec);
+        Verdict  verdict = Verdict::e_notAllowed;
+        if (! ec) {
+          verdict = _admissionControl->Admit(remote.address(),
+                                             _admissionTicket);
+        }
+        if (Verdict::e_admitted != verdict) {
+          FSyslog(LOG_DEBUG, "Rejected connection from {}: {}",
+                  Utils::EndPointString(remote),
+                  AdmissionControl::VerdictString(verdict));
+          s.close(ec);
+          rc = false;
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Peer::Admit(boost::asio::local::stream_protocol::socket & s)
+    {
+      bool  rc = true;
+      if (nullptr != _admissionControl) {
+        using Verdict = AdmissionControl::Verdict;
+        Verdict  verdict = _admissionControl->Admit(_admissionTicket);
+        if (Verdict::e_admitted != verdict) {
+          FSyslog(LOG_DEBUG, "Rejected UNIX domain connection: {}",
+                  AdmissionControl::VerdictString(verdict));
+          boost::system::error_code  ec;
+          s.close(ec);
+          rc = false;
+        }
+      }
+      return rc;
+    }
+    
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
     std::string Peer::EndPointString() const
     {
       std::string  rc;
-      if (_endPoint.data()) {
+      if (_pipe) {
+        rc = "memory pipe";
+      }
+      else if (_endPoint.data()) {
         rc = Utils::EndPointString(_endPoint);
       }
       else if (_lendPoint.data()) {
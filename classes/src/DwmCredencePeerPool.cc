@@ -0,0 +1,497 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerPool.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerPool class implementation
+//---------------------------------------------------------------------------
+
+#include <algorithm>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredencePeerPool.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::Lease::Lease(Lease && lease) noexcept
+        : _pool(lease._pool), _key(std::move(lease._key)),
+          _peer(std::move(lease._peer)), _created(lease._created),
+          _reused(lease._reused)
+    {
+      lease._pool = nullptr;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::Lease & PeerPool::Lease::operator = (Lease && lease) noexcept
+    {
+      if (&lease != this) {
+        Return();
+        _pool = lease._pool;
+        _key = std::move(lease._key);
+        _peer = std::move(lease._peer);
+        _created = lease._created;
+        _reused = lease._reused;
+        lease._pool = nullptr;
+      }
+      return *this;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::Lease::Return()
+    {
+      if (_peer) {
+        if (nullptr != _pool) {
+          _pool->Return(_key, std::move(_peer), _created);
+        }
+        else {
+          Discard();
+        }
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::Lease::Discard()
+    {
+      if (_peer) {
+        _peer->Disconnect();
+        _peer = nullptr;
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::PeerPool(const KeyStash & keyStash, const KnownKeys & knownKeys,
+                       size_t maxIdle, std::chrono::milliseconds idleTimeout)
+        : _maxIdle(maxIdle), _idleTimeout(idleTimeout),
+          _authenticator(keyStash, knownKeys), _mtx(), _idle(),
+          _connectTimeout(5000), _tcpFastOpen(false),
+          _handshakeExecutor(nullptr), _keyPairPool(nullptr), _counters()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::~PeerPool()
+    {
+      Clear();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::SetConnectTimeout(std::chrono::milliseconds ms)
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _connectTimeout = ms;
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::SetTcpFastOpen(bool tcpFastOpen)
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _tcpFastOpen = tcpFastOpen;
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::SetHandshakeExecutor(HandshakeExecutor *executor)
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _handshakeExecutor = executor;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::SetKeyPairPool(KXKeyPairPool *keyPairPool)
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _keyPairPool = keyPairPool;
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::Lease PeerPool::Get(const string & host, uint16_t port,
+                                  const string & expectedId)
+    {
+      string  key = Key(host, port, expectedId);
+      Lease   lease = GetIdle(key);
+      if (! lease) {
+        lease._peer = NewPeer(host, port, expectedId);
+        if (lease._peer) {
+          lease._pool = this;
+          lease._key = std::move(key);
+          lease._created = Clock::now();
+        }
+      }
+      return lease;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::Lease PeerPool::Get(const string & path,
+                                  const string & expectedId)
+    {
+      string  key = Key(path, expectedId);
+      Lease   lease = GetIdle(key);
+      if (! lease) {
+        lease._peer = NewPeer(path, 0, expectedId);
+        if (lease._peer) {
+          lease._pool = this;
+          lease._key = std::move(key);
+          lease._created = Clock::now();
+        }
+      }
+      return lease;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PeerPool::Prewarm(const string & host, uint16_t port,
+                             const string & expectedId, size_t count)
+    {
+      return Fill(Key(host, port, expectedId), host, port, expectedId,
+                  count);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PeerPool::Prewarm(const string & path, const string & expectedId,
+                             size_t count)
+    {
+      return Fill(Key(path, expectedId), path, 0, expectedId, count);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::Prune()
+    {
+      vector<unique_ptr<Peer>>  expired;
+      {
+        lock_guard<mutex>  lck(_mtx);
+        auto  oldest = Clock::now() - _idleTimeout;
+        for (auto it = _idle.begin(); it != _idle.end(); ) {
+          auto  & idlePeers = it->second;
+          while ((! idlePeers.empty())
+                 && (idlePeers.front().lastUsed < oldest)) {
+            expired.push_back(std::move(idlePeers.front().peer));
+            idlePeers.pop_front();
+            ++_counters.expired;
+          }
+          if (idlePeers.empty()) {
+            it = _idle.erase(it);
+          }
+          else {
+            ++it;
+          }
+        }
+      }
+      //  Disconnect outside the lock.
+      for (auto & peer : expired) {
+        peer->Disconnect();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerPool::Clear()
+    {
+      IdleMap  idle;
+      {
+        lock_guard<mutex>  lck(_mtx);
+        idle.swap(_idle);
+      }
+      for (auto & dest : idle) {
+        for (auto & idlePeer : dest.second) {
+          idlePeer.peer->Disconnect();
+        }
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PeerPool::NumIdle() const
+    {
+      size_t  rc = 0;
+      lock_guard<mutex>  lck(_mtx);
+      for (const auto & dest : _idle) {
+        rc += dest.second.size();
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerPool::Counters PeerPool::Stats() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _counters;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string PeerPool::Key(const string & host, uint16_t port,
+                         const string & expectedId)
+    {
+      return ("tcp:" + host + ':' + to_string(port) + '/' + expectedId);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string PeerPool::Key(const string & path, const string & expectedId)
+    {
+      return ("unix:" + path + '/' + expectedId);
+    }
+
+    //------------------------------------------------------------------------
+    //!  Idle Peers are kept oldest-use first, so we reuse from the back
+    //!  (the most recently used, least likely to have been closed by the
+    //!  server) and expire from the front.  Checking a candidate takes
+    //!  system calls, so we take it out of _idle and check it without
+    //!  holding _mtx.
+    //------------------------------------------------------------------------
+    PeerPool::Lease PeerPool::GetIdle(const string & key)
+    {
+      Lease  lease;
+      for (;;) {
+        IdlePeer                  idlePeer;
+        vector<unique_ptr<Peer>>  dead;
+        {
+          lock_guard<mutex>  lck(_mtx);
+          auto  it = _idle.find(key);
+          if (it != _idle.end()) {
+            auto  & idlePeers = it->second;
+            auto  oldest = Clock::now() - _idleTimeout;
+            while ((! idlePeers.empty())
+                   && (idlePeers.front().lastUsed < oldest)) {
+              dead.push_back(std::move(idlePeers.front().peer));
+              idlePeers.pop_front();
+              ++_counters.expired;
+            }
+            if (! idlePeers.empty()) {
+              idlePeer = std::move(idlePeers.back());
+              idlePeers.pop_back();
+            }
+            if (idlePeers.empty()) {
+              _idle.erase(it);
+            }
+          }
+          if (! idlePeer.peer) {
+            ++_counters.misses;
+          }
+        }
+        for (auto & peer : dead) {
+          peer->Disconnect();
+        }
+        if (! idlePeer.peer) {
+          break;
+        }
+        //  Anything to read on an idle connection means the server
+        //  closed it or we're out of step with it.
+        if (idlePeer.peer->IsConnected()
+            && idlePeer.peer->ReceiveWouldBlock(1)) {
+          auto  age = chrono::duration_cast<chrono::milliseconds>
+            (Clock::now() - idlePeer.created);
+          {
+            lock_guard<mutex>  lck(_mtx);
+            ++_counters.hits;
+            _counters.totalReusedAge += age;
+            _counters.maxReusedAge = max(_counters.maxReusedAge, age);
+          }
+          lease._pool = this;
+          lease._key = key;
+          lease._peer = std::move(idlePeer.peer);
+          lease._created = idlePeer.created;
+          lease._reused = true;
+          break;
+        }
+        idlePeer.peer->Disconnect();
+        lock_guard<mutex>  lck(_mtx);
+        ++_counters.stale;
+      }
+      return lease;
+    }
+
+    //------------------------------------------------------------------------
+    //!  A @c port of 0 means @c hostOrPath is a UNIX domain socket path.
+    //------------------------------------------------------------------------
+    unique_ptr<Peer> PeerPool::NewPeer(const string & hostOrPath,
+                                       uint16_t port,
+                                       const string & expectedId)
+    {
+      std::chrono::milliseconds  connectTimeout;
+      bool                       tcpFastOpen;
+      HandshakeExecutor         *executor;
+      KXKeyPairPool             *keyPairPool;
+      {
+        lock_guard<mutex>  lck(_mtx);
+        connectTimeout = _connectTimeout;
+        tcpFastOpen = _tcpFastOpen;
+        executor = _handshakeExecutor;
+        keyPairPool = _keyPairPool;
+      }
+      
+      auto  peer = make_unique<Peer>();
+      peer->SetTcpFastOpen(tcpFastOpen);
+      peer->SetHandshakeExecutor(executor);
+      peer->SetKeyPairPool(keyPairPool);
+      bool  connected = (port ? peer->Connect(hostOrPath, port, connectTimeout)
+                         : peer->Connect(hostOrPath, connectTimeout));
+      if (connected) {
+        if (Authenticate(*peer)) {
+          if (expectedId.empty() || (peer->Id() == expectedId)) {
+            return peer;
+          }
+          FSyslog(LOG_ERR, "Peer at {} authenticated as {}, expected {}",
+                  peer->EndPointString(), peer->Id(), expectedId);
+        }
+        peer->Disconnect();
+      }
+      lock_guard<mutex>  lck(_mtx);
+      ++_counters.connectFailures;
+      return nullptr;
+    }
+
+    //------------------------------------------------------------------------
+    //!  One Authenticator serves concurrent handshakes, so our identity
+    //!  is only loaded from the KeyStash once.
+    //------------------------------------------------------------------------
+    bool PeerPool::Authenticate(Peer & peer)
+    {
+      return peer.Authenticate(_authenticator);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PeerPool::Fill(const string & key, const string & hostOrPath,
+                          uint16_t port, const string & expectedId,
+                          size_t count)
+    {
+      {
+        lock_guard<mutex>  lck(_mtx);
+        auto  it = _idle.find(key);
+        size_t  numIdle = ((it != _idle.end()) ? it->second.size() : 0);
+        count = min(count, (_maxIdle > numIdle) ? (_maxIdle - numIdle) : 0);
+      }
+      vector<unique_ptr<Peer>>  peers(count);
+      vector<thread>            threads;
+      for (size_t i = 0; i < count; ++i) {
+        threads.emplace_back([&, i] {
+          peers[i] = NewPeer(hostOrPath, port, expectedId);
+        });
+      }
+      for (auto & t : threads) {
+        t.join();
+      }
+      
+      size_t  rc = 0;
+      auto    now = Clock::now();
+      for (auto & peer : peers) {
+        if (peer && Return(key, std::move(peer), now)) {
+          ++rc;
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PeerPool::Return(const string & key, unique_ptr<Peer> peer,
+                          Clock::time_point created)
+    {
+      bool  rc = false;
+      //  A Peer with unread data is out of step with the server.  We
+      //  check before taking _mtx, since checking takes system calls.
+      if (peer->IsConnected() && peer->ReceiveWouldBlock(1)) {
+        lock_guard<mutex>  lck(_mtx);
+        auto  it = _idle.find(key);
+        size_t  numIdle = ((it != _idle.end()) ? it->second.size() : 0);
+        if (numIdle < _maxIdle) {
+          _idle[key].push_back(IdlePeer{std::move(peer), created,
+                                        Clock::now()});
+          rc = true;
+        }
+        else {
+          ++_counters.overflows;
+        }
+      }
+      if (! rc) {
+        peer->Disconnect();
+      }
+      return rc;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,118 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerReader.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerReader class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/socket.h>
+}
+
+#include <utility>
+
+#include "DwmCredencePeerReader.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerReader::PeerReader()
+        : _socket(), _fd(-1), _theirId(), _endPoint(), _buf(), _is(),
+          _xis()
+    { }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerReader::PeerReader(PeerReader && reader)
+        : PeerReader()
+    {
+      *this = std::move(reader);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerReader & PeerReader::operator = (PeerReader && reader)
+    {
+      if (this != &reader) {
+        Clear();
+        _socket = std::move(reader._socket);
+        _fd = std::exchange(reader._fd, -1);
+        _theirId = std::move(reader._theirId);
+        _endPoint = std::move(reader._endPoint);
+        _buf = std::move(reader._buf);
+        _is = std::move(reader._is);
+        _xis = std::move(reader._xis);
+      }
+      return *this;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerReader::Shutdown()
+    {
+      if (0 <= _fd) {
+        ::shutdown(_fd, SHUT_RD);
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Releases in the reverse order of construction, so the socket is
+    //!  still open while our buffers are torn down.
+    //------------------------------------------------------------------------
+    void PeerReader::Clear()
+    {
+      _xis = nullptr;
+      _is = nullptr;
+      _buf = nullptr;
+      _socket = nullptr;
+      _fd = -1;
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
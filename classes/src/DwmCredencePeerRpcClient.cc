@@ -0,0 +1,266 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerRpcClient.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerRpcClient class implementation
+//---------------------------------------------------------------------------
+
+#include "DwmSysLogger.hh"
+#include "DwmCredencePeerRpcClient.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcClient::PeerRpcClient(Peer & peer, size_t maxInFlight)
+        : _peer(peer), _maxInFlight(max(maxInFlight, (size_t)1)), _mtx(),
+          _cv(), _sendMtx(), _pending(), _deadlines(), _nextId(1),
+          _run(false), _closed(false), _peerReader(), _peerWriter(),
+          _readerThread(), _reaper()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcClient::~PeerRpcClient()
+    {
+      Stop();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PeerRpcClient::Start()
+    {
+      lock_guard<mutex>  lck(_mtx);
+      if (! _run) {
+        if (_closed) {
+          Syslog(LOG_ERR, "PeerRpcClient can't be restarted");
+          return false;
+        }
+        if (! _peer.Split(_peerReader, _peerWriter)) {
+          Syslog(LOG_ERR, "PeerRpcClient failed to split Peer");
+          return false;
+        }
+        _run = true;
+        _readerThread = thread(&PeerRpcClient::ReaderLoop, this);
+        _reaper = thread(&PeerRpcClient::ReaperLoop, this);
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcClient::Stop()
+    {
+      {
+        lock_guard<mutex>  lck(_mtx);
+        if (! _run) {
+          return;
+        }
+        _run = false;
+      }
+      Close();
+      _peerReader.Shutdown();
+      _peerWriter.Shutdown();
+      if (_readerThread.joinable()) {
+        _readerThread.join();
+      }
+      if (_reaper.joinable()) {
+        _reaper.join();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    future<PeerRpcResponse>
+    PeerRpcClient::CallRaw(uint32_t method, string && body,
+                           std::chrono::milliseconds timeout)
+    {
+      auto  deadline = Clock::now() + timeout;
+      unique_lock<mutex>  lck(_mtx);
+      if ((! _run) || _closed) {
+        return Completed(PeerRpcResponse(0, Status::e_disconnected));
+      }
+      if (! _cv.wait_until(lck, deadline, [&] {
+        return (_closed || (_pending.size() < _maxInFlight)); })) {
+        return Completed(PeerRpcResponse(0, Status::e_timeout));
+      }
+      if (_closed) {
+        return Completed(PeerRpcResponse(0, Status::e_disconnected));
+      }
+      uint64_t  id = _nextId++;
+      Pending  & pending = _pending[id];
+      pending.deadline = deadline;
+      auto  rc = pending.promise.get_future();
+      _deadlines.emplace(deadline, id);
+      _cv.notify_all();
+      lck.unlock();
+
+      //  The response may be processed by the reader before Send()
+      //  returns; that's fine since we already hold the future.
+      PeerRpcRequest  request(id, method, std::move(body));
+      bool  sent;
+      {
+        lock_guard<mutex>  sendLock(_sendMtx);
+        sent = _peerWriter.Send(request);
+      }
+      if (! sent) {
+        Close();
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t PeerRpcClient::InFlight() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _pending.size();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PeerRpcClient::Closed() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _closed;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    future<PeerRpcResponse>
+    PeerRpcClient::Completed(PeerRpcResponse && response)
+    {
+      promise<PeerRpcResponse>  p;
+      p.set_value(std::move(response));
+      return p.get_future();
+    }
+
+    //------------------------------------------------------------------------
+    //!  Caller must hold _mtx.
+    //------------------------------------------------------------------------
+    void PeerRpcClient::Complete(uint64_t id, PeerRpcResponse && response)
+    {
+      auto  it = _pending.find(id);
+      if (it != _pending.end()) {
+        it->second.promise.set_value(std::move(response));
+        _deadlines.erase(make_pair(it->second.deadline, id));
+        _pending.erase(it);
+        _cv.notify_all();
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcClient::ReaderLoop()
+    {
+      for (;;) {
+        PeerRpcResponse  response;
+        if (! _peerReader.Receive(response)) {
+          break;
+        }
+        lock_guard<mutex>  lck(_mtx);
+        if (_pending.find(response.Id()) != _pending.end()) {
+          uint64_t  id = response.Id();
+          Complete(id, std::move(response));
+        }
+        else {
+          FSyslog(LOG_DEBUG, "Dropped late RPC response {} from {}",
+                  response.Id(), _peerReader.Id());
+        }
+      }
+      Close();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcClient::ReaperLoop()
+    {
+      unique_lock<mutex>  lck(_mtx);
+      while (_run && (! _closed)) {
+        if (_deadlines.empty()) {
+          _cv.wait(lck);
+        }
+        else {
+          auto  [deadline, id] = *_deadlines.begin();
+          if (Clock::now() >= deadline) {
+            Complete(id, PeerRpcResponse(id, Status::e_timeout));
+          }
+          else {
+            _cv.wait_until(lck, deadline);
+          }
+        }
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcClient::Close()
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _closed = true;
+      for (auto & [id, pending] : _pending) {
+        pending.promise.set_value(PeerRpcResponse(id,
+                                                  Status::e_disconnected));
+      }
+      _pending.clear();
+      _deadlines.clear();
+      _cv.notify_all();
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,161 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerRpcMessages.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerRpcRequest and Dwm::Credence::PeerRpcResponse
+//!    class implementations
+//---------------------------------------------------------------------------
+
+#include "DwmSysLogger.hh"
+#include "DwmCredencePeerRpcMessages.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcRequest::PeerRpcRequest()
+        : _id(0), _method(0), _body()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcRequest::PeerRpcRequest(uint64_t id, uint32_t method,
+                                   string && body)
+        : _id(id), _method(method), _body(std::move(body))
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    istream & PeerRpcRequest::Read(istream & is)
+    {
+      if (StreamIO::Read(is, _id)) {
+        if (StreamIO::Read(is, _method)) {
+          StreamIO::Read(is, _body);
+        }
+      }
+      return is;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ostream & PeerRpcRequest::Write(ostream & os) const
+    {
+      if (StreamIO::Write(os, _id)) {
+        if (StreamIO::Write(os, _method)) {
+          StreamIO::Write(os, _body);
+        }
+      }
+      return os;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcResponse::PeerRpcResponse()
+        : _id(0), _status(Status::e_disconnected), _body()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcResponse::PeerRpcResponse(uint64_t id, Status status,
+                                     string && body)
+        : _id(id), _status(status), _body(std::move(body))
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    const char *PeerRpcResponse::StatusString(Status status)
+    {
+      switch (status) {
+        case Status::e_ok:             return "ok";
+        case Status::e_failed:         return "failed";
+        case Status::e_unknownMethod:  return "unknown method";
+        case Status::e_busy:           return "busy";
+        case Status::e_timeout:        return "timeout";
+        case Status::e_disconnected:   return "disconnected";
+        default:                       break;
+      }
+      return "invalid";
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    istream & PeerRpcResponse::Read(istream & is)
+    {
+      uint8_t  status;
+      if (StreamIO::Read(is, _id)) {
+        if (StreamIO::Read(is, status)) {
+          if (status <= (uint8_t)Status::e_disconnected) {
+            _status = (Status)status;
+            StreamIO::Read(is, _body);
+          }
+          else {
+            is.setstate(ios_base::failbit);
+            FSyslog(LOG_ERR, "Invalid RPC response status {}", status);
+          }
+        }
+      }
+      return is;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ostream & PeerRpcResponse::Write(ostream & os) const
+    {
+      if (StreamIO::Write(os, _id)) {
+        if (StreamIO::Write(os, (uint8_t)_status)) {
+          StreamIO::Write(os, _body);
+        }
+      }
+      return os;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
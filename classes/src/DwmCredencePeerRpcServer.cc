@@ -0,0 +1,251 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerRpcServer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerRpcServer class implementation
+//---------------------------------------------------------------------------
+
+#include "DwmSysLogger.hh"
+#include "DwmCredencePeerRpcServer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcServer::PeerRpcServer(Peer & peer, size_t numWorkers,
+                                 size_t maxQueued)
+        : _peer(peer), _numWorkers(max(numWorkers, (size_t)1)),
+          _maxQueued(maxQueued), _handlers(), _mtx(), _cv(), _sendMtx(),
+          _requests(), _run(false), _closed(false), _peerReader(),
+          _peerWriter(), _readerThread(), _workers()
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerRpcServer::~PeerRpcServer()
+    {
+      Stop();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcServer::Register(uint32_t method, Handler handler)
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _handlers[method] = std::move(handler);
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PeerRpcServer::Start()
+    {
+      lock_guard<mutex>  lck(_mtx);
+      if (! _run) {
+        if (_closed) {
+          Syslog(LOG_ERR, "PeerRpcServer can't be restarted");
+          return false;
+        }
+        if (! _peer.Split(_peerReader, _peerWriter)) {
+          Syslog(LOG_ERR, "PeerRpcServer failed to split Peer");
+          return false;
+        }
+        _run = true;
+        for (size_t i = 0; i < _numWorkers; ++i) {
+          _workers.emplace_back(&PeerRpcServer::WorkerLoop, this);
+        }
+        _readerThread = thread(&PeerRpcServer::ReaderLoop, this);
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcServer::Stop()
+    {
+      {
+        lock_guard<mutex>  lck(_mtx);
+        if (! _run) {
+          return;
+        }
+        _run = false;
+      }
+      Close();
+      _peerReader.Shutdown();
+      _peerWriter.Shutdown();
+      if (_readerThread.joinable()) {
+        _readerThread.join();
+      }
+      for (auto & worker : _workers) {
+        worker.join();
+      }
+      _workers.clear();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcServer::Wait()
+    {
+      unique_lock<mutex>  lck(_mtx);
+      _cv.wait(lck, [&] { return (_closed || (! _run)); });
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PeerRpcServer::Closed() const
+    {
+      lock_guard<mutex>  lck(_mtx);
+      return _closed;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PeerRpcServer::Respond(PeerRpcResponse && response)
+    {
+      bool  rc;
+      {
+        lock_guard<mutex>  sendLock(_sendMtx);
+        rc = _peerWriter.Send(response);
+      }
+      if (! rc) {
+        Close();
+      }
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Requests for unknown methods and requests that don't fit in the
+    //!  queue are answered here, without involving a worker.
+    //------------------------------------------------------------------------
+    void PeerRpcServer::ReaderLoop()
+    {
+      for (;;) {
+        PeerRpcRequest  request;
+        if (! _peerReader.Receive(request)) {
+          break;
+        }
+        Status  status = Status::e_ok;
+        {
+          lock_guard<mutex>  lck(_mtx);
+          if (_handlers.find(request.Method()) == _handlers.end()) {
+            status = Status::e_unknownMethod;
+          }
+          else if (_requests.size() >= _maxQueued) {
+            status = Status::e_busy;
+          }
+          else {
+            _requests.push_back(std::move(request));
+            _cv.notify_one();
+          }
+        }
+        if (Status::e_ok != status) {
+          if (! Respond(PeerRpcResponse(request.Id(), status))) {
+            break;
+          }
+        }
+      }
+      Close();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  We call a copy of the handler, since Register() may replace it
+    //!  once we release _mtx.
+    //------------------------------------------------------------------------
+    void PeerRpcServer::WorkerLoop()
+    {
+      unique_lock<mutex>  lck(_mtx);
+      for (;;) {
+        _cv.wait(lck, [&] { return (_closed || (! _requests.empty())); });
+        if (_closed) {
+          break;
+        }
+        PeerRpcRequest  request = std::move(_requests.front());
+        _requests.pop_front();
+        Handler  handler = _handlers.at(request.Method());
+        lck.unlock();
+
+        string  body;
+        bool    ok = false;
+        try {
+          ok = handler(request, body);
+        }
+        catch (const std::exception & ex) {
+          FSyslog(LOG_ERR, "Exception in RPC handler for method {}: {}",
+                  request.Method(), ex.what());
+        }
+        catch (...) {
+          FSyslog(LOG_ERR, "Exception in RPC handler for method {}",
+                  request.Method());
+        }
+        Respond(PeerRpcResponse(request.Id(),
+                                ok ? Status::e_ok : Status::e_failed,
+                                std::move(body)));
+        lck.lock();
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerRpcServer::Close()
+    {
+      lock_guard<mutex>  lck(_mtx);
+      _closed = true;
+      _requests.clear();
+      _cv.notify_all();
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,118 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePeerWriter.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PeerWriter class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/socket.h>
+}
+
+#include <utility>
+
+#include "DwmCredencePeerWriter.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerWriter::PeerWriter()
+        : _socket(), _fd(-1), _theirId(), _endPoint(), _buf(), _os(),
+          _xos()
+    { }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerWriter::PeerWriter(PeerWriter && writer)
+        : PeerWriter()
+    {
+      *this = std::move(writer);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PeerWriter & PeerWriter::operator = (PeerWriter && writer)
+    {
+      if (this != &writer) {
+        Clear();
+        _socket = std::move(writer._socket);
+        _fd = std::exchange(writer._fd, -1);
+        _theirId = std::move(writer._theirId);
+        _endPoint = std::move(writer._endPoint);
+        _buf = std::move(writer._buf);
+        _os = std::move(writer._os);
+        _xos = std::move(writer._xos);
+      }
+      return *this;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void PeerWriter::Shutdown()
+    {
+      if (0 <= _fd) {
+        ::shutdown(_fd, SHUT_WR);
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Releases in the reverse order of construction, so the socket is
+    //!  still open while our buffers are torn down.
+    //------------------------------------------------------------------------
+    void PeerWriter::Clear()
+    {
+      _xos = nullptr;
+      _os = nullptr;
+      _buf = nullptr;
+      _socket = nullptr;
+      _fd = -1;
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
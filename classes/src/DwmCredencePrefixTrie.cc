@@ -0,0 +1,216 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredencePrefixTrie.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PrefixTrie class implementation
+//---------------------------------------------------------------------------
+
+#include <cstdlib>
+#include <sstream>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredencePrefixTrie.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  Returns the @c i'th 4-bit nibble of @c addr, most significant
+    //!  first.
+    //------------------------------------------------------------------------
+    static inline uint8_t Nibble(const uint8_t *addr, size_t i)
+    {
+      return ((i & 1) ? (addr[i >> 1] & 0x0f) : (addr[i >> 1] >> 4));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PrefixTrie::PrefixTrie()
+        : _nodes(2), _size(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    PrefixTrie::PrefixTrie(const set<IpPrefix> & prefixes)
+        : _nodes(2), _size(0)
+    {
+      for (const auto & prefix : prefixes) {
+        Add(prefix);
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool PrefixTrie::Add(const boost::asio::ip::address & addr,
+                         uint8_t maskLen)
+    {
+      bool  rc = false;
+      if (addr.is_v6() && addr.to_v6().is_v4_mapped()) {
+        auto  v4 = boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped,
+                                                    addr.to_v6());
+        if ((maskLen >= 96) && (maskLen <= 128)) {
+          rc = Add(k_v4Root, v4.to_bytes().data(), maskLen - 96);
+        }
+      }
+      else if (addr.is_v4()) {
+        if (maskLen <= 32) {
+          rc = Add(k_v4Root, addr.to_v4().to_bytes().data(), maskLen);
+        }
+      }
+      else if (maskLen <= 128) {
+        rc = Add(k_v6Root, addr.to_v6().to_bytes().data(), maskLen);
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  IpPrefix is converted via its string form, which is the same form
+    //!  used in the server configuration file.
+    //------------------------------------------------------------------------
+    bool PrefixTrie::Add(const IpPrefix & prefix)
+    {
+      bool           rc = false;
+      ostringstream  os;
+      os << prefix;
+      string  s = os.str();
+      string::size_type  slash = s.find('/');
+      boost::system::error_code  ec;
+      auto  addr = boost::asio::ip::make_address(s.substr(0, slash), ec);
+      if (! ec) {
+        int  maskLen = addr.is_v4() ? 32 : 128;
+        if (string::npos != slash) {
+          maskLen = atoi(s.c_str() + slash + 1);
+        }
+        if ((maskLen >= 0) && (maskLen <= 128)) {
+          rc = Add(addr, maskLen);
+        }
+      }
+      if (! rc) {
+        FSyslog(LOG_ERR, "Failed to add prefix '{}'", s);
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    int PrefixTrie::LongestMatch(const boost::asio::ip::address & addr) const
+    {
+      if (addr.is_v4()) {
+        return LongestMatch(k_v4Root, addr.to_v4().to_bytes().data(), 4);
+      }
+      auto  v6 = addr.to_v6();
+      if (v6.is_v4_mapped()) {
+        auto  v4 = boost::asio::ip::make_address_v4(boost::asio::ip::v4_mapped,
+                                                    v6);
+        return LongestMatch(k_v4Root, v4.to_bytes().data(), 4);
+      }
+      return LongestMatch(k_v6Root, v6.to_bytes().data(), 16);
+    }
+
+    //------------------------------------------------------------------------
+    //!  Descends one node per full nibble of the prefix, creating nodes as
+    //!  needed, then marks the 2^(4 - remaining bits) entries the last
+    //!  partial (or full) nibble covers.  An entry keeps the longest of
+    //!  the prefixes marked on it.
+    //------------------------------------------------------------------------
+    bool PrefixTrie::Add(uint32_t root, const uint8_t *addr, uint8_t maskLen)
+    {
+      uint32_t  node = root;
+      int       depth = 0;
+      while ((maskLen - (4 * depth)) > 4) {
+        uint8_t   nib = Nibble(addr, depth);
+        uint32_t  child = _nodes[node].entries[nib] & k_childMask;
+        if (0 == child) {
+          if (_nodes.size() > k_childMask) {
+            return false;
+          }
+          child = _nodes.size();
+          _nodes.push_back(Node{});
+          _nodes[node].entries[nib] |= child;
+        }
+        node = child;
+        ++depth;
+      }
+      int       remaining = maskLen - (4 * depth);
+      uint8_t   first = 0;
+      if (remaining) {
+        first = Nibble(addr, depth) & (0xf0 >> remaining) & 0x0f;
+      }
+      uint32_t  span = 1 << (4 - remaining);
+      uint32_t  lenBits = (uint32_t)(maskLen + 1) << k_lenShift;
+      for (uint32_t i = first; i < first + span; ++i) {
+        uint32_t  & entry = _nodes[node].entries[i];
+        if ((entry & ~k_childMask) < lenBits) {
+          entry = (entry & k_childMask) | lenBits;
+        }
+      }
+      ++_size;
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  Entries deeper in the trie are for longer prefixes, so the last
+    //!  match on the way down is the longest.
+    //------------------------------------------------------------------------
+    int PrefixTrie::LongestMatch(uint32_t root, const uint8_t *addr,
+                                 size_t addrLen) const
+    {
+      int       rc = -1;
+      uint32_t  node = root;
+      for (size_t i = 0; i < (addrLen * 2); ++i) {
+        uint32_t  entry = _nodes[node].entries[Nibble(addr, i)];
+        if (entry >> k_lenShift) {
+          rc = (int)(entry >> k_lenShift) - 1;
+        }
+        node = entry & k_childMask;
+        if (0 == node) {
+          break;
+        }
+      }
+      return rc;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
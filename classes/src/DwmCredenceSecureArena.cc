@@ -0,0 +1,269 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSecureArena.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SecureArena class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/mman.h>
+  #include <unistd.h>
+  #include <sodium.h>
+}
+
+#include <algorithm>
+#include <cerrno>
+#include <cstring>
+#include <functional>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceSecureArena.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    static_assert(SecureArena::k_slotSize >= sizeof(void *));
+
+    //------------------------------------------------------------------------
+    //!  Orders an address against the start of a slab's data, for
+    //!  searching _slabs.  std::less gives a total order even for
+    //!  pointers into different mappings.
+    //------------------------------------------------------------------------
+    bool SecureArena::SlabBefore(const uint8_t *p, const Slab & slab)
+    {
+      return less<const uint8_t *>()(p, slab.data);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SecureArena & SecureArena::Instance()
+    {
+      //  Deliberately leaked; see the header.
+      static SecureArena  *arena = new SecureArena();
+      return *arena;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SecureArena::SecureArena()
+        : _mtx(), _slabs(), _freeList(nullptr), _inUse(0), _free(0),
+          _fallbacks(0)
+    {
+      if (sodium_init() < 0) {
+        Syslog(LOG_ERR, "sodium_init() failed");
+      }
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void *SecureArena::Allocate()
+    {
+      void  *rc = nullptr;
+      lock_guard  lck(_mtx);
+      if ((nullptr != _freeList) || AddSlab()) {
+        FreeSlot  *slot = _freeList;
+        _freeList = slot->next;
+        --_free;
+        rc = slot;
+      }
+      else {
+        rc = sodium_malloc(k_slotSize);
+        if (nullptr != rc) {
+          ++_fallbacks;
+        }
+      }
+      if (nullptr != rc) {
+        sodium_memzero(rc, k_slotSize);
+        ++_inUse;
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void SecureArena::Free(void *p)
+    {
+      if (nullptr != p) {
+        lock_guard  lck(_mtx);
+        if (Owns(p)) {
+          sodium_memzero(p, k_slotSize);
+          FreeSlot  *slot = (FreeSlot *)p;
+          slot->next = _freeList;
+          _freeList = slot;
+          ++_free;
+        }
+        else {
+          sodium_free(p);
+          --_fallbacks;
+        }
+        --_inUse;
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t SecureArena::SlotsInUse() const
+    {
+      lock_guard  lck(_mtx);
+      return _inUse;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t SecureArena::SlotsFree() const
+    {
+      lock_guard  lck(_mtx);
+      return _free;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t SecureArena::NumSlabs() const
+    {
+      lock_guard  lck(_mtx);
+      return _slabs.size();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool SecureArena::Locked() const
+    {
+      lock_guard  lck(_mtx);
+      for (const auto & slab : _slabs) {
+        if (! slab.locked) {
+          return false;
+        }
+      }
+      return true;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Maps a new slab laid out as a guard page, k_slabPages pages of
+    //!  slots and another guard page, and threads its slots onto the
+    //!  free list.  Caller must hold _mtx.
+    //------------------------------------------------------------------------
+    bool SecureArena::AddSlab()
+    {
+      bool    rc = false;
+      long    pgsz = sysconf(_SC_PAGESIZE);
+      size_t  pageSize = (pgsz > 0) ? (size_t)pgsz : 4096;
+      size_t  dataLen = pageSize * k_slabPages;
+      size_t  mapLen = dataLen + (2 * pageSize);
+      void  *m = mmap(nullptr, mapLen, PROT_READ|PROT_WRITE,
+                      MAP_PRIVATE|MAP_ANON, -1, 0);
+      if (MAP_FAILED != m) {
+        Slab  slab;
+        slab.map = (uint8_t *)m;
+        slab.mapLen = mapLen;
+        slab.data = slab.map + pageSize;
+        slab.dataLen = dataLen;
+        if ((mprotect(slab.map, pageSize, PROT_NONE) == 0)
+            && (mprotect(slab.data + dataLen, pageSize, PROT_NONE) == 0)) {
+          slab.locked = (mlock(slab.data, dataLen) == 0);
+          if (! slab.locked) {
+            FSyslog(LOG_WARNING, "mlock() of {} byte secure slab failed: {}",
+                    dataLen, strerror(errno));
+          }
+#if defined(MADV_DONTDUMP)
+          (void)madvise(slab.data, dataLen, MADV_DONTDUMP);
+#elif defined(MADV_NOCORE)
+          (void)madvise(slab.data, dataLen, MADV_NOCORE);
+#endif
+          try {
+            auto  pos = upper_bound(_slabs.begin(), _slabs.end(), slab.data,
+                                    SlabBefore);
+            _slabs.insert(pos, slab);
+            for (size_t off = dataLen; off >= k_slotSize; ) {
+              off -= k_slotSize;
+              FreeSlot  *slot = (FreeSlot *)(slab.data + off);
+              slot->next = _freeList;
+              _freeList = slot;
+              ++_free;
+            }
+            rc = true;
+          }
+          catch (...) {
+            if (slab.locked) {
+              munlock(slab.data, dataLen);
+            }
+            munmap(m, mapLen);
+          }
+        }
+        else {
+          FSyslog(LOG_ERR, "mprotect() of secure slab guard failed: {}",
+                  strerror(errno));
+          munmap(m, mapLen);
+        }
+      }
+      else {
+        FSyslog(LOG_ERR, "mmap() of {} byte secure slab failed: {}",
+                mapLen, strerror(errno));
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  _slabs is sorted by data address, so the only slab that can hold
+    //!  @c p is the last one starting at or below it.  Caller must hold
+    //!  _mtx.
+    //------------------------------------------------------------------------
+    bool SecureArena::Owns(const void *p) const
+    {
+      const uint8_t  *bp = (const uint8_t *)p;
+      auto  it = upper_bound(_slabs.begin(), _slabs.end(), bp, SlabBefore);
+      if (it == _slabs.begin()) {
+        return false;
+      }
+      --it;
+      return less<const uint8_t *>()(bp, it->data + it->dataLen);
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,340 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmChannel.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmChannel class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/mman.h>
+  #include <sys/socket.h>
+  #include <sys/stat.h>
+  #include <fcntl.h>
+  #include <poll.h>
+  #include <unistd.h>
+}
+
+#include <cerrno>
+#include <cstring>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceShmChannel.hh"
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0
+#endif
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ShmChannel::Supported()
+    {
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+      return true;
+#else
+      return false;
+#endif
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmChannel::ShmChannel()
+        : _memFd(-1), _mem(nullptr), _memSize(0), _ringSize(0),
+          _open(false), _inRing(), _outRing(), _inBuf(_inRing),
+          _outBuf(_outRing), _is(&_inBuf), _os(&_outBuf)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmChannel::~ShmChannel()
+    {
+      Close();
+      Unmap();
+      if (0 <= _memFd) {
+        ::close(_memFd);
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  The memory is sealed against shrinking, so the other process
+    //!  can't make our accesses fault with SIGBUS.
+    //------------------------------------------------------------------------
+    bool ShmChannel::Create(size_t ringSize)
+    {
+      bool  rc = false;
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+      _ringSize = k_minRingSize;
+      while ((_ringSize < ringSize) && (_ringSize < k_maxRingSize)) {
+        _ringSize <<= 1;
+      }
+      _memSize = k_dataOffset + (2 * _ringSize);
+      _memFd = memfd_create("credence", MFD_CLOEXEC | MFD_ALLOW_SEALING);
+      if (0 > _memFd) {
+        FSyslog(LOG_ERR, "memfd_create() failed: {}", strerror(errno));
+        return rc;
+      }
+      if (ftruncate(_memFd, _memSize) != 0) {
+        FSyslog(LOG_ERR, "ftruncate({},{}) failed: {}", _memFd, _memSize,
+                strerror(errno));
+        return rc;
+      }
+      if (fcntl(_memFd, F_ADD_SEALS,
+                F_SEAL_SHRINK | F_SEAL_GROW | F_SEAL_SEAL) != 0) {
+        FSyslog(LOG_ERR, "Failed to seal shared memory: {}",
+                strerror(errno));
+        return rc;
+      }
+      if (Map()) {
+        Header  *hdr = (Header *)_mem;
+        hdr->magic = k_magic;
+        hdr->version = k_version;
+        hdr->ringSize = _ringSize;
+        ShmRing::Initialize((char *)_mem + k_controlOffset);
+        ShmRing::Initialize((char *)_mem + k_controlOffset + k_controlSize);
+        rc = true;
+      }
+#endif
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ShmChannel::SendDescriptor(int socketFd)
+    {
+      bool  rc = false;
+      if (0 > _memFd) {
+        return rc;
+      }
+      char           byte = 'M';
+      struct iovec   iov = { &byte, 1 };
+      union {
+        char            buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr  align;
+      } control;
+      struct msghdr  msg;
+      memset(&msg, 0, sizeof(msg));
+      memset(&control, 0, sizeof(control));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control.buf;
+      msg.msg_controllen = sizeof(control.buf);
+      struct cmsghdr  *cmsg = CMSG_FIRSTHDR(&msg);
+      cmsg->cmsg_level = SOL_SOCKET;
+      cmsg->cmsg_type = SCM_RIGHTS;
+      cmsg->cmsg_len = CMSG_LEN(sizeof(int));
+      memcpy(CMSG_DATA(cmsg), &_memFd, sizeof(int));
+      ssize_t  len;
+      do {
+        len = sendmsg(socketFd, &msg, MSG_NOSIGNAL);
+      } while ((len < 0) && (EINTR == errno));
+      if (1 == len) {
+        rc = true;
+      }
+      else {
+        FSyslog(LOG_ERR, "Failed to send shared memory descriptor: {}",
+                strerror(errno));
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The descriptor comes from an authenticated peer, but we still
+    //!  check that it's what we agreed on before trusting its size.
+    //------------------------------------------------------------------------
+    bool ShmChannel::ReceiveDescriptor(int socketFd, size_t ringSize,
+                                       chrono::milliseconds timeout)
+    {
+      bool  rc = false;
+#if defined(__linux__) && defined(MFD_ALLOW_SEALING)
+      if ((ringSize < k_minRingSize) || (ringSize > k_maxRingSize)
+          || (ringSize & (ringSize - 1))) {
+        FSyslog(LOG_ERR, "Invalid shared memory ring size {}", ringSize);
+        return rc;
+      }
+      struct pollfd  pfd = { socketFd, POLLIN, 0 };
+      if (poll(&pfd, 1, timeout.count()) <= 0) {
+        Syslog(LOG_ERR, "Shared memory descriptor not received");
+        return rc;
+      }
+      char           byte;
+      struct iovec   iov = { &byte, 1 };
+      union {
+        char            buf[CMSG_SPACE(sizeof(int))];
+        struct cmsghdr  align;
+      } control;
+      struct msghdr  msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = &iov;
+      msg.msg_iovlen = 1;
+      msg.msg_control = control.buf;
+      msg.msg_controllen = sizeof(control.buf);
+      ssize_t  len;
+      do {
+        len = recvmsg(socketFd, &msg, MSG_CMSG_CLOEXEC);
+      } while ((len < 0) && (EINTR == errno));
+      if (1 == len) {
+        struct cmsghdr  *cmsg = CMSG_FIRSTHDR(&msg);
+        if (cmsg && (SOL_SOCKET == cmsg->cmsg_level)
+            && (SCM_RIGHTS == cmsg->cmsg_type)
+            && (CMSG_LEN(sizeof(int)) == cmsg->cmsg_len)) {
+          memcpy(&_memFd, CMSG_DATA(cmsg), sizeof(int));
+        }
+      }
+      if (0 > _memFd) {
+        Syslog(LOG_ERR, "Failed to receive shared memory descriptor");
+        return rc;
+      }
+      _ringSize = ringSize;
+      _memSize = k_dataOffset + (2 * _ringSize);
+      struct stat  st;
+      if ((fstat(_memFd, &st) != 0) || (st.st_size != (off_t)_memSize)) {
+        Syslog(LOG_ERR, "Shared memory is the wrong size");
+        return rc;
+      }
+      int  seals = fcntl(_memFd, F_GET_SEALS);
+      if ((seals < 0) || (! (seals & F_SEAL_SHRINK))) {
+        Syslog(LOG_ERR, "Shared memory is not sealed");
+        return rc;
+      }
+      if (Map()) {
+        const Header  *hdr = (const Header *)_mem;
+        if ((k_magic == hdr->magic) && (k_version == hdr->version)
+            && (_ringSize == hdr->ringSize)) {
+          rc = true;
+        }
+        else {
+          Syslog(LOG_ERR, "Shared memory header mismatch");
+          Unmap();
+        }
+      }
+#endif
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The creator writes the first ring and reads the second.
+    //------------------------------------------------------------------------
+    void ShmChannel::Open(bool creator, int socketFd)
+    {
+      char    *base = (char *)_mem;
+      size_t   outIdx = creator ? 0 : 1;
+      size_t   inIdx = 1 - outIdx;
+      _outRing.Attach(base + k_controlOffset + (outIdx * k_controlSize),
+                      base + k_dataOffset + (outIdx * _ringSize),
+                      _ringSize, socketFd);
+      _inRing.Attach(base + k_controlOffset + (inIdx * k_controlSize),
+                     base + k_dataOffset + (inIdx * _ringSize),
+                     _ringSize, socketFd);
+      ::close(_memFd);
+      _memFd = -1;
+      _open = true;
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t ShmChannel::BytesReady() const
+    {
+      return (_open ? _inBuf.BytesReady() : 0);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmChannel::Close()
+    {
+      if (_open) {
+        _os.flush();
+        _outRing.Close();
+        _inRing.Close();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmChannel::CloseReceive()
+    {
+      if (_open) {
+        _inRing.Close();
+      }
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ShmChannel::Map()
+    {
+      _mem = mmap(nullptr, _memSize, PROT_READ | PROT_WRITE, MAP_SHARED,
+                  _memFd, 0);
+      if (MAP_FAILED == _mem) {
+        FSyslog(LOG_ERR, "mmap() of shared memory failed: {}",
+                strerror(errno));
+        _mem = nullptr;
+        return false;
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmChannel::Unmap()
+    {
+      if (_mem) {
+        _open = false;
+        munmap(_mem, _memSize);
+        _mem = nullptr;
+      }
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
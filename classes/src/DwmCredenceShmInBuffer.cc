@@ -0,0 +1,144 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmInBuffer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmInBuffer class implementation
+//---------------------------------------------------------------------------
+
+#include <cstring>
+
+#include "DwmCredenceShmInBuffer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmInBuffer::ShmInBuffer(ShmRing & ring)
+        : _ring(ring)
+    {
+      setg(nullptr, nullptr, nullptr);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t ShmInBuffer::BytesReady() const
+    {
+      return (_ring.Readable() - (gptr() - eback()));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  What we've read from our span is still in the ring until we
+    //!  release it, so we wait for that much more.
+    //------------------------------------------------------------------------
+    bool ShmInBuffer::WaitForBytesReady(size_t numBytes,
+                                        chrono::milliseconds timeout)
+    {
+      return _ring.WaitReadable(numBytes + (gptr() - eback()), timeout);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmInBuffer::int_type ShmInBuffer::underflow()
+    {
+      if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+      }
+      Release();
+      size_t       len;
+      const char  *p = _ring.ReadSpan(len);
+      if (nullptr == p) {
+        return traits_type::eof();
+      }
+      setg((char_type *)p, (char_type *)p, (char_type *)p + len);
+      return traits_type::to_int_type(*gptr());
+    }
+
+    //------------------------------------------------------------------------
+    //!  Releases as soon as a span is used up, rather than at the next
+    //!  read, so a writer waiting for space isn't held up by a reader
+    //!  that's busy with what it just read.
+    //------------------------------------------------------------------------
+    streamsize ShmInBuffer::xsgetn(char_type *s, streamsize n)
+    {
+      streamsize  rc = 0;
+      while (rc < n) {
+        if (gptr() == egptr()) {
+          if (traits_type::eq_int_type(underflow(), traits_type::eof())) {
+            break;
+          }
+        }
+        streamsize  chunk = min((streamsize)(egptr() - gptr()), n - rc);
+        memcpy(s + rc, gptr(), chunk);
+        gbump(chunk);
+        rc += chunk;
+      }
+      if (gptr() == egptr()) {
+        Release();
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    streamsize ShmInBuffer::showmanyc()
+    {
+      return BytesReady();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmInBuffer::Release()
+    {
+      if (eback() < gptr()) {
+        _ring.Consume(gptr() - eback());
+      }
+      setg(nullptr, nullptr, nullptr);
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
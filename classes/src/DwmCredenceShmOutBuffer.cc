@@ -0,0 +1,101 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmOutBuffer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmOutBuffer class implementation
+//---------------------------------------------------------------------------
+
+#include "DwmCredenceShmOutBuffer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmOutBuffer::ShmOutBuffer(ShmRing & ring)
+        : _ring(ring)
+    {
+      setp(nullptr, nullptr);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmOutBuffer::int_type ShmOutBuffer::overflow(int_type c)
+    {
+      Publish();
+      size_t  len;
+      char   *p = _ring.WriteSpan(len);
+      if (nullptr == p) {
+        setp(nullptr, nullptr);
+        return traits_type::eof();
+      }
+      setp(p, p + len);
+      if (! traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+      }
+      return traits_type::not_eof(c);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    int ShmOutBuffer::sync()
+    {
+      return Publish() ? 0 : -1;
+    }
+
+    //------------------------------------------------------------------------
+    //!  The rest of the put area is still ours, so we keep it.
+    //------------------------------------------------------------------------
+    bool ShmOutBuffer::Publish()
+    {
+      if (pbase() < pptr()) {
+        _ring.Produce(pptr() - pbase());
+        setp(pptr(), epptr());
+      }
+      return (! _ring.Closed());
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -0,0 +1,341 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceShmRing.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::ShmRing class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <poll.h>
+#if defined(__linux__)
+  #include <linux/futex.h>
+  #include <sys/syscall.h>
+  #include <unistd.h>
+#endif
+}
+
+#include <cerrno>
+#include <climits>
+#include <new>
+#include <thread>
+
+#include "DwmCredenceShmRing.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static inline void CpuRelax()
+    {
+#if defined(__x86_64__) || defined(__i386__)
+      __builtin_ia32_pause();
+#elif defined(__aarch64__)
+      asm volatile("yield");
+#endif
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Returns true if we timed out.  Not FUTEX_PRIVATE_FLAG, since the
+    //!  word is shared between processes.
+    //------------------------------------------------------------------------
+    static bool FutexWait(atomic<uint32_t> & word, uint32_t val,
+                          chrono::milliseconds timeout)
+    {
+#if defined(__linux__)
+      struct timespec  ts = { (time_t)(timeout.count() / 1000),
+                              (long)((timeout.count() % 1000) * 1000000) };
+      long  rc = syscall(SYS_futex, (uint32_t *)&word, FUTEX_WAIT, val,
+                         &ts, nullptr, 0);
+      return ((rc < 0) && (ETIMEDOUT == errno));
+#else
+      this_thread::sleep_for(chrono::microseconds(100));
+      return true;
+#endif
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    static void FutexWake(atomic<uint32_t> & word)
+    {
+#if defined(__linux__)
+      syscall(SYS_futex, (uint32_t *)&word, FUTEX_WAKE, INT_MAX,
+              nullptr, nullptr, 0);
+#endif
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmRing::Initialize(void *control)
+    {
+      new (control) Control{};
+      return;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ShmRing::ShmRing()
+        : _control(nullptr), _data(nullptr), _capacity(0), _socketFd(-1),
+          _head(0), _tail(0)
+    {}
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmRing::Attach(void *control, char *data, size_t capacity,
+                         int socketFd)
+    {
+      _control = (Control *)control;
+      _data = data;
+      _capacity = capacity;
+      _socketFd = socketFd;
+      _head = _control->head.load();
+      _tail = _control->tail.load();
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    char *ShmRing::WriteSpan(size_t & len)
+    {
+      len = 0;
+      if (Closed()) {
+        return nullptr;
+      }
+      uint64_t  used = 0;
+      auto  hasSpace = [&] () {
+        used = _head - _control->tail.load();
+        return (used != _capacity);
+      };
+      if (! Wait(_control->spaceSeq, _control->producerWaiting, hasSpace)) {
+        return nullptr;
+      }
+      if (used > _capacity) {
+        Close();
+        return nullptr;
+      }
+      size_t  offset = _head & (_capacity - 1);
+      len = min((size_t)(_capacity - used), _capacity - offset);
+      return _data + offset;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmRing::Produce(size_t len)
+    {
+      _head += len;
+      _control->head.store(_head);
+      Wake(_control->dataSeq, _control->consumerWaiting);
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    const char *ShmRing::ReadSpan(size_t & len)
+    {
+      len = 0;
+      uint64_t  avail = 0;
+      auto  hasData = [&] () {
+        avail = _control->head.load() - _tail;
+        return (0 != avail);
+      };
+      if (! Wait(_control->dataSeq, _control->consumerWaiting, hasData)) {
+        return nullptr;
+      }
+      if (avail > _capacity) {
+        Close();
+        return nullptr;
+      }
+      size_t  offset = _tail & (_capacity - 1);
+      len = min((size_t)avail, _capacity - offset);
+      return _data + offset;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmRing::Consume(size_t len)
+    {
+      _tail += len;
+      _control->tail.store(_tail);
+      Wake(_control->spaceSeq, _control->producerWaiting);
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    size_t ShmRing::Readable() const
+    {
+      uint64_t  avail = _control->head.load() - _tail;
+      return ((avail <= _capacity) ? avail : 0);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ShmRing::WaitReadable(size_t numBytes, chrono::milliseconds timeout)
+    {
+      numBytes = min(numBytes, _capacity);
+      auto  enough = [&] () { return (Readable() >= numBytes); };
+      return Wait(_control->dataSeq, _control->consumerWaiting, enough,
+                  chrono::steady_clock::now() + timeout);
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmRing::Close()
+    {
+      _control->closed.store(1);
+      _control->dataSeq.fetch_add(1);
+      FutexWake(_control->dataSeq);
+      _control->spaceSeq.fetch_add(1);
+      FutexWake(_control->spaceSeq);
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool ShmRing::Closed() const
+    {
+      return (0 != _control->closed.load());
+    }
+
+    //------------------------------------------------------------------------
+    //!  Nothing is sent on the socket once the ring is in use, so any
+    //!  event on it means the other end is closed (or broken).
+    //------------------------------------------------------------------------
+    bool ShmRing::PeerAlive() const
+    {
+      if (0 > _socketFd) {
+        return true;
+      }
+#if defined(POLLRDHUP)
+      struct pollfd  pfd = { _socketFd, POLLIN | POLLRDHUP, 0 };
+#else
+      struct pollfd  pfd = { _socketFd, POLLIN, 0 };
+#endif
+      return (0 == poll(&pfd, 1, 0));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  The waiting flag and the index the other side publishes form a
+    //!  Dekker pair (all seq_cst): either the other side sees our flag
+    //!  and wakes us, or we see its index before sleeping.  Loading
+    //!  @c seq before setting the flag means a wake between the two
+    //!  makes the futex wait return at once.  We give up at @c deadline.
+    //------------------------------------------------------------------------
+    template <typename Pred>
+    bool ShmRing::Wait(atomic<uint32_t> & seq, atomic<uint32_t> & waiting,
+                       Pred ready, chrono::steady_clock::time_point deadline)
+    {
+      static const bool  spin = (thread::hardware_concurrency() > 1);
+      if (spin) {
+        auto  endTime = chrono::steady_clock::now() + k_spinTime;
+        for (uint32_t i = 1; ; ++i) {
+          if (ready()) {
+            return true;
+          }
+          if (Closed()) {
+            return false;
+          }
+          CpuRelax();
+          if ((0 == (i % 64)) && (chrono::steady_clock::now() > endTime)) {
+            break;
+          }
+        }
+      }
+      for (;;) {
+        uint32_t  val = seq.load();
+        waiting.store(1);
+        if (ready()) {
+          waiting.store(0);
+          return true;
+        }
+        if (Closed()) {
+          waiting.store(0);
+          return false;
+        }
+        chrono::milliseconds  timeout = k_livenessInterval;
+        if (chrono::steady_clock::time_point::max() != deadline) {
+          auto  remaining = chrono::ceil<chrono::milliseconds>
+            (deadline - chrono::steady_clock::now());
+          if (remaining.count() <= 0) {
+            waiting.store(0);
+            return false;
+          }
+          timeout = min(timeout, remaining);
+        }
+        bool  timedOut = FutexWait(seq, val, timeout);
+        waiting.store(0);
+        if (ready()) {
+          return true;
+        }
+        if (timedOut && (! PeerAlive())) {
+          return false;
+        }
+      }
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void ShmRing::Wake(atomic<uint32_t> & seq, atomic<uint32_t> & waiting)
+    {
+      if (waiting.load()) {
+        seq.fetch_add(1);
+        FutexWake(seq);
+      }
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -43,8 +43,6 @@ extern "C" {
   #include <sodium.h>
 }
 
-#include <cstdlib>
-
 #include "DwmCredenceSigner.hh"
 #include "DwmSysLogger.hh"
 
@@ -57,61 +55,67 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Signer::Sign(const string & message,
-                      const string & signingKey,
+    bool Signer::Sign(string_view message,
+                      string_view signingKey,
                       string & signedMessage)
     {
       bool  rc = false;
-      if (! signingKey.empty()) {
-        size_t    buflen = crypto_sign_BYTES + message.size();
-        uint8_t  *buf = (uint8_t *)calloc(1, buflen);
-        if (buf) {
-          unsigned long long  signedMsgLen;
-          if (crypto_sign(buf, &signedMsgLen,
-                          (const uint8_t *)message.data(), message.size(),
-                          (uint8_t *)signingKey.data()) == 0) {
-            if (signedMsgLen <= buflen) {
-              signedMessage.assign((const char *)buf, signedMsgLen);
-              rc = true;
-            }
-            else {
-              Syslog(LOG_ERR, "Signed message length too long!!!");
-            }
+      if (signingKey.size() == crypto_sign_SECRETKEYBYTES) {
+        //  Sign directly into signedMessage; no need for an intermediate
+        //  buffer.
+        signedMessage.resize(crypto_sign_BYTES + message.size());
+        unsigned long long  signedMsgLen;
+        if (crypto_sign((uint8_t *)signedMessage.data(), &signedMsgLen,
+                        (const uint8_t *)message.data(), message.size(),
+                        (const uint8_t *)signingKey.data()) == 0) {
+          if (signedMsgLen <= signedMessage.size()) {
+            signedMessage.resize(signedMsgLen);
+            rc = true;
           }
           else {
-            Syslog(LOG_ERR, "crypto_sign() failed");
+            Syslog(LOG_ERR, "Signed message length too long!!!");
           }
-          free(buf);
         }
         else {
-          FSyslog(LOG_ERR, "Failed to allocate {} bytes for signed messsage",
-                  buflen);
+          Syslog(LOG_ERR, "crypto_sign() failed");
+        }
+        if (! rc) {
+          signedMessage.clear();
         }
       }
-      else {
+      else if (signingKey.empty()) {
         Syslog(LOG_ERR, "Empty signing key");
       }
+      else {
+        FSyslog(LOG_ERR, "Invalid signing key length {}", signingKey.size());
+      }
       return rc;
     }
 
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Signer::Open(const string & signedMessage,
-                      const string & publicKey,
+    bool Signer::Open(string_view signedMessage,
+                      string_view publicKey,
                       string & message)
     {
-      bool      rc = false;
-      size_t    buflen = signedMessage.size() - crypto_sign_BYTES;
-      uint8_t  *buf = (uint8_t *)calloc(1, buflen);
-      if (buf) {
+      bool  rc = false;
+      if (signedMessage.size() < crypto_sign_BYTES) {
+        FSyslog(LOG_ERR, "Signed message too short ({} bytes)",
+                signedMessage.size());
+      }
+      else if (publicKey.size() != crypto_sign_PUBLICKEYBYTES) {
+        FSyslog(LOG_ERR, "Invalid public key length {}", publicKey.size());
+      }
+      else {
+        message.resize(signedMessage.size() - crypto_sign_BYTES);
         unsigned long long  unsignedMsgLen;
-        if (crypto_sign_open(buf, &unsignedMsgLen,
+        if (crypto_sign_open((uint8_t *)message.data(), &unsignedMsgLen,
                              (const uint8_t *)signedMessage.data(),
                              signedMessage.size(),
                              (const uint8_t *)publicKey.data()) == 0) {
-          if (unsignedMsgLen <= buflen) {
-            message.assign((const char *)buf, unsignedMsgLen);
+          if (unsignedMsgLen <= message.size()) {
+            message.resize(unsignedMsgLen);
             rc = true;
           }
           else {
@@ -121,14 +125,90 @@ namespace Dwm {
         else {
           Syslog(LOG_ERR, "crypto_sign_open() failed");
         }
-        free(buf);
+        if (! rc) {
+          message.clear();
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Signer::SignDetached(span<const uint8_t> message,
+                              string_view signingKey,
+                              Signature & signature)
+    {
+      bool  rc = false;
+      if (signingKey.size() == crypto_sign_SECRETKEYBYTES) {
+        if (crypto_sign_detached(signature.data(), nullptr,
+                                 message.data(), message.size(),
+                                 (const uint8_t *)signingKey.data()) == 0) {
+          rc = true;
+        }
+        else {
+          Syslog(LOG_ERR, "crypto_sign_detached() failed");
+        }
+      }
+      else if (signingKey.empty()) {
+        Syslog(LOG_ERR, "Empty signing key");
       }
       else {
-        FSyslog(LOG_ERR, "Failed to allocate {} bytes for message", buflen);
+        FSyslog(LOG_ERR, "Invalid signing key length {}", signingKey.size());
       }
       return rc;
     }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Signer::SignDetached(string_view message,
+                              string_view signingKey,
+                              Signature & signature)
+    {
+      return SignDetached(span<const uint8_t>((const uint8_t *)message.data(),
+                                              message.size()),
+                          signingKey, signature);
+    }
     
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool
+    Signer::VerifyDetached(span<const uint8_t> message,
+                           span<const uint8_t,crypto_sign_BYTES> signature,
+                           string_view publicKey)
+    {
+      bool  rc = false;
+      if (publicKey.size() == crypto_sign_PUBLICKEYBYTES) {
+        if (crypto_sign_verify_detached(signature.data(),
+                                        message.data(), message.size(),
+                                        (const uint8_t *)publicKey.data())
+            == 0) {
+          rc = true;
+        }
+        else {
+          Syslog(LOG_ERR, "crypto_sign_verify_detached() failed");
+        }
+      }
+      else {
+        FSyslog(LOG_ERR, "Invalid public key length {}", publicKey.size());
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool
+    Signer::VerifyDetached(string_view message,
+                           span<const uint8_t,crypto_sign_BYTES> signature,
+                           string_view publicKey)
+    {
+      return VerifyDetached(span<const uint8_t>((const uint8_t *)message.data(),
+                                                message.size()),
+                            signature, publicKey);
+    }
     
   }  // namespace Credence
 
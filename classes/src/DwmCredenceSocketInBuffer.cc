@@ -0,0 +1,211 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSocketInBuffer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SocketInBuffer class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/ioctl.h>
+  #include <sys/socket.h>
+  #include <poll.h>
+}
+
+#include <cerrno>
+#include <cstring>
+#include <thread>
+
+#include "DwmCredenceSocketInBuffer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SocketInBuffer::SocketInBuffer(int fd, string_view pending,
+                                   size_t bufferSize)
+        : _fd(fd), _bufferSize(max(bufferSize, pending.size())),
+          _buffer(new char_type[_bufferSize])
+    {
+      if (! pending.empty()) {
+        memcpy(_buffer.get(), pending.data(), pending.size());
+      }
+      setg(_buffer.get(), _buffer.get(), _buffer.get() + pending.size());
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SocketInBuffer::int_type SocketInBuffer::underflow()
+    {
+      if (gptr() < egptr()) {
+        return traits_type::to_int_type(*gptr());
+      }
+      ssize_t  len = Recv(_buffer.get(), _bufferSize);
+      if (len <= 0) {
+        return traits_type::eof();
+      }
+      setg(_buffer.get(), _buffer.get(), _buffer.get() + len);
+      return traits_type::to_int_type(*gptr());
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    streamsize SocketInBuffer::xsgetn(char_type *s, streamsize n)
+    {
+      streamsize  rc = 0;
+      streamsize  avail = egptr() - gptr();
+      if (avail > 0) {
+        rc = min(avail, n);
+        memcpy(s, gptr(), rc);
+        gbump(rc);
+      }
+      while (rc < n) {
+        streamsize  remaining = n - rc;
+        if (remaining >= (streamsize)_bufferSize) {
+          //  Large read: skip our buffer.
+          ssize_t  len = Recv(s + rc, remaining);
+          if (len <= 0) {
+            break;
+          }
+          rc += len;
+        }
+        else {
+          if (traits_type::eq_int_type(underflow(), traits_type::eof())) {
+            break;
+          }
+          streamsize  chunk = min((streamsize)(egptr() - gptr()), remaining);
+          memcpy(s + rc, gptr(), chunk);
+          gbump(chunk);
+          rc += chunk;
+        }
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    streamsize SocketInBuffer::showmanyc()
+    {
+      return egptr() - gptr();
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ssize_t SocketInBuffer::BytesReady() const
+    {
+      int  pending = 0;
+      if (ioctl(_fd, FIONREAD, &pending) < 0) {
+        return -1;
+      }
+      return Buffered() + pending;
+    }
+
+    //------------------------------------------------------------------------
+    //!  When the socket is empty we sleep in poll().  When it holds part
+    //!  of what we want, poll() would return right away, so we nap
+    //!  briefly instead.
+    //------------------------------------------------------------------------
+    bool SocketInBuffer::WaitForBytesReady(size_t numBytes,
+                                           chrono::milliseconds timeout)
+      const
+    {
+      auto  endTime = chrono::steady_clock::now() + timeout;
+      for (;;) {
+        ssize_t  bytesReady = BytesReady();
+        if (bytesReady < 0) {
+          return false;
+        }
+        if ((size_t)bytesReady >= numBytes) {
+          return true;
+        }
+        auto  remaining = chrono::duration_cast<chrono::milliseconds>
+          (endTime - chrono::steady_clock::now());
+        if (remaining.count() <= 0) {
+          return false;
+        }
+        if ((size_t)bytesReady == Buffered()) {
+          struct pollfd  pfd = { _fd, POLLIN, 0 };
+          int  prc = poll(&pfd, 1, remaining.count());
+          if ((prc < 0) && (EINTR != errno)) {
+            return false;
+          }
+          if ((prc > 0) && (BytesReady() == bytesReady)) {
+            //  Readable but nothing to read: end of file or error.
+            return false;
+          }
+        }
+        else {
+          this_thread::sleep_for(min(remaining, chrono::milliseconds(1)));
+        }
+      }
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    ssize_t SocketInBuffer::Recv(char_type *buf, size_t len)
+    {
+      for (;;) {
+        ssize_t  rc = recv(_fd, buf, len, 0);
+        if (rc >= 0) {
+          return rc;
+        }
+        if (EINTR == errno) {
+          continue;
+        }
+        if ((EAGAIN == errno) || (EWOULDBLOCK == errno)) {
+          struct pollfd  pfd = { _fd, POLLIN, 0 };
+          if ((poll(&pfd, 1, -1) < 0) && (EINTR != errno)) {
+            return -1;
+          }
+          continue;
+        }
+        return -1;
+      }
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
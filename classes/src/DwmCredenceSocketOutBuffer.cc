@@ -0,0 +1,213 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceSocketOutBuffer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SocketOutBuffer class implementation
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/socket.h>
+  #include <sys/uio.h>
+  #include <poll.h>
+}
+
+#include <cerrno>
+#include <cstring>
+
+#include "DwmCredenceSocketOutBuffer.hh"
+
+#ifndef MSG_NOSIGNAL
+  #define MSG_NOSIGNAL 0
+#endif
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SocketOutBuffer::SocketOutBuffer(int fd, size_t bufferSize)
+        : _fd(fd), _bufferSize(max(bufferSize, (size_t)1)),
+          _buffer(new char_type[_bufferSize])
+    {
+      setp(_buffer.get(), _buffer.get() + _bufferSize);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SocketOutBuffer::~SocketOutBuffer()
+    {
+      Drain();
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    SocketOutBuffer::int_type SocketOutBuffer::overflow(int_type c)
+    {
+      if (! Drain()) {
+        return traits_type::eof();
+      }
+      if (! traits_type::eq_int_type(c, traits_type::eof())) {
+        *pptr() = traits_type::to_char_type(c);
+        pbump(1);
+        return c;
+      }
+      return traits_type::not_eof(c);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    streamsize SocketOutBuffer::xsputn(const char_type *s, streamsize n)
+    {
+      streamsize  room = epptr() - pptr();
+      if (n <= room) {
+        memcpy(pptr(), s, n);
+        pbump(n);
+        return n;
+      }
+      //  Doesn't fit.  If it's at least a buffer's worth, send it
+      //  directly along with what's buffered.  Else send what's
+      //  buffered and buffer the new data.
+      if (n >= (streamsize)_bufferSize) {
+        bool  ok = SendAll(pbase(), pptr() - pbase(), s, n);
+        setp(_buffer.get(), _buffer.get() + _bufferSize);
+        return ok ? n : 0;
+      }
+      if (! Drain()) {
+        return 0;
+      }
+      memcpy(pptr(), s, n);
+      pbump(n);
+      return n;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    int SocketOutBuffer::sync()
+    {
+      return Drain() ? 0 : -1;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool SocketOutBuffer::Drain()
+    {
+      bool  rc = SendAll(pbase(), pptr() - pbase());
+      setp(_buffer.get(), _buffer.get() + _bufferSize);
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool SocketOutBuffer::SendAll(const char_type *buf, size_t len)
+    {
+      while (len > 0) {
+        ssize_t  sent = send(_fd, buf, len, MSG_NOSIGNAL);
+        if (sent > 0) {
+          buf += sent;
+          len -= sent;
+        }
+        else if ((sent < 0) && (EINTR == errno)) {
+          continue;
+        }
+        else if ((sent < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))) {
+          struct pollfd  pfd = { _fd, POLLOUT, 0 };
+          if ((poll(&pfd, 1, -1) < 0) && (EINTR != errno)) {
+            return false;
+          }
+        }
+        else {
+          return false;
+        }
+      }
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool SocketOutBuffer::SendAll(const char_type *head, size_t headLen,
+                                  const char_type *buf, size_t len)
+    {
+      struct iovec  iov[2] = { { (void *)head, headLen },
+                               { (void *)buf, len } };
+      struct msghdr  msg;
+      memset(&msg, 0, sizeof(msg));
+      msg.msg_iov = (headLen > 0) ? iov : iov + 1;
+      msg.msg_iovlen = (headLen > 0) ? 2 : 1;
+      while (msg.msg_iovlen > 0) {
+        ssize_t  sent = sendmsg(_fd, &msg, MSG_NOSIGNAL);
+        if (sent > 0) {
+          while ((msg.msg_iovlen > 0)
+                 && (sent >= (ssize_t)msg.msg_iov->iov_len)) {
+            sent -= msg.msg_iov->iov_len;
+            ++msg.msg_iov;
+            --msg.msg_iovlen;
+          }
+          if (msg.msg_iovlen > 0) {
+            msg.msg_iov->iov_base = (char *)msg.msg_iov->iov_base + sent;
+            msg.msg_iov->iov_len -= sent;
+          }
+        }
+        else if ((sent < 0) && (EINTR == errno)) {
+          continue;
+        }
+        else if ((sent < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))) {
+          struct pollfd  pfd = { _fd, POLLOUT, 0 };
+          if ((poll(&pfd, 1, -1) < 0) && (EINTR != errno)) {
+            return false;
+          }
+        }
+        else {
+          return false;
+        }
+      }
+      return true;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -43,8 +43,11 @@ extern "C" {
 #if (defined(__unix__) || defined(unix) || defined(__unix)) || defined(__APPLE__)
   #include <sys/types.h>
   #include <sys/select.h>
+  #include <sys/socket.h>
   #include <unistd.h>
   #include <pwd.h>
+  #include <netinet/in.h>
+  #include <netinet/tcp.h>
   #if defined(__APPLE__)
     #include <uuid/uuid.h>
   #endif
@@ -54,6 +57,7 @@ extern "C" {
   #include <sodium.h>
 }
 
+#include <cerrno>
 #include <cstdlib>
 #include <thread>
 
@@ -89,6 +93,38 @@ namespace Dwm {
     ssize_t Utils::BytesReady(BoostUnixSocket & sck)
     { return ASIO_BytesReady(sck); }
 
+    //------------------------------------------------------------------------
+    template <typename SocketT>
+    bool ASIO_IsConnected(SocketT & sck)
+    {
+      bool  rc = false;
+      if (sck.is_open()) {
+#if (defined(__unix__) || defined(unix) || defined(__unix)) || defined(__APPLE__)
+        //  A peek that returns 0 bytes means the other end closed.
+        char     c;
+        ssize_t  len = ::recv(sck.native_handle(), &c, 1,
+                              MSG_PEEK | MSG_DONTWAIT);
+        if (len > 0) {
+          rc = true;
+        }
+        else if ((len < 0) && ((EAGAIN == errno) || (EWOULDBLOCK == errno))) {
+          rc = true;
+        }
+#else
+        rc = (0 <= ASIO_BytesReady(sck));
+#endif
+      }
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    bool Utils::IsConnected(BoostTcpSocket & sck)
+    { return ASIO_IsConnected(sck); }
+
+    //------------------------------------------------------------------------
+    bool Utils::IsConnected(BoostUnixSocket & sck)
+    { return ASIO_IsConnected(sck); }
+
     //------------------------------------------------------------------------
     template <typename SocketT>
     bool ASIO_WaitUntilBytesReady(SocketT & sck,
@@ -140,7 +176,7 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    string Utils::Bin2Base64(const string & s)
+    string Utils::Bin2Base64(string_view s)
     {
       static const int  variant = sodium_base64_VARIANT_ORIGINAL;
       
@@ -163,7 +199,7 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    string Utils::Base642Bin(const string & s)
+    string Utils::Base642Bin(string_view s)
     {
       static const int  variant = sodium_base64_VARIANT_ORIGINAL;
       string  rc;
@@ -227,6 +263,21 @@ namespace Dwm {
       return rc;
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    string Utils::ExpandTilde(const string & path)
+    {
+      string  rc(path);
+      if ((rc.size() > 1) && ('~' == rc[0]) && ('/' == rc[1])) {
+        string  homeDir = UserHomeDirectory();
+        if (! homeDir.empty()) {
+          rc.replace(0, 1, homeDir);
+        }
+      }
+      return rc;
+    }
+
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
@@ -281,18 +332,24 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    bool Utils::ScalarMult(const std::string & sk, const std::string & pk,
+    bool Utils::ScalarMult(std::string_view sk, std::string_view pk,
                            std::string & q)
     {
       bool     rc = false;
       uint8_t  qbuf[crypto_scalarmult_BYTES];
-      if (crypto_scalarmult(qbuf, (const uint8_t *)sk.data(),
-                            (const uint8_t *)pk.data()) == 0) {
-        q.assign((const char *)qbuf, sizeof(qbuf));
-        rc = true;
+      q.clear();
+      if ((sk.size() == crypto_scalarmult_SCALARBYTES)
+          && (pk.size() == crypto_scalarmult_BYTES)) {
+        if (crypto_scalarmult(qbuf, (const uint8_t *)sk.data(),
+                              (const uint8_t *)pk.data()) == 0) {
+          q.assign((const char *)qbuf, sizeof(qbuf));
+          sodium_memzero(qbuf, sizeof(qbuf));
+          rc = true;
+        }
       }
       else {
-        q.clear();
+        FSyslog(LOG_ERR, "Invalid key length(s) {},{} for scalar mult",
+                sk.size(), pk.size());
       }
       return rc;
     }
@@ -307,6 +364,65 @@ namespace Dwm {
               + std::to_string(endPoint.port()));
     }
 
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Utils::EnableTcpFastOpen(boost::asio::ip::tcp::acceptor & acceptor,
+                                  int queueLength)
+    {
+      bool  rc = false;
+#if defined(TCP_FASTOPEN)
+      using FastOpen =
+        boost::asio::detail::socket_option::integer<IPPROTO_TCP,
+                                                    TCP_FASTOPEN>;
+  #if defined(__APPLE__)
+      //  macOS only accepts a boolean here.
+      FastOpen  option(1);
+      (void)queueLength;
+  #else
+      FastOpen  option(queueLength);
+  #endif
+      boost::system::error_code  ec;
+      acceptor.set_option(option, ec);
+      if (! ec) {
+        rc = true;
+      }
+      else {
+        FSyslog(LOG_WARNING, "Failed to enable TCP Fast Open on acceptor:"
+                " {}", ec.message());
+      }
+#else
+      Syslog(LOG_DEBUG, "TCP Fast Open not supported on this platform");
+#endif
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool Utils::EnableTcpFastOpenConnect(BoostTcpSocket & sck)
+    {
+      bool  rc = false;
+#if defined(TCP_FASTOPEN_CONNECT)
+      using FastOpenConnect =
+        boost::asio::detail::socket_option::integer<IPPROTO_TCP,
+                                                    TCP_FASTOPEN_CONNECT>;
+      boost::system::error_code  ec;
+      sck.set_option(FastOpenConnect(1), ec);
+      if (! ec) {
+        rc = true;
+      }
+      else {
+        FSyslog(LOG_DEBUG, "Failed to enable TCP Fast Open on socket: {}",
+                ec.message());
+      }
+#else
+      Syslog(LOG_DEBUG, "Client TCP Fast Open not supported on this"
+             " platform");
+#endif
+      return rc;
+    }
+
   }  // namespace Credence
 
 }  // namespace Dwm
@@ -0,0 +1,250 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file DwmCredenceWriteBehindQueue.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::WriteBehindQueue class implementation
+//---------------------------------------------------------------------------
+
+#include <memory>
+
+#include "DwmSysLogger.hh"
+#include "DwmCredenceWriteBehindQueue.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    using namespace std;
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    WriteBehindQueue::WriteBehindQueue(std::ostream & os,
+                                       const Config & config,
+                                       const string & peerName)
+        : _os(os), _config(config), _peerName(peerName), _mtx(),
+          _notEmpty(), _notFull(), _queue(), _depth(0), _bytes(0),
+          _run(true), _failed(false), _stats(), _writer()
+    {
+      _writer = std::thread(&WriteBehindQueue::WriterLoop, this);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    WriteBehindQueue::~WriteBehindQueue()
+    {
+      Stop(false);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool WriteBehindQueue::Push(string && msg, Callback callback)
+    {
+      size_t            msgSize = msg.size();
+      Clock::time_point now = Clock::now();
+      unique_lock<mutex>  lk(_mtx);
+      if (_run && (! _failed) && (! HasRoom(msgSize))
+          && (FullPolicy::e_block == _config.fullPolicy)) {
+        _notFull.wait(lk, [&] {
+          return ((! _run) || _failed || HasRoom(msgSize));
+        });
+        Clock::time_point  woke = Clock::now();
+        _stats.totalBlocked +=
+          chrono::duration_cast<chrono::microseconds>(woke - now);
+        now = woke;
+      }
+      if ((! _run) || _failed || (! HasRoom(msgSize))) {
+        ++_stats.rejected;
+        lk.unlock();
+        if (callback) {
+          callback(false);
+        }
+        return false;
+      }
+      ++_depth;
+      _bytes += msgSize;
+      ++_stats.queued;
+      if (_depth > _stats.maxDepth) {
+        _stats.maxDepth = _depth;
+      }
+      _queue.push_back(Entry{std::move(msg), std::move(callback), now});
+      _notEmpty.notify_one();
+      return true;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    future<bool> WriteBehindQueue::Push(string && msg)
+    {
+      auto  promised = make_shared<promise<bool>>();
+      future<bool>  rc = promised->get_future();
+      Push(std::move(msg), [promised] (bool ok) { promised->set_value(ok); });
+      return rc;
+    }
+    
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void WriteBehindQueue::Stop(bool drain)
+    {
+      deque<Entry>  discarded;
+      {
+        lock_guard<mutex>  lk(_mtx);
+        if (! drain) {
+          discarded.swap(_queue);
+          for (const auto & entry : discarded) {
+            --_depth;
+            _bytes -= entry.msg.size();
+          }
+          _stats.failed += discarded.size();
+        }
+        _run = false;
+        _notEmpty.notify_all();
+        _notFull.notify_all();
+      }
+      Complete(discarded, false);
+      if (_writer.joinable()) {
+        _writer.join();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    WriteBehindQueue::Counters WriteBehindQueue::Stats() const
+    {
+      lock_guard<mutex>  lk(_mtx);
+      Counters  rc = _stats;
+      rc.depth = _depth;
+      rc.bytes = _bytes;
+      return rc;
+    }
+
+    //------------------------------------------------------------------------
+    //!  An empty queue always has room, so a message bigger than the
+    //!  byte limit can't wait forever.
+    //------------------------------------------------------------------------
+    bool WriteBehindQueue::HasRoom(size_t msgSize) const
+    {
+      return ((0 == _depth)
+              || ((_depth < _config.maxMessages)
+                  && ((_bytes + msgSize) <= _config.maxBytes)));
+    }
+    
+    //------------------------------------------------------------------------
+    //!  Messages being written still count against the limits until
+    //!  they're done, so the limits bound everything not yet on the wire.
+    //------------------------------------------------------------------------
+    void WriteBehindQueue::WriterLoop()
+    {
+      unique_lock<mutex>  lk(_mtx);
+      for (;;) {
+        _notEmpty.wait(lk, [&] { return ((! _queue.empty()) || (! _run)); });
+        if (_queue.empty()) {
+          break;
+        }
+        deque<Entry>  batch;
+        batch.swap(_queue);
+        bool  failed = _failed;
+        lk.unlock();
+        
+        bool  ok = ((! failed) && Write(batch));
+        Clock::time_point  now = Clock::now();
+        
+        lk.lock();
+        if ((! ok) && (! _failed)) {
+          FSyslog(LOG_ERR, "Write-behind send to {} failed", _peerName);
+          _failed = true;
+        }
+        ++_stats.flushes;
+        for (const auto & entry : batch) {
+          --_depth;
+          _bytes -= entry.msg.size();
+          auto  wait =
+            chrono::duration_cast<chrono::microseconds>(now - entry.queued);
+          _stats.totalWait += wait;
+          if (wait > _stats.maxWait) {
+            _stats.maxWait = wait;
+          }
+        }
+        if (ok) {
+          _stats.sent += batch.size();
+        }
+        else {
+          _stats.failed += batch.size();
+        }
+        _notFull.notify_all();
+        lk.unlock();
+        Complete(batch, ok);
+        lk.lock();
+      }
+      return;
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    bool WriteBehindQueue::Write(deque<Entry> & batch)
+    {
+      for (const auto & entry : batch) {
+        if (! _os.write(entry.msg.data(), entry.msg.size())) {
+          return false;
+        }
+      }
+      return (_os.flush() ? true : false);
+    }
+
+    //------------------------------------------------------------------------
+    //!  
+    //------------------------------------------------------------------------
+    void WriteBehindQueue::Complete(deque<Entry> & batch, bool ok)
+    {
+      for (auto & entry : batch) {
+        if (entry.callback) {
+          entry.callback(ok);
+        }
+      }
+      return;
+    }
+    
+  }  // namespace Credence
+
+}  // namespace Dwm
@@ -57,7 +57,9 @@ namespace Dwm {
       uint8_t  pk[crypto_box_PUBLICKEYBYTES], sk[crypto_box_SECRETKEYBYTES];
       crypto_box_keypair(pk, sk);
       _publicKey.assign((const char *)pk, crypto_box_PUBLICKEYBYTES);
-      _secretKey.assign((const char *)sk, crypto_box_SECRETKEYBYTES);
+      _secretKey = std::string_view((const char *)sk,
+                                    crypto_box_SECRETKEYBYTES);
+      sodium_memzero(sk, sizeof(sk));
     }
 
     //------------------------------------------------------------------------
@@ -83,9 +85,10 @@ namespace Dwm {
       uint8_t         x25519_sk[crypto_scalarmult_curve25519_BYTES];
       const uint8_t  *edkp_sk = (const uint8_t *)edkp.SecretKey().Key().data();
       if (crypto_sign_ed25519_sk_to_curve25519(x25519_sk, edkp_sk) == 0) {
-        _secretKey.assign((const char *)x25519_sk,
-                          crypto_scalarmult_curve25519_BYTES);
+        _secretKey = std::string_view((const char *)x25519_sk,
+                                      crypto_scalarmult_curve25519_BYTES);
       }
+      sodium_memzero(x25519_sk, sizeof(x25519_sk));
     }
     
     //------------------------------------------------------------------------
@@ -99,9 +102,9 @@ namespace Dwm {
     //------------------------------------------------------------------------
     //!  
     //------------------------------------------------------------------------
-    const std::string & X25519KeyPair::SecretKey() const
+    std::string_view X25519KeyPair::SecretKey() const
     {
-      return _secretKey;
+      return _secretKey.Value();
     }
 
     //------------------------------------------------------------------------
@@ -111,8 +114,7 @@ namespace Dwm {
     {
       _publicKey.assign(_publicKey.size(), '\0');
       _publicKey.clear();
-      _secretKey.assign(_secretKey.size(), '\0');
-      _secretKey.clear();
+      _secretKey.Clear();
       return;
     }
     
@@ -58,7 +58,7 @@ namespace Dwm {
       //!  
       //----------------------------------------------------------------------
       bool Encrypt(string & cipherText, const string & message,
-                   const Nonce & nonce, const string & secretKey)
+                   const Nonce & nonce, string_view secretKey)
       {
         constexpr auto  xcc20p1305enc =
           crypto_aead_xchacha20poly1305_ietf_encrypt;
@@ -95,7 +95,7 @@ namespace Dwm {
       //!  
       //----------------------------------------------------------------------
       bool Decrypt(string & message, const string & cipherText,
-                   const Nonce & nonce, const string & secretKey)
+                   const Nonce & nonce, string_view secretKey)
       {
         constexpr auto  xcc20p1305dec =
           crypto_aead_xchacha20poly1305_ietf_decrypt;
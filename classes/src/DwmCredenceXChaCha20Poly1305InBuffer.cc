@@ -83,11 +83,11 @@ namespace Dwm {
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
-      InBuffer::InBuffer(std::istream & is, const std::string & key)
-          : _is(is)
+      InBuffer::InBuffer(std::istream & is, std::string_view key)
+          : _is(&is), _plaintext(false)
       {
         if (crypto_generichash_BYTES <= key.size()) {
-          _key = key;
+          _key = key.substr(0, _key.Size());
         }
         else {
           throw std::logic_error("Key not long enough!");
@@ -117,6 +117,9 @@ namespace Dwm {
       //----------------------------------------------------------------------
       int InBuffer::Reload()
       {
+        if (_plaintext) {
+          return ReloadPlaintext();
+        }
         int  rc = -1;
         Nonce   nonce;
         string  cipherText;
@@ -146,7 +149,7 @@ namespace Dwm {
           }
         }
         else {
-          if (! _is.eof()) {
+          if (! _is->eof()) {
             Syslog(LOG_ERR, "Failed to read message");
           }
           throw std::ios_base::failure("Failed to read message");
@@ -157,6 +160,38 @@ namespace Dwm {
         return rc;
       }
 
+      //----------------------------------------------------------------------
+      //!  We never write empty frames, so an empty one is as invalid as
+      //!  one that's too long.
+      //----------------------------------------------------------------------
+      int InBuffer::ReloadPlaintext()
+      {
+        uint64_t  msgLen;
+        if (! _is->read((char *)&msgLen, sizeof(msgLen))) {
+          setg(0, 0, 0);
+          if (! _is->eof()) {
+            Syslog(LOG_ERR, "Failed to read message length");
+          }
+          throw std::ios_base::failure("Failed to read message");
+        }
+        msgLen = be64toh(msgLen);
+        if ((0 == msgLen) || (msgLen > _maxMessageLength)) {
+          setg(0, 0, 0);
+          FSyslog(LOG_ERR, "Invalid message length {}", msgLen);
+          throw std::ios_base::failure("Invalid message length");
+        }
+        //  make_unique will throw on failure; the istream catches it and
+        //  sets badbit.
+        _buffer = std::make_unique<char_type[]>(msgLen);
+        if (! _is->read(_buffer.get(), msgLen)) {
+          setg(0, 0, 0);
+          Syslog(LOG_DEBUG, "Failed to read message");
+          throw std::ios_base::failure("Failed to read message");
+        }
+        setg(_buffer.get(), _buffer.get(), _buffer.get() + msgLen);
+        return msgLen;
+      }
+      
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
@@ -164,14 +199,14 @@ namespace Dwm {
                                             std::string & cipherText)
       {
         bool  rc = false;
-        if (nonce.Read(_is)) {
+        if (nonce.Read(*_is)) {
           uint64_t  msgLen;
-          if (_is.read((char *)&msgLen, sizeof(msgLen))) {
+          if (_is->read((char *)&msgLen, sizeof(msgLen))) {
             msgLen = be64toh(msgLen);
             if (msgLen <= _maxMessageLength) {
               try {
                 cipherText.resize(msgLen);
-                if (_is.read(cipherText.data(), msgLen)) {
+                if (_is->read(cipherText.data(), msgLen)) {
                   rc = true;
                 }
                 else {
@@ -191,7 +226,7 @@ namespace Dwm {
           }
         }
         else {
-          if (! (_is.eof())) {
+          if (! (_is->eof())) {
             Syslog(LOG_ERR, "Failed to read nonce");
           }
         }
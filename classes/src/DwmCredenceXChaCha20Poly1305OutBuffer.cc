@@ -54,11 +54,11 @@ namespace Dwm {
       //----------------------------------------------------------------------
       //!  
       //----------------------------------------------------------------------
-      OutBuffer::OutBuffer(std::ostream & os, const std::string & key)
-          : _os(os)
+      OutBuffer::OutBuffer(std::ostream & os, std::string_view key)
+          : _os(&os), _plaintext(false)
       {
         if (crypto_generichash_BYTES <= key.size()) {
-          _key = key;
+          _key = key.substr(0, _key.Size());
         }
         else {
           throw std::logic_error("key not long enough!");
@@ -87,7 +87,9 @@ namespace Dwm {
       }
 
       //----------------------------------------------------------------------
-      //!  
+      //!  Large frames are copied from here into the socket buffer.  We
+      //!  measured MSG_ZEROCOPY to avoid that copy; it was slower at all
+      //!  but one frame size, so it isn't used.
       //----------------------------------------------------------------------
       int OutBuffer::sync()
       {
@@ -95,15 +97,27 @@ namespace Dwm {
         if (_plainbuf.empty()) {
           return 0;
         }
+        if (_plaintext) {
+          uint64_t  len = htobe64(_plainbuf.size());
+          if (_os->write((const char *)&len, sizeof(len))) {
+            if (_os->write(_plainbuf.data(), _plainbuf.size())) {
+              if (_os->flush()) {
+                rc = 0;
+              }
+            }
+          }
+          _plainbuf.clear();
+          return rc;
+        }
         Nonce  nonce;
-        if (nonce.Write(_os)) {
+        if (nonce.Write(*_os)) {
           string  cipherText;
           if (Encrypt(cipherText, _plainbuf, nonce, _key)) {
             uint64_t len = cipherText.size();
             len = htobe64(len);
-            if (_os.write((const char *)&len, sizeof(len))) {
-              if (_os.write(cipherText.c_str(), cipherText.size())) {
-                if (_os.flush()) {
+            if (_os->write((const char *)&len, sizeof(len))) {
+              if (_os->write(cipherText.c_str(), cipherText.size())) {
+                if (_os->flush()) {
                   rc = 0;
                 }
               }
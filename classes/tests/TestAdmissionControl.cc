@@ -0,0 +1,180 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestAdmissionControl.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::AdmissionControl unit tests
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <thread>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceAdmissionControl.hh"
+
+using namespace std;
+using namespace Dwm;
+
+using Verdict = Credence::AdmissionControl::Verdict;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static boost::asio::ip::address Addr(const char *s)
+{
+  return boost::asio::ip::make_address(s);
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestAllowedClients()
+{
+  Credence::AdmissionControl  ac;
+  UnitAssert(ac.IsAllowed(Addr("192.0.2.1")));
+  UnitAssert(ac.IsAllowed(Addr("2001:db8::1")));
+
+  set<IpPrefix>  allowed;
+  allowed.insert(IpPrefix("192.168.0.0/16"));
+  allowed.insert(IpPrefix("10.1.2.0/23"));
+  allowed.insert(IpPrefix("2001:db8:1::/48"));
+  ac.AllowedClients(allowed);
+  UnitAssert(ac.IsAllowed(Addr("192.168.100.1")));
+  UnitAssert(ac.IsAllowed(Addr("10.1.3.255")));
+  UnitAssert(! ac.IsAllowed(Addr("10.1.4.0")));
+  UnitAssert(! ac.IsAllowed(Addr("192.169.0.1")));
+  UnitAssert(ac.IsAllowed(Addr("::ffff:192.168.1.1")));
+  UnitAssert(ac.IsAllowed(Addr("2001:db8:1:ffff::1")));
+  UnitAssert(! ac.IsAllowed(Addr("2001:db8:2::1")));
+
+  Credence::AdmissionControl::Ticket  ticket;
+  UnitAssert(ac.Admit(Addr("192.169.0.1"), ticket) == Verdict::e_notAllowed);
+  UnitAssert(! ticket.Held());
+  UnitAssert(ac.Admit(Addr("192.168.0.1"), ticket) == Verdict::e_admitted);
+  UnitAssert(ticket.Held());
+  UnitAssert(ac.Stats().notAllowed == 1);
+  UnitAssert(ac.Stats().admitted == 1);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestRateLimit()
+{
+  Credence::AdmissionControl  ac;
+  ac.SetRate(10, 3);
+  Credence::AdmissionControl::Ticket  ticket;
+  for (int i = 0; i < 3; ++i) {
+    UnitAssert(ac.Admit(Addr("192.0.2.1"), ticket) == Verdict::e_admitted);
+  }
+  UnitAssert(ac.Admit(Addr("192.0.2.1"), ticket) == Verdict::e_rateLimited);
+  UnitAssert(! ticket.Held());
+  UnitAssert(ac.ActiveHandshakes() == 0);
+  
+  //  A different source has its own bucket.
+  UnitAssert(ac.Admit(Addr("192.0.2.2"), ticket) == Verdict::e_admitted);
+
+  //  IPv6 sources in the same /64 share a bucket.
+  for (int i = 0; i < 3; ++i) {
+    UnitAssert(ac.Admit(Addr("2001:db8::1"), ticket) == Verdict::e_admitted);
+  }
+  UnitAssert(ac.Admit(Addr("2001:db8::2"), ticket)
+             == Verdict::e_rateLimited);
+  UnitAssert(ac.NumSources() == 3);
+  
+  //  Tokens refill over time.
+  this_thread::sleep_for(chrono::milliseconds(250));
+  UnitAssert(ac.Admit(Addr("192.0.2.1"), ticket) == Verdict::e_admitted);
+
+  //  When the source table is full, idle sources are dropped.  If none
+  //  are idle, new sources are rate limited.
+  Credence::AdmissionControl  ac2;
+  ac2.SetRate(10, 3);
+  ac2.SetMaxSources(1);
+  UnitAssert(ac2.Admit(Addr("192.0.2.3"), ticket) == Verdict::e_admitted);
+  UnitAssert(ac2.Admit(Addr("192.0.2.4"), ticket)
+             == Verdict::e_rateLimited);
+  this_thread::sleep_for(chrono::milliseconds(350));
+  UnitAssert(ac2.Admit(Addr("192.0.2.4"), ticket) == Verdict::e_admitted);
+  UnitAssert(ac2.NumSources() == 1);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestHandshakeLimit()
+{
+  Credence::AdmissionControl  ac;
+  ac.SetMaxHandshakes(2);
+  Credence::AdmissionControl::Ticket  t1, t2, t3;
+  UnitAssert(ac.Admit(Addr("192.0.2.1"), t1) == Verdict::e_admitted);
+  UnitAssert(ac.Admit(t2) == Verdict::e_admitted);
+  UnitAssert(ac.ActiveHandshakes() == 2);
+  UnitAssert(ac.Admit(Addr("192.0.2.1"), t3) == Verdict::e_handshakeLimit);
+  UnitAssert(ac.Admit(t3) == Verdict::e_handshakeLimit);
+  t1.Release();
+  UnitAssert(ac.ActiveHandshakes() == 1);
+  UnitAssert(ac.Admit(t3) == Verdict::e_admitted);
+  {
+    Credence::AdmissionControl::Ticket  t4(std::move(t3));
+    UnitAssert(! t3.Held());
+    UnitAssert(ac.ActiveHandshakes() == 2);
+  }
+  UnitAssert(ac.ActiveHandshakes() == 1);
+  UnitAssert(ac.Stats().handshakeLimit == 2);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  TestAllowedClients();
+  TestRateLimit();
+  TestHandshakeLimit();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -41,6 +41,7 @@
 
 #include <sstream>
 
+#include "DwmStreamIO.hh"
 #include "DwmSysLogger.hh"
 #include "DwmUnitAssert.hh"
 #include "DwmCredenceChallengeResponse.hh"
@@ -70,6 +71,50 @@ static void TestIO()
   return;
 }
 
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestDetached()
+{
+  Credence::Ed25519KeyPair  keyPair("dwm");
+
+  //  New challenges advertise detached responses.
+  Credence::Challenge  challenge(true);
+  UnitAssert(challenge.AcceptsDetached());
+  Credence::ChallengeResponse  response;
+  UnitAssert(response.Create(keyPair.SecretKey(), challenge));
+  UnitAssert(response.Detached());
+  stringstream  ss;
+  UnitAssert(response.Write(ss));
+  Credence::ChallengeResponse  response2;
+  UnitAssert(response2.Read(ss));
+  UnitAssert(response2.Detached());
+  UnitAssert(response2.Verify(keyPair.PublicKey(), challenge));
+  Credence::Challenge  otherChallenge(true);
+  UnitAssert(! response2.Verify(keyPair.PublicKey(), otherChallenge));
+
+  //  Challenges from older peers get a combined-mode response.
+  Credence::Challenge  oldChallenge(true, false);
+  UnitAssert(! oldChallenge.AcceptsDetached());
+  Credence::ChallengeResponse  oldResponse;
+  UnitAssert(oldResponse.Create(keyPair.SecretKey(), oldChallenge));
+  UnitAssert(! oldResponse.Detached());
+  UnitAssert(oldResponse.Verify(keyPair.PublicKey(), oldChallenge));
+
+  //  An older peer signs our challenge in combined mode, and we still
+  //  verify it.
+  string  signedChallenge;
+  UnitAssert(Credence::Signer::Sign(challenge, keyPair.SecretKey().Key(),
+                                    signedChallenge));
+  stringstream  oss;
+  UnitAssert(StreamIO::Write(oss, signedChallenge));
+  Credence::ChallengeResponse  oldPeerResponse;
+  UnitAssert(oldPeerResponse.Read(oss));
+  UnitAssert(! oldPeerResponse.Detached());
+  UnitAssert(oldPeerResponse.Verify(keyPair.PublicKey(), challenge));
+  return;
+}
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -90,6 +135,7 @@ int main(int argc, char *argv[])
   }
 
   TestIO();
+  TestDetached();
   
   if (Assertions::Total().Failed()) {
     Assertions::Print(cerr, true);
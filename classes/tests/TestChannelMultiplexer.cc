@@ -0,0 +1,216 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestChannelMultiplexer.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::ChannelMultiplexer
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceChannelMultiplexer.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7792;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestBasics(Credence::ChannelMultiplexer & client,
+                Credence::ChannelMultiplexer & server)
+{
+  string  msg;
+  UnitAssert(client.Send(0, "hello"));
+  UnitAssert(client.Send(7, "seven"));
+  UnitAssert(client.Send(7, ""));
+  if (UnitAssert(server.Receive(7, msg))) {
+    UnitAssert(msg == "seven");
+  }
+  if (UnitAssert(server.Receive(7, msg))) {
+    UnitAssert(msg.empty());
+  }
+  if (UnitAssert(server.Receive(0, msg))) {
+    UnitAssert(msg == "hello");
+  }
+  UnitAssert(! server.Receive(0, msg, std::chrono::milliseconds(50)));
+
+  //  A message much larger than the window.
+  string  big(4 * client.Window() + 1234, '\0');
+  for (size_t i = 0; i < big.size(); ++i) {
+    big[i] = (char)(i * 7);
+  }
+  std::thread  sender([&] { UnitAssert(client.Send(1, big)); });
+  if (UnitAssert(server.Receive(1, msg))) {
+    UnitAssert(msg == big);
+  }
+  sender.join();
+
+  big.assign(client.MaxMessageSize() + 1, 'x');
+  UnitAssert(! client.Send(1, big));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Messages nobody receives on one channel stall only that channel.
+//----------------------------------------------------------------------------
+void TestFlowControl(Credence::ChannelMultiplexer & client,
+                     Credence::ChannelMultiplexer & server)
+{
+  const size_t       msgSize = client.ChunkSize();
+  const size_t       numMsgs = 4 * (client.Window() / msgSize);
+  std::atomic<size_t>  numSent = 0;
+  std::thread  sender([&] {
+    string  msg(msgSize, 'b');
+    for (size_t i = 0; i < numMsgs; ++i) {
+      if (! client.Send(2, msg)) {
+        break;
+      }
+      ++numSent;
+    }
+  });
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  UnitAssert(numSent <= (client.Window() / msgSize));
+
+  client.SetPriority(0, 10);
+  string  msg;
+  for (int i = 0; i < 100; ++i) {
+    UnitAssert(client.Send(0, "ping"));
+    if (UnitAssert(server.Receive(0, msg, std::chrono::milliseconds(1000)))) {
+      UnitAssert(msg == "ping");
+    }
+  }
+  
+  for (size_t i = 0; i < numMsgs; ++i) {
+    if (UnitAssert(server.Receive(2, msg))) {
+      UnitAssert(msg.size() == msgSize);
+    }
+  }
+  sender.join();
+  UnitAssert(numSent == numMsgs);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Stops the client while the writer is blocked sending the only (and
+//!  hence last) chunk of a message the server never reads.  Send() must
+//!  not return until the writer is done with its message.
+//----------------------------------------------------------------------------
+void TestStopDuringSend(Credence::Peer & clientPeer)
+{
+  const uint32_t  msgSize = 32 * 1024 * 1024;
+  Credence::ChannelMultiplexer  client(clientPeer, msgSize, msgSize, msgSize);
+  if (UnitAssert(client.Start())) {
+    std::atomic<bool>  sent = true;
+    std::thread  sender([&] {
+      string  msg(msgSize, 's');
+      sent = client.Send(5, msg);
+    });
+    std::this_thread::sleep_for(std::chrono::milliseconds(200));
+    client.Stop();
+    sender.join();
+    UnitAssert(! sent);
+    UnitAssert(client.Closed());
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestChannelMultiplexer", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  serverPeer;
+  Credence::Peer  clientPeer;
+  bool  authenticated =
+    Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port);
+  
+  if (authenticated) {
+    Credence::ChannelMultiplexer  client(clientPeer, 256 * 1024, 16 * 1024,
+                                         2 * 1024 * 1024);
+    Credence::ChannelMultiplexer  server(serverPeer, 256 * 1024, 16 * 1024,
+                                         2 * 1024 * 1024);
+    if (UnitAssert(client.Start() && server.Start())) {
+      TestBasics(client, server);
+      TestFlowControl(client, server);
+
+      client.Stop();
+      UnitAssert(! client.Send(0, "stopped"));
+      string  msg;
+      UnitAssert(! server.Receive(0, msg));
+      UnitAssert(server.Closed());
+    }
+  }
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+
+  if (Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port)) {
+    TestStopDuringSend(clientPeer);
+  }
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
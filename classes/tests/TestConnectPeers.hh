@@ -0,0 +1,122 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestConnectPeers.hh
+//!  \author Daniel W. McRobb
+//!  \brief Helpers to connect and authenticate a pair of Peers over TCP
+//!    on the loopback interface, for unit tests
+//---------------------------------------------------------------------------
+
+#ifndef _TESTCONNECTPEERS_HH_
+#define _TESTCONNECTPEERS_HH_
+
+#include <atomic>
+#include <functional>
+#include <thread>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    namespace Test {
+
+      //----------------------------------------------------------------------
+      //!  Accepts one connection on 127.0.0.1:@c port into @c peer and
+      //!  authenticates it with the keys in ./inputs.  Sets @c listening
+      //!  once the listening socket is ready, and @c authenticated on
+      //!  success.
+      //----------------------------------------------------------------------
+      inline void ServerThread(Peer & peer, uint16_t port,
+                               std::atomic<bool> & listening,
+                               std::atomic<bool> & authenticated)
+      {
+        using namespace boost::asio;
+
+        io_context                 ioContext;
+        boost::system::error_code  ec;
+        ip::tcp::endpoint  endPoint(ip::address::from_string("127.0.0.1"),
+                                    port);
+        ip::tcp::acceptor  acc(ioContext);
+        acc.open(endPoint.protocol());
+        acc.set_option(ip::tcp::acceptor::reuse_address(true), ec);
+        acc.bind(endPoint);
+        acc.listen();
+        listening = true;
+        ip::tcp::socket  sock(ioContext);
+        acc.accept(sock, ec);
+        if (UnitAssert(! ec)) {
+          if (UnitAssert(peer.Accept(std::move(sock)))) {
+            KeyStash   keyStash("./inputs");
+            KnownKeys  knownKeys("./inputs");
+            authenticated = UnitAssert(peer.Authenticate(keyStash,
+                                                         knownKeys));
+          }
+        }
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Connects @c clientPeer to @c serverPeer through 127.0.0.1:@c port
+      //!  and authenticates both ends.  Returns true on success.
+      //----------------------------------------------------------------------
+      inline bool ConnectPeers(Peer & clientPeer, Peer & serverPeer,
+                               uint16_t port)
+      {
+        std::atomic<bool>  listening = false;
+        std::atomic<bool>  authenticated = false;
+        std::thread  serverThread(ServerThread, std::ref(serverPeer), port,
+                                  std::ref(listening),
+                                  std::ref(authenticated));
+        while (! listening) { }
+        if (UnitAssert(clientPeer.Connect("127.0.0.1", port))) {
+          KeyStash   keyStash("./inputs");
+          KnownKeys  knownKeys("./inputs");
+          UnitAssert(clientPeer.Authenticate(keyStash, knownKeys));
+        }
+        serverThread.join();
+        return authenticated;
+      }
+      
+    }  // namespace Test
+
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _TESTCONNECTPEERS_HH_
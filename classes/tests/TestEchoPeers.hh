@@ -0,0 +1,168 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+
+//---------------------------------------------------------------------------
+//!  \file TestEchoPeers.hh
+//!  \author Daniel W. McRobb
+//!  \brief Helpers to connect and authenticate a pair of Peers over a
+//!    UNIX domain socket and echo messages between them, for unit tests
+//---------------------------------------------------------------------------
+
+#ifndef _TESTECHOPEERS_HH_
+#define _TESTECHOPEERS_HH_
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <string>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+
+namespace Dwm {
+
+  namespace Credence {
+
+    namespace Test {
+
+      //----------------------------------------------------------------------
+      //!  Authenticates @c peer with the keys in ./inputs.  Returns true
+      //!  on success.
+      //----------------------------------------------------------------------
+      inline bool AuthenticatePeer(Peer & peer)
+      {
+        KeyStash   keyStash("./inputs");
+        KnownKeys  knownKeys("./inputs");
+        return UnitAssert(peer.Authenticate(keyStash, knownKeys));
+      }
+
+      //----------------------------------------------------------------------
+      //!  Returns the @c i'th echo test message.  Most are short; every
+      //!  tenth is 1 to 4 times @c bigLen bytes.
+      //----------------------------------------------------------------------
+      inline std::string EchoMessage(uint32_t i, size_t bigLen)
+      {
+        size_t  len = (i % 10) ? (i % 200) : (bigLen * (1 + (i % 4)));
+        return std::string(len, (char)('a' + (i % 26)));
+      }
+
+      //----------------------------------------------------------------------
+      //!  Sends back every message received on @c peer until the other
+      //!  end disconnects, counting them in @c numEchoed.
+      //----------------------------------------------------------------------
+      inline void EchoUntilDisconnected(Peer & peer,
+                                        std::atomic<uint32_t> & numEchoed)
+      {
+        std::string  msg;
+        while (peer.Receive(msg) && peer.Send(msg)) {
+          ++numEchoed;
+        }
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Sends @c numMessages messages (see EchoMessage()) on @c peer and
+      //!  checks that each comes back unchanged.
+      //----------------------------------------------------------------------
+      inline void TestEcho(Peer & peer, uint32_t numMessages, size_t bigLen)
+      {
+        uint32_t     numGood = 0;
+        std::string  reply;
+        for (uint32_t i = 0; i < numMessages; ++i) {
+          std::string  msg = EchoMessage(i, bigLen);
+          if (peer.Send(msg) && peer.Receive(reply) && (reply == msg)) {
+            ++numGood;
+          }
+        }
+        UnitAssert(numMessages == numGood);
+        UnitAssert(peer.ReceiveWouldBlock(1));
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Accepts one connection on the UNIX domain socket @c sockPath and
+      //!  authenticates it.  Then calls @c setup with the peer and echoes
+      //!  messages until the client disconnects.  Sets @c listening once
+      //!  the listening socket is ready.
+      //----------------------------------------------------------------------
+      inline void UnixServerThread(const std::string & sockPath,
+                                   std::function<void(Peer &)> setup,
+                                   std::atomic<bool> & listening,
+                                   std::atomic<uint32_t> & numEchoed)
+      {
+        using namespace boost::asio;
+
+        io_context                 ioContext;
+        boost::system::error_code  ec;
+        unlink(sockPath.c_str());
+        local::stream_protocol::endpoint  endPoint(sockPath);
+        local::stream_protocol::acceptor  acc(ioContext, endPoint);
+        listening = true;
+        local::stream_protocol::socket    sock(ioContext);
+        acc.accept(sock, ec);
+        if (UnitAssert(! ec)) {
+          Peer  peer;
+          if (UnitAssert(peer.Accept(std::move(sock)))) {
+            if (AuthenticatePeer(peer)) {
+              setup(peer);
+              EchoUntilDisconnected(peer, numEchoed);
+            }
+          }
+        }
+        return;
+      }
+
+      //----------------------------------------------------------------------
+      //!  Connects @c peer to the UNIX domain socket @c sockPath and
+      //!  authenticates it.  Returns true on success.
+      //----------------------------------------------------------------------
+      inline bool ConnectUnix(Peer & peer, const std::string & sockPath)
+      {
+        return (UnitAssert(peer.Connect(sockPath))
+                && AuthenticatePeer(peer));
+      }
+      
+    }  // namespace Test
+
+  }  // namespace Credence
+
+}  // namespace Dwm
+
+#endif  // _TESTECHOPEERS_HH_
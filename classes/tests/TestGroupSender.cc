@@ -0,0 +1,161 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestGroupSender.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::GroupSender
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceGroupSender.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7795;
+static const uint32_t  k_numThreads = 32;
+static const uint32_t  k_numMessages = 200;
+
+//----------------------------------------------------------------------------
+//!  Each message is the thread number in the upper 32 bits and the
+//!  sequence number in the lower 32 bits.
+//----------------------------------------------------------------------------
+void SenderThread(Credence::GroupSender & sender, uint32_t threadNum,
+                  std::atomic<uint32_t> & numSent)
+{
+  for (uint32_t i = 0; i < k_numMessages; ++i) {
+    if (sender.Send(((uint64_t)threadNum << 32) | i)) {
+      ++numSent;
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Every message arrives, and each thread's messages arrive in order.
+//----------------------------------------------------------------------------
+void TestConcurrentSends(Credence::Peer & clientPeer,
+                         Credence::Peer & serverPeer)
+{
+  Credence::GroupSender  sender(clientPeer);
+  std::atomic<uint32_t>  numSent = 0;
+  vector<std::thread>    threads;
+  for (uint32_t t = 0; t < k_numThreads; ++t) {
+    threads.push_back(std::thread(SenderThread, std::ref(sender), t,
+                                  std::ref(numSent)));
+  }
+  
+  vector<uint32_t>  nextSeq(k_numThreads, 0);
+  uint32_t          numReceived = 0;
+  bool              inOrder = true;
+  uint64_t          msg;
+  while (numReceived < (k_numThreads * k_numMessages)) {
+    if (! serverPeer.Receive(msg)) {
+      break;
+    }
+    uint32_t  threadNum = msg >> 32;
+    uint32_t  seq = msg & 0xFFFFFFFF;
+    if ((threadNum >= k_numThreads) || (seq != nextSeq[threadNum])) {
+      inOrder = false;
+    }
+    else {
+      ++nextSeq[threadNum];
+    }
+    ++numReceived;
+  }
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  UnitAssert((k_numThreads * k_numMessages) == numSent);
+  UnitAssert((k_numThreads * k_numMessages) == numReceived);
+  UnitAssert(inOrder);
+
+  auto  stats = sender.Stats();
+  UnitAssert(stats.messages == numSent);
+  UnitAssert(0 == stats.failures);
+  UnitAssert(stats.frames <= stats.messages);
+  UnitAssert(stats.maxBatch <= k_numThreads);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestGroupSender", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  serverPeer;
+  Credence::Peer  clientPeer;
+  bool  authenticated =
+    Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port);
+
+  if (authenticated) {
+    TestConcurrentSends(clientPeer, serverPeer);
+  }
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,276 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestHandshakeExecutor.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::HandshakeExecutor unit tests
+//---------------------------------------------------------------------------
+
+#include <atomic>
+#include <future>
+#include <iostream>
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceChallengeResponse.hh"
+#include "DwmCredenceEd25519KeyPair.hh"
+#include "DwmCredenceHandshakeExecutor.hh"
+
+using namespace std;
+using namespace Dwm;
+
+using Op = Credence::HandshakeExecutor::Operation;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestRunLimited()
+{
+  Credence::HandshakeExecutor  executor(2, 16);
+  
+  //  Not started; nothing is run.
+  UnitAssert(! executor.RunLimited(Op::e_sign, [] {}));
+  UnitAssert(executor.Stats(Op::e_sign).rejected == 1);
+  
+  UnitAssert(executor.Start());
+  Credence::Ed25519KeyPair     keyPair("dwm");
+  Credence::Challenge          challenge(true);
+  Credence::ChallengeResponse  response;
+  bool                         created = false, verified = false;
+  thread::id                   runnerId;
+  UnitAssert(executor.RunLimited(Op::e_sign, [&] {
+    runnerId = this_thread::get_id();
+    created = response.Create(keyPair.SecretKey(), challenge);
+  }));
+  UnitAssert(created);
+  UnitAssert(runnerId == this_thread::get_id());
+  UnitAssert(executor.RunLimited(Op::e_verify, [&] {
+    verified = response.Verify(keyPair.PublicKey(), challenge);
+  }));
+  UnitAssert(verified);
+
+  auto  signStats = executor.Stats(Op::e_sign);
+  UnitAssert(signStats.completed == 1);
+  UnitAssert(signStats.rejected == 1);
+  UnitAssert(signStats.totalRunNs > 0);
+  UnitAssert(signStats.maxRunNs <= signStats.totalRunNs);
+  UnitAssert(executor.Stats(Op::e_verify).completed == 1);
+  UnitAssert(executor.Stats(Op::e_keyAgreement).completed == 0);
+
+  //  A throwing operation fails but gives back its slot.
+  UnitAssert(! executor.RunLimited(Op::e_verify, [] {
+    throw runtime_error("oops");
+  }));
+  UnitAssert(executor.Stats(Op::e_verify).completed == 2);
+  UnitAssert(executor.RunLimited(Op::e_verify, [] {}));
+
+  //  No executor; runs on this thread without a limit.
+  runnerId = thread::id();
+  UnitAssert(Credence::HandshakeExecutor::RunLimited(nullptr, Op::e_sign, [&] {
+    runnerId = this_thread::get_id();
+  }));
+  UnitAssert(runnerId == this_thread::get_id());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Callers of RunLimited() block, but no more operations run at once than
+//!  the limit.
+//----------------------------------------------------------------------------
+static void TestConcurrencyLimit()
+{
+  Credence::HandshakeExecutor  executor(2, 16);
+  UnitAssert(executor.Start());
+
+  atomic<int>     running = 0, maxRunning = 0, ran = 0;
+  vector<thread>  callers;
+  for (int i = 0; i < 8; ++i) {
+    callers.emplace_back([&] {
+      UnitAssert(executor.RunLimited(Op::e_keyGeneration, [&] {
+        int  now = ++running;
+        int  prev = maxRunning;
+        while ((now > prev) && (! maxRunning.compare_exchange_weak(prev, now)))
+          ;
+        this_thread::sleep_for(chrono::milliseconds(5));
+        --running;
+        ++ran;
+      }));
+    });
+  }
+  for (auto & caller : callers) {
+    caller.join();
+  }
+  UnitAssert(ran == 8);
+  UnitAssert(maxRunning <= 2);
+  UnitAssert(executor.Stats(Op::e_keyGeneration).completed == 8);
+  executor.Stop();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Blocks the only slot with one caller and fills the waiters with two
+//!  more.  Returns the callers; @c release lets them finish.
+//----------------------------------------------------------------------------
+static vector<thread>
+BlockExecutor(Credence::HandshakeExecutor & executor,
+              shared_future<void> released, atomic<int> & ran)
+{
+  vector<thread>  callers;
+  atomic<bool>    blocked = false;
+  callers.emplace_back([&executor,released,&ran,&blocked] {
+    executor.RunLimited(Op::e_keyAgreement,
+                        [&] { blocked = true; released.wait(); ++ran; });
+  });
+  while (! blocked) {
+    this_thread::yield();
+  }
+  for (int i = 0; i < 2; ++i) {
+    callers.emplace_back([&executor,&ran] {
+      executor.RunLimited(Op::e_keyAgreement, [&] { ++ran; });
+    });
+  }
+  while (executor.Waiting() < 2) {
+    this_thread::yield();
+  }
+  return callers;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestBackpressure()
+{
+  Credence::HandshakeExecutor  executor(1, 2);
+  UnitAssert(executor.Start());
+
+  promise<void>   release;
+  atomic<int>     ran = 0;
+  vector<thread>  callers =
+    BlockExecutor(executor, release.get_future().share(), ran);
+  
+  //  Too many waiting; rejected immediately.
+  UnitAssert(! executor.RunLimited(Op::e_keyAgreement, [&] { ++ran; }));
+  UnitAssert(executor.Stats(Op::e_keyAgreement).rejected == 1);
+
+  release.set_value();
+  for (auto & caller : callers) {
+    caller.join();
+  }
+  UnitAssert(ran == 3);
+  UnitAssert(executor.Waiting() == 0);
+  UnitAssert(executor.Stats(Op::e_keyAgreement).completed == 3);
+  UnitAssert(executor.Stats(Op::e_keyAgreement).maxWaitNs > 0);
+  executor.Stop();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Stop() fails waiting callers and waits for the running one.  Start()
+//!  and Stop() may race with each other and with callers.
+//----------------------------------------------------------------------------
+static void TestStop()
+{
+  Credence::HandshakeExecutor  executor(1, 2);
+  UnitAssert(executor.Start());
+
+  promise<void>   release;
+  atomic<int>     ran = 0;
+  vector<thread>  callers =
+    BlockExecutor(executor, release.get_future().share(), ran);
+  thread  stopper([&] { executor.Stop(); });
+  //  The waiters leave without running; the running one is let finish.
+  while (executor.Waiting() > 0) {
+    this_thread::yield();
+  }
+  release.set_value();
+  stopper.join();
+  for (auto & caller : callers) {
+    caller.join();
+  }
+  UnitAssert(ran == 1);
+  UnitAssert(executor.Stats(Op::e_keyAgreement).rejected == 2);
+  UnitAssert(! executor.RunLimited(Op::e_sign, [] {}));
+
+  atomic<bool>    done = false;
+  vector<thread>  threads;
+  for (int i = 0; i < 2; ++i) {
+    threads.emplace_back([&] {
+      while (! done) {
+        executor.Start();
+        executor.Stop();
+      }
+    });
+    threads.emplace_back([&] {
+      while (! done) {
+        executor.RunLimited(Op::e_sign, [] {});
+      }
+    });
+  }
+  this_thread::sleep_for(chrono::milliseconds(200));
+  done = true;
+  for (auto & t : threads) {
+    t.join();
+  }
+  UnitAssert(executor.Start());
+  UnitAssert(executor.RunLimited(Op::e_sign, [] {}));
+  executor.Stop();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  Dwm::SysLogger::Open("TestHandshakeExecutor", LOG_PID, LOG_USER);
+
+  TestRunLimited();
+  TestConcurrencyLimit();
+  TestBackpressure();
+  TestStop();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -66,20 +66,24 @@ int main(int argc, char *argv[])
   UnitAssert(sKeys.SecretKey().Value().size()
              == crypto_box_SECRETKEYBYTES);
 
-  string cSharedKey = cKeys.SharedKey(sKeys.PublicKey().Value());
-  string sSharedKey = sKeys.SharedKey(cKeys.PublicKey().Value());
-  if (UnitAssert((! cSharedKey.empty())
-                 && (! sSharedKey.empty()))) {
+  Credence::KXKeyPair::SharedKeyType  cSharedKey =
+    cKeys.SharedKey(sKeys.PublicKey().Value());
+  Credence::KXKeyPair::SharedKeyType  sSharedKey =
+    sKeys.SharedKey(cKeys.PublicKey().Value());
+  if (UnitAssert((! cSharedKey.Empty())
+                 && (! sSharedKey.Empty()))) {
     UnitAssert(cSharedKey == sSharedKey);
   }
 
-  string  prevSharedKey;
+  Credence::KXKeyPair::SharedKeyType  prevSharedKey;
   for (int i = 0; i < 20; ++i) {
     Credence::KXKeyPair  myKeys, theirKeys;
-    string  mySharedKey = myKeys.SharedKey(theirKeys.PublicKey().Value());
-    string  theirSharedKey = theirKeys.SharedKey(myKeys.PublicKey().Value());
-    UnitAssert(! mySharedKey.empty());
-    UnitAssert(! theirSharedKey.empty());
+    Credence::KXKeyPair::SharedKeyType  mySharedKey =
+      myKeys.SharedKey(theirKeys.PublicKey().Value());
+    Credence::KXKeyPair::SharedKeyType  theirSharedKey =
+      theirKeys.SharedKey(myKeys.PublicKey().Value());
+    UnitAssert(! mySharedKey.Empty());
+    UnitAssert(! theirSharedKey.Empty());
     UnitAssert(mySharedKey == theirSharedKey);
     UnitAssert(prevSharedKey != mySharedKey);
     prevSharedKey = mySharedKey;
@@ -0,0 +1,181 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestKXKeyPairPool.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KXKeyPairPool unit tests
+//---------------------------------------------------------------------------
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <set>
+#include <thread>
+#include <vector>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceKXKeyPairPool.hh"
+#include "DwmCredencePeer.hh"
+
+using namespace std;
+using namespace Dwm;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static bool WaitForSize(const Credence::KXKeyPairPool & pool, size_t size)
+{
+  for (int i = 0; i < 200; ++i) {
+    if (pool.Size() == size) {
+      return true;
+    }
+    this_thread::sleep_for(chrono::milliseconds(10));
+  }
+  return false;
+}
+
+//----------------------------------------------------------------------------
+//!  Start() and Stop() racing each other must not start a thread over
+//!  one that's still being joined.
+//----------------------------------------------------------------------------
+static void TestStartStop()
+{
+  Credence::KXKeyPairPool  pool(2);
+  atomic<bool>    done = false;
+  vector<thread>  threads;
+  for (int i = 0; i < 4; ++i) {
+    threads.emplace_back([&] {
+      while (! done) {
+        pool.Start();
+        pool.Stop();
+      }
+    });
+  }
+  this_thread::sleep_for(chrono::milliseconds(200));
+  done = true;
+  for (auto & t : threads) {
+    t.join();
+  }
+  UnitAssert(pool.Start());
+  UnitAssert(WaitForSize(pool, 2));
+  pool.Stop();
+  UnitAssert(pool.Size() == 0);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Key exchange between two Peers that each take key pairs from
+//!  their own pool.
+//----------------------------------------------------------------------------
+static void TestPeers()
+{
+  Credence::KXKeyPairPool  clientPool(2), serverPool(2);
+  UnitAssert(clientPool.Start() && serverPool.Start());
+  
+  unique_ptr<Credence::MemoryPipe>  clientEnd, serverEnd;
+  Credence::MemoryPipe::Create(clientEnd, serverEnd, 64 * 1024);
+  Credence::Peer  serverPeer;
+  serverPeer.SetKeyPairPool(&serverPool);
+  std::thread  serverThread([&] {
+    if (UnitAssert(serverPeer.Accept(std::move(serverEnd)))) {
+      string  msg;
+      UnitAssert(serverPeer.Receive(msg) && (msg == "hello"));
+    }
+  });
+  Credence::Peer  clientPeer;
+  clientPeer.SetKeyPairPool(&clientPool);
+  if (UnitAssert(clientPeer.Connect(std::move(clientEnd)))) {
+    UnitAssert(clientPeer.Send(string("hello")));
+  }
+  serverThread.join();
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  Credence::KXKeyPairPool  pool(8);
+  UnitAssert(pool.Capacity() == 8);
+  UnitAssert(pool.Size() == 0);
+
+  //  Not started; Get() generates inline.
+  auto  keys = pool.Get();
+  UnitAssert(keys && (! keys->PublicKey().Value().empty()));
+  
+  UnitAssert(pool.Start());
+  UnitAssert(pool.Start());
+  UnitAssert(WaitForSize(pool, 8));
+
+  //  Every key pair is handed out once.
+  set<string>  pubKeys;
+  for (int i = 0; i < 32; ++i) {
+    auto  myKeys = pool.Get();
+    auto  theirKeys = pool.Get();
+    if (UnitAssert(myKeys && theirKeys)) {
+      UnitAssert(pubKeys.insert(string(myKeys->PublicKey().Value())).second);
+      UnitAssert(pubKeys.insert(string(theirKeys->PublicKey().Value())).second);
+      auto  mySharedKey = myKeys->SharedKey(theirKeys->PublicKey().Value());
+      auto  theirSharedKey =
+        theirKeys->SharedKey(myKeys->PublicKey().Value());
+      UnitAssert(! mySharedKey.Empty());
+      UnitAssert(mySharedKey == theirSharedKey);
+    }
+  }
+  
+  //  Refilled after use.
+  UnitAssert(WaitForSize(pool, 8));
+
+  pool.Stop();
+  UnitAssert(pool.Size() == 0);
+  keys = pool.Get();
+  UnitAssert(keys && (! keys->PublicKey().Value().empty()));
+
+  TestStartStop();
+  TestPeers();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
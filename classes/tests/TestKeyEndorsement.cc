@@ -0,0 +1,194 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestKeyEndorsement.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::KeyEndorsement and KeyAuthorities unit tests
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceEd25519KeyPair.hh"
+#include "DwmCredenceKeyAuthorities.hh"
+#include "DwmCredenceKeyEndorsement.hh"
+
+using namespace std;
+using namespace Dwm;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestCreateOpen(const Credence::Ed25519KeyPair & authority,
+                           const Credence::Ed25519KeyPair & subject)
+{
+  Credence::KeyEndorsement  endorsement;
+  UnitAssert(endorsement.Empty());
+  auto  expires = Credence::Utils::Clock::now() + chrono::hours(24);
+  if (UnitAssert(endorsement.Create(subject.PublicKey(),
+                                    authority.SecretKey(), expires))) {
+    UnitAssert(! endorsement.Empty());
+    UnitAssert(endorsement.AuthorityId() == authority.SecretKey().Id());
+
+    Credence::Ed25519Key        openedKey;
+    Credence::Utils::TimePoint  openedExpires;
+    if (UnitAssert(endorsement.Open(authority.PublicKey().Key(),
+                                    openedKey, openedExpires))) {
+      UnitAssert(openedKey == subject.PublicKey());
+      UnitAssert(chrono::duration_cast<chrono::seconds>(expires - openedExpires)
+                 .count() == 0);
+    }
+    //  Can't be opened with the subject's key.
+    UnitAssert(! endorsement.Open(subject.PublicKey().Key(),
+                                  openedKey, openedExpires));
+
+    //  Binary round trip.
+    stringstream              ss;
+    Credence::KeyEndorsement  endorsement2;
+    if (UnitAssert(endorsement.Write(ss))) {
+      if (UnitAssert(endorsement2.Read(ss))) {
+        UnitAssert(endorsement2.Open(authority.PublicKey().Key(),
+                                     openedKey, openedExpires));
+      }
+    }
+    
+    //  Text round trip.
+    stringstream              ss2;
+    Credence::KeyEndorsement  endorsement3;
+    ss2 << endorsement;
+    if (UnitAssert(ss2 >> endorsement3)) {
+      UnitAssert(endorsement3.AuthorityId() == authority.SecretKey().Id());
+      UnitAssert(endorsement3.Open(authority.PublicKey().Key(),
+                                   openedKey, openedExpires));
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestAuthorities(const Credence::Ed25519KeyPair & authority,
+                            const Credence::Ed25519KeyPair & subject)
+{
+  {
+    ofstream  os("./TestKeyEndorsement_authority_keys");
+    os << authority.PublicKey() << '\n';
+  }
+  {
+    ofstream  os("./TestKeyEndorsement_revoked_keys");
+  }
+  Credence::KeyAuthorities  authorities(".",
+                                        "TestKeyEndorsement_authority_keys",
+                                        "TestKeyEndorsement_revoked_keys");
+  UnitAssert(authorities.Authorities().Keys().size() == 1);
+  
+  auto  now = Credence::Utils::Clock::now();
+  Credence::KeyEndorsement  endorsement;
+  if (UnitAssert(endorsement.Create(subject.PublicKey(),
+                                    authority.SecretKey(),
+                                    now + chrono::hours(1)))) {
+    Credence::Ed25519Key  pubKey;
+    UnitAssert(authorities.Verify(subject.PublicKey().Id(), endorsement,
+                                  pubKey));
+    UnitAssert(pubKey == subject.PublicKey());
+    //  Wrong ID
+    UnitAssert(! authorities.Verify("someone@else.org", endorsement,
+                                    pubKey));
+    UnitAssert(! authorities.IsRevoked(subject.PublicKey().Key()));
+
+    //  Revoke the subject's key.
+    {
+      ofstream  os("./TestKeyEndorsement_revoked_keys");
+      os << subject.PublicKey() << '\n';
+    }
+    authorities.Reload();
+    UnitAssert(authorities.IsRevoked(subject.PublicKey().Key()));
+    UnitAssert(! authorities.Verify(subject.PublicKey().Id(), endorsement,
+                                    pubKey));
+  }
+
+  //  Expired endorsement
+  if (UnitAssert(endorsement.Create(subject.PublicKey(),
+                                    authority.SecretKey(),
+                                    now - chrono::seconds(1)))) {
+    Credence::Ed25519Key  pubKey;
+    UnitAssert(! authorities.Verify(subject.PublicKey().Id(), endorsement,
+                                    pubKey));
+  }
+
+  //  Endorsement from an unknown authority
+  Credence::Ed25519KeyPair  rogue("rogue@nowhere.org");
+  if (UnitAssert(endorsement.Create(subject.PublicKey(), rogue.SecretKey(),
+                                    now + chrono::hours(1)))) {
+    Credence::Ed25519Key  pubKey;
+    UnitAssert(! authorities.Verify(subject.PublicKey().Id(), endorsement,
+                                    pubKey));
+  }
+  
+  std::remove("./TestKeyEndorsement_authority_keys");
+  std::remove("./TestKeyEndorsement_revoked_keys");
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  Credence::Ed25519KeyPair  authority("ca@mcplex.net");
+  Credence::Ed25519KeyPair  subject("test@mcplex.net");
+
+  TestCreateOpen(authority, subject);
+
+  //  Longest IDs an Ed25519Key can hold.
+  Credence::Ed25519KeyPair  longAuthority(string(64, 'a'));
+  Credence::Ed25519KeyPair  longSubject(string(64, 's'));
+  TestCreateOpen(longAuthority, longSubject);
+  
+  TestAuthorities(authority, subject);
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
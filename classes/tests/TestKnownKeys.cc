@@ -39,6 +39,8 @@
 //!  \brief Dwm::Credence::KnownKeys unit tests
 //---------------------------------------------------------------------------
 
+#include <filesystem>
+#include <fstream>
 #include <sstream>
 
 #include "DwmUnitAssert.hh"
@@ -72,6 +74,119 @@ static void TestBadKeys()
   return;
 }
 
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestKeysDirectory()
+{
+  Credence::KnownKeys  knownKeys("./inputs", "known_keys.d");
+  UnitAssert(knownKeys.Keys().size() == 3);
+  UnitAssert(! knownKeys.Find("test@mcplex.net").empty());
+  UnitAssert(! knownKeys.Find("bar@anotherdomain.com").empty());
+  //  foo@somedomain.com is in both files with different keys; the key
+  //  from 00-admins should win.
+  Credence::KnownKeys  adminKeys("./inputs", "admin_keys");
+  UnitAssert(knownKeys.Find("foo@somedomain.com")
+             == adminKeys.Find("foo@somedomain.com"));
+
+  UnitAssert(knownKeys.FileVersion("00-admins") == 1);
+  UnitAssert(knownKeys.FileVersion("10-others") == 1);
+  UnitAssert(knownKeys.FileVersion("20-missing") == 0);
+
+  //  Nothing changed, so nothing should be reread.
+  knownKeys.Reload();
+  UnitAssert(knownKeys.FileVersion("00-admins") == 1);
+  UnitAssert(knownKeys.FileVersion("10-others") == 1);
+  UnitAssert(knownKeys.Keys().size() == 3);
+
+  UnitAssert(knownKeys.ReloadFile("10-others"));
+  UnitAssert(knownKeys.FileVersion("10-others") == 2);
+  UnitAssert(knownKeys.FileVersion("00-admins") == 1);
+  UnitAssert(knownKeys.Keys().size() == 3);
+
+  //  Only plain names within the directory are accepted.
+  UnitAssert(! knownKeys.ReloadFile(""));
+  UnitAssert(! knownKeys.ReloadFile("."));
+  UnitAssert(! knownKeys.ReloadFile(".."));
+  UnitAssert(! knownKeys.ReloadFile(".hidden"));
+  UnitAssert(! knownKeys.ReloadFile("../admin_keys"));
+  UnitAssert(! knownKeys.ReloadFile("sub/10-others"));
+  UnitAssert(knownKeys.Keys().size() == 3);
+
+  Credence::KnownKeys  copiedKeys(knownKeys);
+  UnitAssert(copiedKeys.Keys() == knownKeys.Keys());
+  UnitAssert(copiedKeys.FileVersion("10-others") == 2);
+
+  //  Read() replaces the keys and forgets the loaded files.
+  std::stringstream  ss;
+  if (UnitAssert(adminKeys.Write(ss))) {
+    if (UnitAssert(copiedKeys.Read(ss))) {
+      UnitAssert(copiedKeys.Keys() == adminKeys.Keys());
+      UnitAssert(copiedKeys.FileVersion("00-admins") == 0);
+      UnitAssert(copiedKeys.FileVersion("10-others") == 0);
+      UnitAssert(copiedKeys.ReloadFile("10-others"));
+      UnitAssert(copiedKeys.FileVersion("10-others") == 1);
+      UnitAssert(copiedKeys.FileVersion("00-admins") == 0);
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Changes to a directory of key files after the first load: removed
+//!  files are forgotten, changed files are reread, things that aren't
+//!  regular files are ignored and files we can't stat are kept.
+//----------------------------------------------------------------------------
+static void TestKeysDirectoryChanges()
+{
+  namespace fs = std::filesystem;
+
+  const fs::path  dir("./TestKnownKeys.d");
+  fs::remove_all(dir);
+  fs::create_directory(dir);
+  fs::copy_file("./inputs/known_keys.d/00-admins", dir / "00-admins");
+  fs::copy_file("./inputs/known_keys.d/10-others", dir / "10-others");
+
+  Credence::KnownKeys  knownKeys(".", "TestKnownKeys.d");
+  UnitAssert(knownKeys.Keys().size() == 3);
+
+  fs::remove(dir / "10-others");
+  fs::create_directory(dir / "20-subdir");
+  knownKeys.Reload();
+  UnitAssert(knownKeys.Keys().size() == 2);
+  UnitAssert(knownKeys.Find("bar@anotherdomain.com").empty());
+  UnitAssert(knownKeys.FileVersion("10-others") == 0);
+  UnitAssert(knownKeys.FileVersion("20-subdir") == 0);
+  UnitAssert(knownKeys.FileVersion("00-admins") == 1);
+
+  {
+    ofstream  os(dir / "00-admins", ios::app);
+    os << "\n";
+  }
+  knownKeys.Reload();
+  UnitAssert(knownKeys.FileVersion("00-admins") == 2);
+  UnitAssert(knownKeys.Keys().size() == 2);
+
+  //  A file we can't stat keeps the keys we last loaded from it.  A
+  //  dangling symbolic link is treated as a removed file.
+  fs::copy_file("./inputs/known_keys.d/10-others", dir / "10-others");
+  knownKeys.Reload();
+  UnitAssert(knownKeys.Keys().size() == 3);
+  fs::remove(dir / "10-others");
+  fs::create_symlink("10-others", dir / "10-others");
+  knownKeys.Reload();
+  UnitAssert(knownKeys.Keys().size() == 3);
+  UnitAssert(knownKeys.FileVersion("10-others") == 1);
+  fs::remove(dir / "10-others");
+  fs::create_symlink("missing", dir / "10-others");
+  knownKeys.Reload();
+  UnitAssert(knownKeys.Keys().size() == 2);
+  UnitAssert(knownKeys.FileVersion("10-others") == 0);
+
+  fs::remove_all(dir);
+  return;
+}
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -120,6 +235,8 @@ int main(int argc, char *argv[])
   UnitAssert(KnownKeysOK(knownKeys));
 
   TestBadKeys();
+  TestKeysDirectory();
+  TestKeysDirectoryChanges();
   
   if (Assertions::Total().Failed()) {
     Assertions::Print(cerr, true);
@@ -0,0 +1,175 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestMemoryPipe.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::MemoryPipe
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestEchoPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const size_t    k_ringSize = 64 * 1024;
+static const uint32_t  k_numMessages = 1000;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestRawPipe()
+{
+  unique_ptr<Credence::MemoryPipe>  a, b;
+  Credence::MemoryPipe::Create(a, b, 5000);
+  UnitAssert(8192 == a->RingSize());
+  UnitAssert(0 == b->BytesReady());
+  UnitAssert(! b->WaitForBytesReady(1, chrono::milliseconds(10)));
+
+  string  msg("hello");
+  UnitAssert(a->Out().write(msg.data(), msg.size()) && a->Out().flush());
+  UnitAssert(b->WaitForBytesReady(msg.size(), chrono::milliseconds(10)));
+  UnitAssert(msg.size() == b->BytesReady());
+  string  got(msg.size(), '\0');
+  UnitAssert(b->In().read(got.data(), got.size()) && (got == msg));
+  UnitAssert(0 == b->BytesReady());
+
+  //  Several times the ring size, so the writer has to wait.
+  string  big(a->RingSize() * 5, 'x');
+  thread  writer([&] {
+    a->Out().write(big.data(), big.size());
+    a->Out().flush();
+  });
+  got.assign(big.size(), '\0');
+  UnitAssert(b->In().read(got.data(), got.size()) && (got == big));
+  writer.join();
+
+  //  What was sent before closing can still be read.
+  UnitAssert(a->Out().write(msg.data(), msg.size()) && a->Out().flush());
+  a = nullptr;
+  UnitAssert(b->Closed());
+  got.assign(msg.size(), '\0');
+  UnitAssert(b->In().read(got.data(), got.size()) && (got == msg));
+  char  c;
+  UnitAssert(! b->In().read(&c, 1));
+  UnitAssert(! b->WaitForBytesReady(1, chrono::milliseconds(1000)));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Echoes messages until the client disconnects.
+//----------------------------------------------------------------------------
+void ServerThread(unique_ptr<Credence::MemoryPipe> && pipe,
+                  std::atomic<uint32_t> & numEchoed)
+{
+  Credence::Peer  peer;
+  if (UnitAssert(peer.Accept(std::move(pipe)))) {
+    if (Credence::Test::AuthenticatePeer(peer)) {
+      UnitAssert("memory pipe" == peer.EndPointString());
+      Credence::Test::EchoUntilDisconnected(peer, numEchoed);
+      UnitAssert(! peer.IsConnected());
+    }
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestPeers()
+{
+  unique_ptr<Credence::MemoryPipe>  clientEnd, serverEnd;
+  Credence::MemoryPipe::Create(clientEnd, serverEnd, k_ringSize);
+  
+  std::atomic<uint32_t>  numEchoed = 0;
+  std::thread  serverThread(ServerThread, std::move(serverEnd),
+                            std::ref(numEchoed));
+  Credence::Peer  peer;
+  if (UnitAssert(peer.Connect(std::move(clientEnd)))) {
+    if (Credence::Test::AuthenticatePeer(peer)) {
+      UnitAssert(peer.IsConnected());
+      UnitAssert(! peer.EnableSharedMemory());
+      Credence::PeerReader  reader;
+      Credence::PeerWriter  writer;
+      UnitAssert(! peer.Split(reader, writer));
+      Credence::Test::TestEcho(peer, k_numMessages, k_ringSize);
+    }
+  }
+  peer.Disconnect();
+  serverThread.join();
+  UnitAssert(k_numMessages == numEchoed);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestMemoryPipe", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  TestRawPipe();
+  TestPeers();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -51,6 +51,7 @@ extern "C" {
 #include "DwmSysLogger.hh"
 #include "DwmUnitAssert.hh"
 #include "DwmCredencePeer.hh"
+#include "DwmCredenceUtils.hh"
 
 using namespace std;
 using namespace Dwm;
@@ -60,7 +61,7 @@ using namespace Dwm;
 //----------------------------------------------------------------------------
 void ServerThread(const std::string & plaintext,
                   const std::atomic<bool> & shouldRun,
-                  std::atomic<bool> & running)
+                  std::atomic<bool> & running, bool fastOpen)
 {
   using namespace boost::asio;
 
@@ -71,6 +72,11 @@ void ServerThread(const std::string & plaintext,
   boost::asio::ip::tcp::acceptor::reuse_address option(true);
   acc.set_option(option, ec);
   acc.non_blocking(true, ec);
+  if (fastOpen) {
+    //  May fail if the host doesn't allow server-side Fast Open; the
+    //  client then falls back to a normal handshake.
+    Credence::Utils::EnableTcpFastOpen(acc);
+  }
 
   ip::tcp::socket    sock(ioContext);
   ip::tcp::endpoint  client;
@@ -295,6 +301,47 @@ void TestUnixSocket()
   return;
 }
 
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestFastOpen()
+{
+  string  fileContents;
+  if (! UnitAssert(GetFileContents(fileContents))) {
+    return;
+  }
+  //  The first connection fetches the Fast Open cookie, the second one
+  //  should carry our public key in its SYN.  Either way the handshake
+  //  and the encrypted exchange must work.
+  for (int i = 0; i < 2; ++i) {
+    std::atomic<bool>  serverShouldRun = true;
+    std::atomic<bool>  serverIsRunning = false;
+    std::thread  serverThread(ServerThread, fileContents,
+                              std::ref(serverShouldRun),
+                              std::ref(serverIsRunning), true);
+    while (! serverIsRunning) { }
+    Credence::Peer  peer;
+    peer.SetTcpFastOpen(true);
+    if (UnitAssert(peer.Connect("127.0.0.1", 7789))) {
+      UnitAssert(peer.EndPointString() == "127.0.0.1:7789");
+      Credence::KeyStash   keyStash("./inputs");
+      Credence::KnownKeys  knownKeys("./inputs");
+      if (UnitAssert(peer.Authenticate(keyStash, knownKeys))) {
+        if (UnitAssert(peer.Send(fileContents))) {
+          string  recoveredContents;
+          if (UnitAssert(peer.Receive(recoveredContents))) {
+            UnitAssert(recoveredContents == fileContents);
+          }
+        }
+      }
+      peer.Disconnect();
+    }
+    serverShouldRun = false;
+    serverThread.join();
+  }
+  return;
+}
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -321,7 +368,7 @@ int main(int argc, char *argv[])
   if (UnitAssert(GetFileContents(fileContents))) {
     std::thread  serverThread(ServerThread, fileContents,
                               std::ref(serverShouldRun),
-                              std::ref(serverIsRunning));
+                              std::ref(serverIsRunning), false);
     while (! serverIsRunning) { }
     Credence::Peer  peer;
     if (UnitAssert(peer.Connect("127.0.0.1", 7789))) {
@@ -360,6 +407,7 @@ int main(int argc, char *argv[])
   }
 
   TestUnixSocket();
+  TestFastOpen();
   
   if (Assertions::Total().Failed()) {
     Assertions::Print(cerr, true);
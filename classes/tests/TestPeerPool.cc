@@ -0,0 +1,267 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestPeerPool.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::PeerPool
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeerPool.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7791;
+
+//----------------------------------------------------------------------------
+//!  Echoes strings until the client disconnects or sends "bye".
+//----------------------------------------------------------------------------
+void ServeClient(boost::asio::ip::tcp::socket && sock)
+{
+  Credence::Peer  peer;
+  if (peer.Accept(std::move(sock))) {
+    Credence::KeyStash   keyStash("./inputs");
+    Credence::KnownKeys  knownKeys("./inputs");
+    if (peer.Authenticate(keyStash, knownKeys)) {
+      string  msg;
+      while (peer.Receive(msg) && (msg != "bye")) {
+        if (! peer.Send(msg)) {
+          break;
+        }
+      }
+    }
+  }
+  peer.Disconnect();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void ServerThread(const std::atomic<bool> & shouldRun,
+                  std::atomic<bool> & running)
+{
+  using namespace boost::asio;
+
+  io_context                 ioContext;
+  boost::system::error_code  ec;
+  ip::tcp::endpoint  endPoint(ip::address::from_string("127.0.0.1"), k_port);
+  ip::tcp::acceptor  acc(ioContext);
+  acc.open(endPoint.protocol());
+  acc.set_option(ip::tcp::acceptor::reuse_address(true), ec);
+  acc.bind(endPoint);
+  acc.listen();
+  acc.non_blocking(true, ec);
+
+  vector<thread>  clients;
+  running = true;
+  while (shouldRun) {
+    ip::tcp::socket  sock(ioContext);
+    acc.accept(sock, ec);
+    if (! ec) {
+      sock.native_non_blocking(false, ec);
+      clients.emplace_back(ServeClient, std::move(sock));
+    }
+    else {
+      std::this_thread::sleep_for(std::chrono::milliseconds(20));
+    }
+  }
+  for (auto & client : clients) {
+    client.join();
+  }
+  running = false;
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+bool Echo(Credence::PeerPool::Lease & lease, const string & msg)
+{
+  bool  rc = false;
+  if (lease->Send(msg)) {
+    string  reply;
+    if (lease->Receive(reply)) {
+      rc = (reply == msg);
+    }
+  }
+  return rc;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestReuse()
+{
+  Credence::KeyStash   keyStash("./inputs");
+  Credence::KnownKeys  knownKeys("./inputs");
+  Credence::PeerPool   pool(keyStash, knownKeys, 2);
+
+  {
+    auto  lease = pool.Get("127.0.0.1", k_port, "test@mcplex.net");
+    if (UnitAssert(lease)) {
+      UnitAssert(! lease.Reused());
+      UnitAssert(lease->Id() == "test@mcplex.net");
+      UnitAssert(Echo(lease, "hello"));
+    }
+  }
+  UnitAssert(pool.NumIdle() == 1);
+
+  {
+    auto  lease = pool.Get("127.0.0.1", k_port, "test@mcplex.net");
+    if (UnitAssert(lease)) {
+      UnitAssert(lease.Reused());
+      UnitAssert(Echo(lease, "hello again"));
+    }
+    UnitAssert(pool.NumIdle() == 0);
+  }
+  auto  stats = pool.Stats();
+  UnitAssert(stats.hits == 1);
+  UnitAssert(stats.misses == 1);
+
+  //  A Lease that's discarded isn't returned.
+  {
+    auto  lease = pool.Get("127.0.0.1", k_port, "test@mcplex.net");
+    if (UnitAssert(lease)) {
+      lease.Discard();
+      UnitAssert(! lease);
+    }
+  }
+  UnitAssert(pool.NumIdle() == 0);
+
+  //  Wrong server ID.
+  {
+    auto  lease = pool.Get("127.0.0.1", k_port, "nobody@mcplex.net");
+    UnitAssert(! lease);
+    UnitAssert(pool.Stats().connectFailures == 1);
+  }
+
+  //  A connection closed by the server isn't kept.
+  {
+    auto  lease = pool.Get("127.0.0.1", k_port, "test@mcplex.net");
+    if (UnitAssert(lease)) {
+      UnitAssert(lease->Send(string("bye")));
+      std::this_thread::sleep_for(std::chrono::milliseconds(200));
+      UnitAssert(! lease->IsConnected());
+    }
+  }
+  UnitAssert(pool.NumIdle() == 0);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestPrewarmAndExpiry()
+{
+  Credence::KeyStash   keyStash("./inputs");
+  Credence::KnownKeys  knownKeys("./inputs");
+  Credence::PeerPool   pool(keyStash, knownKeys, 3,
+                            std::chrono::milliseconds(300));
+
+  UnitAssert(pool.Prewarm("127.0.0.1", k_port, "test@mcplex.net", 5) == 3);
+  UnitAssert(pool.NumIdle() == 3);
+
+  //  Leases beyond MaxIdle() are disconnected when returned.
+  {
+    vector<Credence::PeerPool::Lease>  leases;
+    for (int i = 0; i < 4; ++i) {
+      leases.push_back(pool.Get("127.0.0.1", k_port, "test@mcplex.net"));
+      if (UnitAssert(leases.back())) {
+        UnitAssert(Echo(leases.back(), "prewarmed"));
+      }
+    }
+    UnitAssert(pool.Stats().hits == 3);
+    UnitAssert(pool.Stats().misses == 1);
+  }
+  UnitAssert(pool.NumIdle() == 3);
+  UnitAssert(pool.Stats().overflows == 1);
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(400));
+  pool.Prune();
+  UnitAssert(pool.NumIdle() == 0);
+  UnitAssert(pool.Stats().expired == 3);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestPeerPool", LOG_PID|LOG_PERROR, LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  std::atomic<bool>  serverShouldRun = true;
+  std::atomic<bool>  serverIsRunning = false;
+  std::thread  serverThread(ServerThread, std::ref(serverShouldRun),
+                            std::ref(serverIsRunning));
+  while (! serverIsRunning) { }
+
+  TestReuse();
+  TestPrewarmAndExpiry();
+
+  serverShouldRun = false;
+  serverThread.join();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
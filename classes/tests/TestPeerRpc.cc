@@ -0,0 +1,215 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestPeerRpc.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::PeerRpcClient and
+//!    Dwm::Credence::PeerRpcServer
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeerRpcClient.hh"
+#include "DwmCredencePeerRpcServer.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7793;
+
+static const uint32_t  k_echo = 1;
+static const uint32_t  k_sleep = 2;
+static const uint32_t  k_fail = 3;
+
+using Status = Credence::PeerRpcResponse::Status;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void RegisterHandlers(Credence::PeerRpcServer & server)
+{
+  server.Register<string,string>(k_echo,
+                                 [] (const string & req, string & resp) {
+                                   resp = "echo: " + req;
+                                   return true;
+                                 });
+  server.Register<uint32_t,uint32_t>(k_sleep,
+                                     [] (const uint32_t & ms,
+                                         uint32_t & resp) {
+                                       std::this_thread::sleep_for
+                                         (std::chrono::milliseconds(ms));
+                                       resp = ms;
+                                       return true;
+                                     });
+  server.Register<string,string>(k_fail,
+                                 [] (const string &, string &) {
+                                   return false;
+                                 });
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestCalls(Credence::PeerRpcClient & client)
+{
+  string  resp;
+  Status  status;
+  if (UnitAssert(client.Call(k_echo, string("hello"), resp))) {
+    UnitAssert(resp == "echo: hello");
+  }
+  UnitAssert(! client.Call(k_fail, string("x"), resp,
+                           std::chrono::milliseconds(1000), &status));
+  UnitAssert(Status::e_failed == status);
+  UnitAssert(! client.Call(99, string("x"), resp,
+                           std::chrono::milliseconds(1000), &status));
+  UnitAssert(Status::e_unknownMethod == status);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  A slow call doesn't hold up a fast one sent after it.
+//----------------------------------------------------------------------------
+void TestOutOfOrder(Credence::PeerRpcClient & client)
+{
+  auto  slow = client.CallAsync(k_sleep, (uint32_t)300);
+  auto  fast = client.CallAsync(k_sleep, (uint32_t)10);
+  uint32_t  ms = 0;
+  UnitAssert(fast.get().Decode(ms));
+  UnitAssert(10 == ms);
+  UnitAssert(slow.wait_for(std::chrono::milliseconds(0))
+             != std::future_status::ready);
+  UnitAssert(slow.get().Decode(ms));
+  UnitAssert(300 == ms);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestDeadline(Credence::PeerRpcClient & client)
+{
+  auto  call = client.CallAsync(k_sleep, (uint32_t)300,
+                                std::chrono::milliseconds(50));
+  UnitAssert(Status::e_timeout == call.get().GetStatus());
+  UnitAssert(0 == client.InFlight());
+  //  Let the late response arrive (and be dropped).
+  std::this_thread::sleep_for(std::chrono::milliseconds(350));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  With 4 workers, 4 calls of 200ms each in flight at once should take
+//!  about 200ms, not 800ms.
+//----------------------------------------------------------------------------
+void TestPipelining(Credence::PeerRpcClient & client)
+{
+  auto  start = std::chrono::steady_clock::now();
+  vector<std::future<Credence::PeerRpcResponse>>  calls;
+  for (int i = 0; i < 4; ++i) {
+    calls.push_back(client.CallAsync(k_sleep, (uint32_t)200));
+  }
+  for (auto & call : calls) {
+    UnitAssert(Status::e_ok == call.get().GetStatus());
+  }
+  auto  elapsed = std::chrono::steady_clock::now() - start;
+  UnitAssert(elapsed < std::chrono::milliseconds(600));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestPeerRpc", LOG_PID|LOG_PERROR, LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  serverPeer;
+  Credence::Peer  clientPeer;
+  bool  authenticated =
+    Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port);
+
+  if (authenticated) {
+    Credence::PeerRpcServer  server(serverPeer, 4);
+    RegisterHandlers(server);
+    Credence::PeerRpcClient  client(clientPeer, 8);
+    if (UnitAssert(server.Start() && client.Start())) {
+      TestCalls(client);
+      TestOutOfOrder(client);
+      TestDeadline(client);
+      TestPipelining(client);
+      
+      client.Stop();
+      server.Wait();
+      UnitAssert(server.Closed());
+      string  resp;
+      Status  status;
+      UnitAssert(! client.Call(k_echo, string("x"), resp,
+                               std::chrono::milliseconds(100), &status));
+      UnitAssert(Status::e_disconnected == status);
+    }
+  }
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,200 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestPeerSplit.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::Peer::Split()
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7794;
+static const int       k_numMessages = 200;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static string Message(int n)
+{
+  return string(64 * 1024, (char)('a' + (n % 26)));
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void Sender(Credence::PeerWriter & writer, std::atomic<int> & numSent)
+{
+  for (int i = 0; i < k_numMessages; ++i) {
+    if (! writer.Send(Message(i))) {
+      break;
+    }
+    ++numSent;
+  }
+  writer.Shutdown();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void Receiver(Credence::PeerReader & reader, std::atomic<int> & numReceived)
+{
+  string  msg;
+  for (int i = 0; i < k_numMessages; ++i) {
+    if (! reader.Receive(msg)) {
+      break;
+    }
+    if (msg != Message(i)) {
+      break;
+    }
+    ++numReceived;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Both ends send 200 messages of 64K at the same time.  With a shared
+//!  buffer and a single thread per end this would stall once the socket
+//!  buffers fill; with split halves each end drains while it sends.
+//----------------------------------------------------------------------------
+void TestFullDuplex(Credence::PeerReader & clientReader,
+                    Credence::PeerWriter & clientWriter,
+                    Credence::PeerReader & serverReader,
+                    Credence::PeerWriter & serverWriter)
+{
+  std::atomic<int>  sent[2] = { 0, 0 };
+  std::atomic<int>  received[2] = { 0, 0 };
+  std::thread  threads[4] = {
+    std::thread(Sender, std::ref(clientWriter), std::ref(sent[0])),
+    std::thread(Sender, std::ref(serverWriter), std::ref(sent[1])),
+    std::thread(Receiver, std::ref(clientReader), std::ref(received[0])),
+    std::thread(Receiver, std::ref(serverReader), std::ref(received[1]))
+  };
+  for (auto & thread : threads) {
+    thread.join();
+  }
+  UnitAssert(k_numMessages == sent[0]);
+  UnitAssert(k_numMessages == sent[1]);
+  UnitAssert(k_numMessages == received[0]);
+  UnitAssert(k_numMessages == received[1]);
+
+  //  Both ends shut down their send side, so both readers see EOF.
+  string  msg;
+  UnitAssert(! clientReader.Receive(msg));
+  UnitAssert(clientReader.Eof());
+  UnitAssert(! serverReader.Receive(msg));
+  UnitAssert(serverReader.Eof());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestPeerSplit", LOG_PID|LOG_PERROR, LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::PeerReader  clientReader, serverReader;
+  Credence::PeerWriter  clientWriter, serverWriter;
+  
+  Credence::Peer  unconnected;
+  UnitAssert(! unconnected.Split(clientReader, clientWriter));
+  UnitAssert(! clientReader.Valid());
+  UnitAssert(! clientWriter.Valid());
+  
+  Credence::Peer  serverPeer;
+  Credence::Peer  clientPeer;
+  bool  authenticated =
+    Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port);
+
+  if (authenticated) {
+    //  Sent before the server splits; the server's PeerReader must
+    //  still receive it.
+    UnitAssert(clientPeer.Send(string("before split")));
+    
+    if (UnitAssert(clientPeer.Split(clientReader, clientWriter))
+        && UnitAssert(serverPeer.Split(serverReader, serverWriter))) {
+      UnitAssert(! clientPeer.IsConnected());
+      UnitAssert(! serverPeer.IsConnected());
+      UnitAssert(clientReader.Valid() && clientWriter.Valid());
+      UnitAssert(serverReader.Id() == serverWriter.Id());
+      
+      string  msg;
+      UnitAssert(serverReader.Receive(msg));
+      UnitAssert("before split" == msg);
+
+      //  Halves can be moved (to the thread that will own them).
+      Credence::PeerReader  movedReader(std::move(serverReader));
+      UnitAssert(! serverReader.Valid());
+      serverReader = std::move(movedReader);
+      UnitAssert(serverReader.Valid());
+      
+      TestFullDuplex(clientReader, clientWriter, serverReader, serverWriter);
+    }
+  }
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
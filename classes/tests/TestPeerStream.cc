@@ -0,0 +1,212 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestPeerStream.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::Peer::SendStream() and
+//!    Dwm::Credence::Peer::ReceiveStream()
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <fcntl.h>
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <cstdio>
+#include <sstream>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7798;
+
+//----------------------------------------------------------------------------
+//!  Not a multiple of the chunk size, so the last chunk is short.
+//----------------------------------------------------------------------------
+static string TestData()
+{
+  string  data(Credence::Peer::k_streamChunkSize * 20 + 12345, '\0');
+  for (size_t i = 0; i < data.size(); ++i) {
+    data[i] = (char)((i * 31) ^ (i >> 9));
+  }
+  return data;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestIostreams(Credence::Peer & clientPeer, Credence::Peer & serverPeer)
+{
+  string         data = TestData();
+  istringstream  is(data);
+  std::thread    sender([&] {
+    UnitAssert(clientPeer.SendStream(is, data.size()));
+  });
+  ostringstream  os;
+  uint64_t       size = 0;
+  UnitAssert(serverPeer.ReceiveStream(os, &size));
+  sender.join();
+  UnitAssert(data.size() == size);
+  UnitAssert(data == os.str());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestFileDescriptors(Credence::Peer & clientPeer,
+                         Credence::Peer & serverPeer)
+{
+  string  data = TestData();
+  char    inPath[] = "/tmp/TestPeerStreamInXXXXXX";
+  char    outPath[] = "/tmp/TestPeerStreamOutXXXXXX";
+  int     inFd = mkstemp(inPath);
+  int     outFd = mkstemp(outPath);
+  if (UnitAssert((0 <= inFd) && (0 <= outFd))) {
+    UnitAssert(write(inFd, data.data(), data.size())
+               == (ssize_t)data.size());
+    //  Send everything after the first 100 bytes.
+    std::thread  sender([&] {
+      UnitAssert(clientPeer.SendStream(inFd, data.size() - 100, 100, true));
+    });
+    uint64_t  size = 0;
+    UnitAssert(serverPeer.ReceiveStream(outFd, &size, true));
+    sender.join();
+    UnitAssert((data.size() - 100) == size);
+    string  received(size, '\0');
+    UnitAssert(pread(outFd, received.data(), size, 0) == (ssize_t)size);
+    UnitAssert(data.substr(100) == received);
+  }
+  if (0 <= inFd) {
+    close(inFd);
+    unlink(inPath);
+  }
+  if (0 <= outFd) {
+    close(outFd);
+    unlink(outPath);
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  A sender that runs out of data fails, the receiver fails, and the
+//!  connection is still usable.
+//----------------------------------------------------------------------------
+void TestShortInput(Credence::Peer & clientPeer, Credence::Peer & serverPeer)
+{
+  string         data = TestData();
+  istringstream  is(data);
+  std::thread    sender([&] {
+    UnitAssert(! clientPeer.SendStream(is, data.size() + 1));
+    UnitAssert(clientPeer.Send(string("still here")));
+  });
+  ostringstream  os;
+  UnitAssert(! serverPeer.ReceiveStream(os));
+  string  msg;
+  UnitAssert(serverPeer.Receive(msg));
+  UnitAssert("still here" == msg);
+  sender.join();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  A chunk longer than k_streamChunkSize is refused from its length
+//!  alone, and the receiver disconnects.  The sender never sends the
+//!  chunk's data.
+//----------------------------------------------------------------------------
+void TestOversizedChunk(Credence::Peer & clientPeer,
+                        Credence::Peer & serverPeer)
+{
+  const uint64_t  chunkLen = Credence::Peer::k_streamChunkSize + 1;
+  UnitAssert(clientPeer.Send(chunkLen * 2));
+  UnitAssert(clientPeer.Send(chunkLen));
+  ostringstream  os;
+  uint64_t       size = 0;
+  UnitAssert(! serverPeer.ReceiveStream(os, &size));
+  UnitAssert((chunkLen * 2) == size);
+  UnitAssert(os.str().empty());
+  UnitAssert(! serverPeer.IsConnected());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestPeerStream", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  serverPeer;
+  Credence::Peer  clientPeer;
+  bool  authenticated =
+    Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port);
+
+  if (authenticated) {
+    TestIostreams(clientPeer, serverPeer);
+    TestFileDescriptors(clientPeer, serverPeer);
+    TestShortInput(clientPeer, serverPeer);
+    TestOversizedChunk(clientPeer, serverPeer);
+  }
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,135 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestPlaintext.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::Peer plaintext mode
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestEchoPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const char     *k_sockPath = "./TestPlaintext.sock";
+static const size_t    k_bigMessage = 100000;
+static const uint32_t  k_numMessages = 1000;
+
+//----------------------------------------------------------------------------
+//!  The first EnablePlaintext() fails because the client declines, the
+//!  second succeeds.
+//----------------------------------------------------------------------------
+static void ServerSetup(Credence::Peer & peer)
+{
+  Credence::Peer::Credentials  creds;
+  if (UnitAssert(peer.PeerCredentials(creds))) {
+    UnitAssert(creds.uid == geteuid());
+  }
+  UnitAssert(! peer.EnablePlaintext());
+  UnitAssert(! peer.Plaintext());
+  UnitAssert(peer.EnablePlaintext());
+  UnitAssert(peer.Plaintext());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestPlaintext", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  unconnected;
+  Credence::Peer::Credentials  creds;
+  UnitAssert(! unconnected.PeerCredentials(creds));
+  UnitAssert(! unconnected.EnablePlaintext());
+  UnitAssert(! unconnected.Plaintext());
+  
+  std::atomic<bool>      listening = false;
+  std::atomic<uint32_t>  numEchoed = 0;
+  std::thread  serverThread(Credence::Test::UnixServerThread, k_sockPath,
+                            ServerSetup, std::ref(listening),
+                            std::ref(numEchoed));
+  while (! listening) { }
+
+  Credence::Peer  peer;
+  if (Credence::Test::ConnectUnix(peer, k_sockPath)) {
+    bool  checked = false;
+    auto  decline = [&] (const Credence::Peer::Credentials &)
+      { checked = true; return false; };
+    UnitAssert(! peer.EnablePlaintext(decline));
+    UnitAssert(checked);
+    UnitAssert(! peer.Plaintext());
+    UnitAssert(peer.EnablePlaintext());
+    UnitAssert(peer.Plaintext());
+    Credence::Test::TestEcho(peer, k_numMessages, k_bigMessage);
+  }
+  peer.Disconnect();
+  UnitAssert(! peer.Plaintext());
+  serverThread.join();
+  UnitAssert(k_numMessages == numEchoed);
+  unlink(k_sockPath);
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
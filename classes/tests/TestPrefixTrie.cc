@@ -0,0 +1,186 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestPrefixTrie.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::PrefixTrie unit tests
+//---------------------------------------------------------------------------
+
+#include <chrono>
+#include <random>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePrefixTrie.hh"
+
+using namespace std;
+using namespace Dwm;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static boost::asio::ip::address Addr(const char *s)
+{
+  return boost::asio::ip::make_address(s);
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestBasic()
+{
+  Credence::PrefixTrie  trie;
+  UnitAssert(trie.Empty());
+  UnitAssert(trie.LongestMatch(Addr("192.0.2.1")) == -1);
+
+  UnitAssert(trie.Add(Addr("10.0.0.0"), 8));
+  UnitAssert(trie.Add(Addr("10.1.0.0"), 16));
+  UnitAssert(trie.Add(Addr("10.1.2.0"), 23));
+  UnitAssert(trie.Add(Addr("10.1.2.129"), 32));
+  UnitAssert(trie.Add(Addr("2001:db8::"), 32));
+  UnitAssert(trie.Add(Addr("2001:db8:1:2::"), 63));
+  UnitAssert(! trie.Add(Addr("10.0.0.0"), 33));
+  UnitAssert(! trie.Add(Addr("2001:db8::"), 129));
+  UnitAssert(trie.Size() == 6);
+
+  UnitAssert(trie.LongestMatch(Addr("10.200.0.1")) == 8);
+  UnitAssert(trie.LongestMatch(Addr("10.1.200.1")) == 16);
+  UnitAssert(trie.LongestMatch(Addr("10.1.3.1")) == 23);
+  UnitAssert(trie.LongestMatch(Addr("10.1.4.1")) == 16);
+  UnitAssert(trie.LongestMatch(Addr("10.1.2.129")) == 32);
+  UnitAssert(trie.LongestMatch(Addr("10.1.2.128")) == 23);
+  UnitAssert(trie.LongestMatch(Addr("11.0.0.1")) == -1);
+  UnitAssert(trie.LongestMatch(Addr("::ffff:10.1.3.1")) == 23);
+  UnitAssert(trie.LongestMatch(Addr("2001:db8:ffff::1")) == 32);
+  UnitAssert(trie.LongestMatch(Addr("2001:db8:1:3::1")) == 63);
+  UnitAssert(trie.LongestMatch(Addr("2001:db8:1:4::1")) == 32);
+  UnitAssert(trie.LongestMatch(Addr("2001:db9::1")) == -1);
+  UnitAssert(! trie.Contains(Addr("::1")));
+
+  //  A default route matches everything in its family.
+  UnitAssert(trie.Add(Addr("0.0.0.0"), 0));
+  UnitAssert(trie.LongestMatch(Addr("11.0.0.1")) == 0);
+  UnitAssert(trie.LongestMatch(Addr("10.1.3.1")) == 23);
+  UnitAssert(! trie.Contains(Addr("::1")));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestIpPrefixes()
+{
+  set<IpPrefix>  prefixes;
+  prefixes.insert(IpPrefix("192.168.0.0/16"));
+  prefixes.insert(IpPrefix("2001:db8:1::/48"));
+  Credence::PrefixTrie  trie(prefixes);
+  UnitAssert(trie.Size() == 2);
+  UnitAssert(trie.LongestMatch(Addr("192.168.1.1")) == 16);
+  UnitAssert(trie.LongestMatch(Addr("2001:db8:1::1")) == 48);
+  UnitAssert(! trie.Contains(Addr("192.169.1.1")));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Compares against a brute force scan, with a large random allowlist.
+//----------------------------------------------------------------------------
+static void TestRandom()
+{
+  mt19937  rng(12345);
+  vector<pair<uint32_t,uint8_t>>  prefixes;
+  Credence::PrefixTrie  trie;
+  for (int i = 0; i < 30000; ++i) {
+    uint8_t   len = 8 + (rng() % 25);
+    uint32_t  mask = (len == 32) ? 0xffffffff : ~(0xffffffffu >> len);
+    uint32_t  net = rng() & mask;
+    prefixes.push_back({net, len});
+    trie.Add(boost::asio::ip::address_v4(net), len);
+  }
+  size_t  mismatches = 0;
+  for (int i = 0; i < 5000; ++i) {
+    uint32_t  a = rng();
+    if (i & 1) {
+      //  Make sure we test plenty of addresses that match.
+      auto  & p = prefixes[rng() % prefixes.size()];
+      uint32_t  mask = (p.second == 32) ? 0xffffffff
+        : ~(0xffffffffu >> p.second);
+      a = p.first | (a & ~mask);
+    }
+    int  expected = -1;
+    for (const auto & p : prefixes) {
+      uint32_t  mask = (p.second == 32) ? 0xffffffff
+        : ~(0xffffffffu >> p.second);
+      if (((a & mask) == p.first) && (p.second > expected)) {
+        expected = p.second;
+      }
+    }
+    if (trie.LongestMatch(boost::asio::ip::address_v4(a)) != expected) {
+      ++mismatches;
+    }
+  }
+  UnitAssert(0 == mismatches);
+
+  auto  start = chrono::steady_clock::now();
+  size_t  matches = 0;
+  for (uint32_t i = 0; i < 1000000; ++i) {
+    matches += trie.Contains(boost::asio::ip::address_v4(i * 2654435761u));
+  }
+  auto  elapsed = chrono::duration_cast<chrono::nanoseconds>
+    (chrono::steady_clock::now() - start);
+  cout << "PrefixTrie: " << prefixes.size() << " prefixes, "
+       << trie.MemoryUsage() << " bytes, "
+       << (elapsed.count() / 1000000.0) << " ns per lookup ("
+       << matches << " matches)\n";
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  TestBasic();
+  TestIpPrefixes();
+  TestRandom();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,197 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestReceivePump.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::Peer::StartReceivePump() and
+//!    Dwm::Credence::SpscRing
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <iterator>
+#include <thread>
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7797;
+static const uint32_t  k_numMessages = 10000;
+
+using Ring = Credence::SpscRing<uint32_t>;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestRing()
+{
+  Ring  ring(5);
+  UnitAssert(8 == ring.Capacity());
+  for (uint32_t i = 0; i < 8; ++i) {
+    UnitAssert(ring.TryPush(uint32_t(i)));
+  }
+  UnitAssert(! ring.TryPush(8));
+  UnitAssert(8 == ring.Size());
+  uint32_t  value;
+  UnitAssert(ring.TryPop(value) && (0 == value));
+  vector<uint32_t>  batch;
+  UnitAssert(4 == ring.PopBatch(back_inserter(batch), 4));
+  UnitAssert(vector<uint32_t>({1, 2, 3, 4}) == batch);
+  ring.Close(Ring::State::e_eof);
+  UnitAssert(! ring.TryPush(9));
+  UnitAssert(! ring.Done());
+  UnitAssert(ring.Pop(value) && (5 == value));
+  UnitAssert(ring.Pop(value) && (6 == value));
+  UnitAssert(ring.Pop(value) && (7 == value));
+  UnitAssert(! ring.Pop(value));
+  UnitAssert(ring.Done());
+  UnitAssert(Ring::State::e_eof == ring.GetState());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  The ring is much smaller than the number of messages, so the pump
+//!  has to wait for the consumer.  Everything arrives in order, then
+//!  the client disconnecting closes the ring with e_eof.
+//----------------------------------------------------------------------------
+void TestPumpToEof()
+{
+  Credence::Peer  clientPeer, serverPeer;
+  if (! Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port)) {
+    return;
+  }
+  Ring  ring(64);
+  UnitAssert(serverPeer.StartReceivePump(ring));
+  UnitAssert(! serverPeer.StartReceivePump(ring));
+  std::thread  sender([&] {
+    for (uint32_t i = 0; i < k_numMessages; ++i) {
+      if (! clientPeer.Send(i)) {
+        break;
+      }
+    }
+    clientPeer.Disconnect();
+  });
+  
+  uint32_t          next = 0;
+  bool              inOrder = true;
+  vector<uint32_t>  batch;
+  uint32_t          value;
+  while (! ring.Done()) {
+    batch.clear();
+    if (ring.PopBatch(back_inserter(batch), 16)) {
+      for (auto v : batch) {
+        inOrder = inOrder && (v == next++);
+      }
+    }
+    else if (ring.Pop(value)) {
+      inOrder = inOrder && (value == next++);
+    }
+  }
+  sender.join();
+  UnitAssert(inOrder);
+  UnitAssert(k_numMessages == next);
+  UnitAssert(Ring::State::e_eof == ring.GetState());
+  serverPeer.StopReceivePump();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Stopping a pump blocked in a receive closes the ring with e_stopped
+//!  and leaves the send side working.
+//----------------------------------------------------------------------------
+void TestStopPump()
+{
+  Credence::Peer  clientPeer, serverPeer;
+  if (! Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port)) {
+    return;
+  }
+  Ring  ring(4);
+  UnitAssert(serverPeer.StartReceivePump(ring));
+  UnitAssert(clientPeer.Send(uint32_t(42)));
+  uint32_t  value = 0;
+  UnitAssert(ring.Pop(value) && (42 == value));
+  serverPeer.StopReceivePump();
+  UnitAssert(Ring::State::e_stopped == ring.GetState());
+  UnitAssert(ring.Done());
+  UnitAssert(serverPeer.Send(uint32_t(43)));
+  UnitAssert(clientPeer.Receive(value) && (43 == value));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestReceivePump", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  unconnected;
+  Ring            ring(4);
+  UnitAssert(! unconnected.StartReceivePump(ring));
+  
+  TestRing();
+  TestPumpToEof();
+  TestStopPump();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,199 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestSecureArena.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::SecureArena and SecureString unit tests
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <cstring>
+#include <set>
+#include <sstream>
+#include <vector>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceSecureString.hh"
+#include "DwmCredenceShortString.hh"
+
+using namespace std;
+using namespace Dwm;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestArena()
+{
+  Credence::SecureArena  & arena = Credence::SecureArena::Instance();
+  size_t  inUse = arena.SlotsInUse();
+  
+  //  Allocate more than one slab's worth of slots.
+  vector<void *>  slots;
+  set<void *>     unique;
+  size_t  numSlots = 2 * ((Credence::SecureArena::k_slabPages
+                           * sysconf(_SC_PAGESIZE))
+                          / Credence::SecureArena::k_slotSize);
+  for (size_t i = 0; i < numSlots; ++i) {
+    void  *p = arena.Allocate();
+    if (! UnitAssert(p)) {
+      break;
+    }
+    slots.push_back(p);
+    UnitAssert(unique.insert(p).second);
+  }
+  UnitAssert(arena.SlotsInUse() == inUse + slots.size());
+  UnitAssert(arena.NumSlabs() >= 2);
+
+  //  New slots are zeroed, and slots don't overlap.
+  uint8_t  zeros[Credence::SecureArena::k_slotSize] = {0};
+  bool  allZero = true;
+  for (auto p : slots) {
+    if (memcmp(p, zeros, sizeof(zeros)) != 0) {
+      allZero = false;
+    }
+    memset(p, 0xA5, Credence::SecureArena::k_slotSize);
+  }
+  UnitAssert(allZero);
+
+  //  Freed slots are reused, and come back zeroed.
+  void  *p = slots.back();
+  slots.pop_back();
+  arena.Free(p);
+  void  *q = arena.Allocate();
+  UnitAssert(q == p);
+  UnitAssert(memcmp(q, zeros, sizeof(zeros)) == 0);
+  slots.push_back(q);
+  
+  for (auto s : slots) {
+    arena.Free(s);
+  }
+  UnitAssert(arena.SlotsInUse() == inUse);
+  arena.Free(nullptr);
+  UnitAssert(arena.SlotsInUse() == inUse);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestString()
+{
+  Credence::SecureArena  & arena = Credence::SecureArena::Instance();
+  size_t  inUse = arena.SlotsInUse();
+  {
+    Credence::SecureString<32>  s1;
+    UnitAssert(s1.Empty());
+    UnitAssert(arena.SlotsInUse() == inUse);
+    s1 = string_view("secret key material");
+    UnitAssert(s1.Value() == "secret key material");
+    UnitAssert(arena.SlotsInUse() == inUse + 1);
+
+    //  Reassignment reuses the slot.
+    const char  *data = s1.Data();
+    s1 = string_view("other key material");
+    UnitAssert(s1.Data() == data);
+    UnitAssert(s1.Value() == "other key material");
+
+    Credence::SecureString<32>  s2(s1);
+    UnitAssert(s2 == s1);
+    UnitAssert(s2.Data() != s1.Data());
+    UnitAssert(arena.SlotsInUse() == inUse + 2);
+
+    Credence::SecureString<32>  s3(std::move(s2));
+    UnitAssert(s3 == s1);
+    UnitAssert(s2.Empty());
+    UnitAssert(arena.SlotsInUse() == inUse + 2);
+
+    //  Clear() zeroes the content but keeps the slot.
+    data = s3.Data();
+    size_t  len = s3.Length();
+    s3.Clear();
+    UnitAssert(s3.Empty());
+    bool  zeroed = true;
+    for (size_t i = 0; i < len; ++i) {
+      if (data[i]) { zeroed = false; }
+    }
+    UnitAssert(zeroed);
+    UnitAssert(arena.SlotsInUse() == inUse + 2);
+
+    //  Same binary form as ShortString.
+    stringstream  ss;
+    UnitAssert(StreamIO::Write(ss, s1));
+    Credence::ShortString<32>  ss1;
+    UnitAssert(StreamIO::Read(ss, ss1));
+    UnitAssert(ss1.Value() == s1.Value());
+    UnitAssert(StreamIO::Write(ss, ss1));
+    Credence::SecureString<32>  s4;
+    UnitAssert(StreamIO::Read(ss, s4));
+    UnitAssert(s4 == s1);
+
+    //  Over-long values are rejected.
+    bool  threw = false;
+    try {
+      s4 = string_view("this string is longer than 32 bytes");
+    }
+    catch (...) {
+      threw = true;
+    }
+    UnitAssert(threw);
+    Credence::ShortString<64>  longStr("this string is longer than 32 bytes");
+    UnitAssert(StreamIO::Write(ss, longStr));
+    UnitAssert(! StreamIO::Read(ss, s4));
+  }
+  UnitAssert(arena.SlotsInUse() == inUse);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  TestArena();
+  TestString();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -0,0 +1,145 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestSharedMemory.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::Peer shared memory mode
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestEchoPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const char     *k_sockPath = "./TestSharedMemory.sock";
+static const size_t    k_ringSize = 64 * 1024;
+static const uint32_t  k_numMessages = 1000;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void ServerSetup(Credence::Peer & peer)
+{
+  UnitAssert(peer.EnableSharedMemory() == Credence::ShmChannel::Supported());
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Messages up to several times the ring size, so both sides wrap
+//!  around and wait for each other.
+//----------------------------------------------------------------------------
+static void TestEcho(Credence::Peer & peer)
+{
+  Credence::Test::TestEcho(peer, k_numMessages, k_ringSize);
+
+  //  Several messages in flight at once.
+  string  reply;
+  for (uint32_t i = 0; i < 16; ++i) {
+    UnitAssert(peer.Send(Credence::Test::EchoMessage(i, k_ringSize)));
+  }
+  for (uint32_t i = 0; i < 16; ++i) {
+    UnitAssert(peer.Receive(reply)
+               && (reply == Credence::Test::EchoMessage(i, k_ringSize)));
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestSharedMemory", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  unconnected;
+  UnitAssert(! unconnected.EnableSharedMemory());
+  UnitAssert(! unconnected.SharedMemory());
+  
+  std::atomic<bool>      listening = false;
+  std::atomic<uint32_t>  numEchoed = 0;
+  std::thread  serverThread(Credence::Test::UnixServerThread, k_sockPath,
+                            ServerSetup, std::ref(listening),
+                            std::ref(numEchoed));
+  while (! listening) { }
+
+  Credence::Peer  peer;
+  if (Credence::Test::ConnectUnix(peer, k_sockPath)) {
+    bool  enabled = peer.EnableSharedMemory(k_ringSize);
+    UnitAssert(enabled == Credence::ShmChannel::Supported());
+    UnitAssert(enabled == peer.SharedMemory());
+    if (enabled) {
+      Credence::PeerReader  reader;
+      Credence::PeerWriter  writer;
+      UnitAssert(! peer.Split(reader, writer));
+    }
+    TestEcho(peer);
+  }
+  peer.Disconnect();
+  UnitAssert(! peer.SharedMemory());
+  serverThread.join();
+  UnitAssert((k_numMessages + 16) == numEchoed);
+  unlink(k_sockPath);
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
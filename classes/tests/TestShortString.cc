@@ -160,6 +160,46 @@ static void TestStreamIO()
   return;
 }
 
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestInline()
+{
+  //  Content is stored inline, with a one-byte length for LEN <= 255.
+  UnitAssert(sizeof(Credence::ShortString<32>) == 33);
+
+  //  Same wire format regardless of LEN, as long as the length type is
+  //  the same.
+  Credence::ShortString<255>  ss255(string(32, 'x'));
+  std::stringstream           ss;
+  if (UnitAssert(ss255.Write(ss))) {
+    UnitAssert(ss.str().size() == 33);
+    Credence::ShortString<32>  ss32;
+    if (UnitAssert(ss32.Read(ss))) {
+      UnitAssert(ss32.Value() == ss255.Value());
+      UnitAssert(ss32.Length() == 32);
+    }
+  }
+
+  //  Content longer than LEN is rejected on read.
+  ss.str("");
+  ss.clear();
+  ss255 = string(40, 'y');
+  if (UnitAssert(ss255.Write(ss))) {
+    Credence::ShortString<32>  ss32;
+    UnitAssert(! ss32.Read(ss));
+    UnitAssert(ss32.Empty());
+  }
+
+  //  Clear() zeroes the content.
+  Credence::ShortString<8>  ss8("secret");
+  const char               *p = ss8.Data();
+  ss8.Clear();
+  UnitAssert(ss8.Empty());
+  UnitAssert(string(p, 6) == string(6, '\0'));
+  return;
+}
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -168,6 +208,7 @@ int main(int argc, char *argv[])
   TestAssign();
   TestStreamIO();
   TestIstreamOperator();
+  TestInline();
   
   if (Assertions::Total().Failed()) {
     Assertions::Print(cerr, true);
@@ -47,6 +47,40 @@
 using namespace std;
 using namespace Dwm;
 
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestDetached(const Credence::Ed25519KeyPair & keyPair)
+{
+  string                       msg("Message for detached Signer test.");
+  Credence::Signer::Signature  sig;
+  if (UnitAssert(Credence::Signer::SignDetached(msg,
+                                                keyPair.SecretKey().Key(),
+                                                sig))) {
+    UnitAssert(Credence::Signer::VerifyDetached(msg, sig,
+                                                keyPair.PublicKey().Key()));
+    //  Detached signature must match the signature in combined mode.
+    string  signedMsg;
+    if (UnitAssert(Credence::Signer::Sign(msg, keyPair.SecretKey().Key(),
+                                          signedMsg))) {
+      UnitAssert(signedMsg.size() == (sig.size() + msg.size()));
+      UnitAssert(signedMsg.compare(0, sig.size(), (const char *)sig.data(),
+                                   sig.size()) == 0);
+    }
+    //  Tampered message must fail verification.
+    string  badMsg(msg);
+    badMsg[0] ^= 1;
+    UnitAssert(! Credence::Signer::VerifyDetached(badMsg, sig,
+                                                  keyPair.PublicKey().Key()));
+    //  Wrong key must fail verification.
+    Credence::Ed25519KeyPair  otherKeyPair("other");
+    string_view  otherPubKey = otherKeyPair.PublicKey().Key();
+    UnitAssert(! Credence::Signer::VerifyDetached(msg, sig, otherPubKey));
+  }
+  UnitAssert(! Credence::Signer::SignDetached(msg, string(), sig));
+  return;
+}
+
 //----------------------------------------------------------------------------
 //!  
 //----------------------------------------------------------------------------
@@ -66,6 +100,11 @@ int main(int argc, char *argv[])
       UnitAssert(openedMsg == unsignedMsg);
     }
   }
+  string  openedMsg;
+  UnitAssert(! Credence::Signer::Open(string("short"),
+                                      keyPair.PublicKey().Key(), openedMsg));
+
+  TestDetached(keyPair);
   
   if (Assertions::Total().Failed()) {
     Assertions::Print(cerr, true);
@@ -0,0 +1,150 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestSocketBuffers.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::SocketInBuffer and
+//!    Dwm::Credence::SocketOutBuffer
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <sys/socket.h>
+  #include <unistd.h>
+}
+
+#include <chrono>
+#include <iostream>
+#include <string>
+#include <thread>
+
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceSocketInBuffer.hh"
+#include "DwmCredenceSocketOutBuffer.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const size_t    k_bufferSize = 4096;
+static const uint32_t  k_numFrames = 5;
+
+//----------------------------------------------------------------------------
+//!  Small headers around messages much larger than the buffers, as
+//!  XChaCha20Poly1305::OutBuffer writes them.
+//----------------------------------------------------------------------------
+void Writer(int fd, const string & big)
+{
+  Credence::SocketOutBuffer  outBuf(fd, k_bufferSize);
+  ostream                    os(&outBuf);
+  UnitAssert(k_bufferSize == outBuf.BufferSize());
+  for (uint32_t i = 0; i < k_numFrames; ++i) {
+    os.write("0123456789abcdef", 16);
+    UnitAssert(16 == outBuf.Buffered());
+    os.write(big.data(), big.size());
+    UnitAssert(0 == outBuf.Buffered());
+    os.write("tail", 4);
+    UnitAssert(os.flush());
+    UnitAssert(0 == outBuf.Buffered());
+  }
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  UnitAssert(os.write("x", 1).flush());
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  shutdown(fd, SHUT_WR);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestLargeMessages(int fd, const string & big)
+{
+  Credence::SocketInBuffer  inBuf(fd, "pre", k_bufferSize);
+  istream                   is(&inBuf);
+  UnitAssert(3 == inBuf.Buffered());
+  UnitAssert(inBuf.WaitForBytesReady(3, std::chrono::milliseconds(0)));
+  
+  string  s(3, '\0');
+  UnitAssert(is.read(s.data(), s.size()));
+  UnitAssert("pre" == s);
+  string  header(16, '\0'), data(big.size(), '\0'), tail(4, '\0');
+  for (uint32_t i = 0; i < k_numFrames; ++i) {
+    UnitAssert(is.read(header.data(), header.size()));
+    UnitAssert("0123456789abcdef" == header);
+    UnitAssert(is.read(data.data(), data.size()));
+    UnitAssert(big == data);
+    UnitAssert(is.read(tail.data(), tail.size()));
+    UnitAssert("tail" == tail);
+  }
+
+  //  Waits for data, then sees end of file without waiting out the
+  //  timeout.
+  UnitAssert(inBuf.WaitForBytesReady(1, std::chrono::milliseconds(2000)));
+  UnitAssert(1 == inBuf.BytesReady());
+  UnitAssert('x' == is.get());
+  UnitAssert(0 == inBuf.Buffered());
+  auto  start = std::chrono::steady_clock::now();
+  UnitAssert(! inBuf.WaitForBytesReady(1, std::chrono::milliseconds(2000)));
+  UnitAssert((std::chrono::steady_clock::now() - start)
+             < std::chrono::milliseconds(1500));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  fds[2];
+  if (UnitAssert(0 == socketpair(AF_UNIX, SOCK_STREAM, 0, fds))) {
+    string  big(3 * 1024 * 1024, '\0');
+    for (size_t i = 0; i < big.size(); ++i) {
+      big[i] = (char)(i * 7);
+    }
+    std::thread  writer(Writer, fds[0], std::cref(big));
+    TestLargeMessages(fds[1], big);
+    writer.join();
+    close(fds[0]);
+    close(fds[1]);
+  }
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
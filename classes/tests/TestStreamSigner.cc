@@ -0,0 +1,167 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestStreamSigner.cc
+//!  \author Daniel W. McRobb
+//!  \brief Dwm::Credence::StreamSigner and StreamVerifier unit tests
+//---------------------------------------------------------------------------
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredenceEd25519KeyPair.hh"
+#include "DwmCredenceStreamSigner.hh"
+#include "DwmCredenceStreamVerifier.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const string  g_testFile("./TestStreamSigner_data");
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static string TestMessage()
+{
+  string  msg;
+  for (int i = 0; i < 20000; ++i) {
+    msg += "Message line " + to_string(i) + " for StreamSigner test.\n";
+  }
+  return msg;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static span<const uint8_t> Bytes(const string & s)
+{
+  return span<const uint8_t>((const uint8_t *)s.data(), s.size());
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestSpans(const Credence::Ed25519KeyPair & keyPair,
+                      const string & msg)
+{
+  //  Sign in uneven pieces, verify in one piece.
+  Credence::StreamSigner  signer;
+  size_t  offset = 0, len = 1;
+  while (offset < msg.size()) {
+    len = std::min(len * 3, msg.size() - offset);
+    UnitAssert(signer.Update(Bytes(msg).subspan(offset, len)));
+    offset += len;
+  }
+  Credence::Signer::Signature  sig;
+  UnitAssert(signer.Final(keyPair.SecretKey().Key(), sig));
+
+  Credence::StreamVerifier  verifier;
+  UnitAssert(verifier.Update(Bytes(msg)));
+  UnitAssert(verifier.Final(sig, keyPair.PublicKey().Key()));
+
+  //  Final() resets, so an empty message must not verify.
+  UnitAssert(! verifier.Final(sig, keyPair.PublicKey().Key()));
+
+  //  Tampered message must not verify.
+  string  badMsg(msg);
+  badMsg[badMsg.size() / 2] ^= 1;
+  UnitAssert(verifier.Update(Bytes(badMsg)));
+  UnitAssert(! verifier.Final(sig, keyPair.PublicKey().Key()));
+
+  //  Wrong key must not verify.
+  Credence::Ed25519KeyPair  otherKeyPair("other");
+  UnitAssert(verifier.Update(Bytes(msg)));
+  UnitAssert(! verifier.Final(sig, otherKeyPair.PublicKey().Key()));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+static void TestStreamsAndFiles(const Credence::Ed25519KeyPair & keyPair,
+                                const string & msg)
+{
+  Credence::StreamSigner       signer;
+  Credence::Signer::Signature  sig;
+  istringstream                is(msg);
+  UnitAssert(signer.Update(is));
+  UnitAssert(signer.Final(keyPair.SecretKey().Key(), sig));
+
+  {
+    ofstream  os(g_testFile);
+    UnitAssert(os << msg);
+  }
+  Credence::StreamVerifier  verifier;
+  UnitAssert(verifier.UpdateFile(g_testFile));
+  UnitAssert(verifier.Final(sig, keyPair.PublicKey().Key()));
+
+  Credence::Signer::Signature  fileSig;
+  UnitAssert(signer.UpdateFile(g_testFile));
+  UnitAssert(signer.Final(keyPair.SecretKey().Key(), fileSig));
+  ifstream  is2(g_testFile);
+  UnitAssert(verifier.Update(is2));
+  UnitAssert(verifier.Final(fileSig, keyPair.PublicKey().Key()));
+  
+  std::remove(g_testFile.c_str());
+  UnitAssert(! signer.UpdateFile(g_testFile));
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  Dwm::SysLogger::Open("TestStreamSigner", LOG_PID, LOG_USER);
+  
+  Credence::Ed25519KeyPair  keyPair("dwm");
+  string                    msg = TestMessage();
+
+  TestSpans(keyPair, msg);
+  TestStreamsAndFiles(keyPair, msg);
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
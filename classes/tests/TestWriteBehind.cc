@@ -0,0 +1,210 @@
+//===========================================================================
+// @(#) $DwmPath$
+//===========================================================================
+//  Copyright (c) Daniel W. McRobb 2026
+//  All rights reserved.
+//
+//  Redistribution and use in source and binary forms, with or without
+//  modification, are permitted provided that the following conditions
+//  are met:
+//
+//  1. Redistributions of source code must retain the above copyright
+//     notice, this list of conditions and the following disclaimer.
+//  2. Redistributions in binary form must reproduce the above copyright
+//     notice, this list of conditions and the following disclaimer in the
+//     documentation and/or other materials provided with the distribution.
+//  3. The names of the authors and copyright holders may not be used to
+//     endorse or promote products derived from this software without
+//     specific prior written permission.
+//
+//  IN NO EVENT SHALL DANIEL W. MCROBB BE LIABLE TO ANY PARTY FOR
+//  DIRECT, INDIRECT, SPECIAL, INCIDENTAL, OR CONSEQUENTIAL DAMAGES,
+//  INCLUDING LOST PROFITS, ARISING OUT OF THE USE OF THIS SOFTWARE,
+//  EVEN IF DANIEL W. MCROBB HAS BEEN ADVISED OF THE POSSIBILITY OF SUCH
+//  DAMAGE.
+//
+//  THE SOFTWARE PROVIDED HEREIN IS ON AN "AS IS" BASIS, AND
+//  DANIEL W. MCROBB HAS NO OBLIGATION TO PROVIDE MAINTENANCE, SUPPORT,
+//  UPDATES, ENHANCEMENTS, OR MODIFICATIONS. DANIEL W. MCROBB MAKES NO
+//  REPRESENTATIONS AND EXTENDS NO WARRANTIES OF ANY KIND, EITHER
+//  IMPLIED OR EXPRESS, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+//  WARRANTIES OF MERCHANTABILITY OR FITNESS FOR A PARTICULAR PURPOSE,
+//  OR THAT THE USE OF THIS SOFTWARE WILL NOT INFRINGE ANY PATENT,
+//  TRADEMARK OR OTHER RIGHTS.
+//===========================================================================
+
+//---------------------------------------------------------------------------
+//!  \file TestWriteBehind.cc
+//!  \author Daniel W. McRobb
+//!  \brief Unit tests for Dwm::Credence::Peer write-behind mode
+//---------------------------------------------------------------------------
+
+extern "C" {
+  #include <unistd.h>
+}
+
+#include <atomic>
+#include <thread>
+#include <vector>
+
+#include "DwmSysLogger.hh"
+#include "DwmUnitAssert.hh"
+#include "DwmCredencePeer.hh"
+#include "TestConnectPeers.hh"
+
+using namespace std;
+using namespace Dwm;
+
+static const uint16_t  k_port = 7796;
+static const uint32_t  k_numMessages = 1000;
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void ReceiveAll(Credence::Peer & peer, std::atomic<uint32_t> & numInOrder)
+{
+  uint32_t  msg;
+  for (uint32_t i = 0; i < k_numMessages; ++i) {
+    if ((! peer.Receive(msg)) || (msg != i)) {
+      break;
+    }
+    ++numInOrder;
+  }
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestNotEnabled(Credence::Peer & clientPeer, Credence::Peer & serverPeer)
+{
+  UnitAssert(! clientPeer.WriteBehind());
+  UnitAssert(clientPeer.SendAsync(string("sync")).get());
+  string  msg;
+  UnitAssert(serverPeer.Receive(msg));
+  UnitAssert("sync" == msg);
+  UnitAssert(0 == clientPeer.WriteBehindStats().queued);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  Futures, callbacks and Send() all go through one queue, in order.
+//----------------------------------------------------------------------------
+void TestInOrder(Credence::Peer & clientPeer, Credence::Peer & serverPeer)
+{
+  Credence::WriteBehindQueue::Config  config;
+  config.maxMessages = 64;
+  config.maxBytes = 4096;
+  if (! UnitAssert(clientPeer.EnableWriteBehind(config))) {
+    return;
+  }
+  UnitAssert(clientPeer.WriteBehind());
+  
+  std::atomic<uint32_t>  numInOrder = 0;
+  std::thread  receiver(ReceiveAll, std::ref(serverPeer),
+                        std::ref(numInOrder));
+  std::atomic<uint32_t>       numCallbacks = 0;
+  vector<std::future<bool>>   futures;
+  for (uint32_t i = 0; i < k_numMessages; ++i) {
+    if ((i % 100) == 99) {
+      UnitAssert(clientPeer.Send(i));
+    }
+    else if (i % 2) {
+      futures.push_back(clientPeer.SendAsync(i));
+    }
+    else {
+      clientPeer.SendAsync(i, [&] (bool ok) { if (ok) { ++numCallbacks; } });
+    }
+  }
+  clientPeer.DisableWriteBehind();
+  UnitAssert(! clientPeer.WriteBehind());
+  receiver.join();
+  UnitAssert(k_numMessages == numInOrder);
+  
+  uint32_t  numFutures = 0;
+  for (auto & f : futures) {
+    if (f.get()) {
+      ++numFutures;
+    }
+  }
+  UnitAssert((numFutures + numCallbacks + (k_numMessages / 100))
+             == k_numMessages);
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+void TestStats(Credence::Peer & clientPeer, Credence::Peer & serverPeer)
+{
+  Credence::WriteBehindQueue::Config  config;
+  config.maxMessages = 8;
+  if (! UnitAssert(clientPeer.EnableWriteBehind(config))) {
+    return;
+  }
+  std::atomic<uint32_t>  numInOrder = 0;
+  std::thread  receiver(ReceiveAll, std::ref(serverPeer),
+                        std::ref(numInOrder));
+  for (uint32_t i = 0; i < k_numMessages; ++i) {
+    clientPeer.SendAsync(i, nullptr);
+  }
+  receiver.join();
+  auto  stats = clientPeer.WriteBehindStats();
+  UnitAssert(k_numMessages == numInOrder);
+  UnitAssert(k_numMessages == stats.queued);
+  UnitAssert(0 == stats.rejected);
+  UnitAssert(stats.maxDepth <= config.maxMessages);
+  UnitAssert(stats.flushes <= stats.queued);
+  UnitAssert(stats.totalWait >= stats.maxWait);
+  clientPeer.DisableWriteBehind();
+  return;
+}
+
+//----------------------------------------------------------------------------
+//!  
+//----------------------------------------------------------------------------
+int main(int argc, char *argv[])
+{
+  int  optChar;
+  while ((optChar = getopt(argc, argv, "d")) != -1) {
+    switch (optChar) {
+      case 'd':
+        Dwm::SysLogger::Open("TestWriteBehind", LOG_PID|LOG_PERROR,
+                             LOG_USER);
+        Dwm::SysLogger::MinimumPriority(LOG_DEBUG);
+        break;
+      default:
+        break;
+    }
+  }
+
+  Credence::Peer  unconnected;
+  UnitAssert(! unconnected.EnableWriteBehind());
+  
+  Credence::Peer  serverPeer;
+  Credence::Peer  clientPeer;
+  bool  authenticated =
+    Credence::Test::ConnectPeers(clientPeer, serverPeer, k_port);
+
+  if (authenticated) {
+    TestNotEnabled(clientPeer, serverPeer);
+    TestInOrder(clientPeer, serverPeer);
+    TestStats(clientPeer, serverPeer);
+
+    //  Disconnect() with write-behind enabled doesn't wait.
+    UnitAssert(clientPeer.EnableWriteBehind());
+    clientPeer.Disconnect();
+    UnitAssert(! clientPeer.WriteBehind());
+  }
+  clientPeer.Disconnect();
+  serverPeer.Disconnect();
+  
+  if (Assertions::Total().Failed()) {
+    Assertions::Print(cerr, true);
+    return 1;
+  }
+  else {
+    cout << Assertions::Total() << " passed" << endl;
+  }
+  return 0;
+}
@@ -61,7 +61,8 @@ int main(int argc, char *argv[])
   UnitAssert(serverKeys.SecretKey().Value().size()
              == crypto_box_SECRETKEYBYTES);
 
-  string  sharedKey = clientKeys.SharedKey(serverKeys.PublicKey().Value());
+  Credence::KXKeyPair::SharedKeyType  sharedKey =
+    clientKeys.SharedKey(serverKeys.PublicKey().Value());
 
   string  cipherText;
   Credence::Nonce  nonce;
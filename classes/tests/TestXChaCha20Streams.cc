@@ -57,7 +57,8 @@ using namespace Dwm;
 int main(int argc, char *argv[])
 {
   Credence::KXKeyPair  clientKeys, serverKeys;
-  string  sharedKey = clientKeys.SharedKey(serverKeys.PublicKey().Value());
+  Credence::KXKeyPair::SharedKeyType  sharedKey =
+    clientKeys.SharedKey(serverKeys.PublicKey().Value());
 
   string        plainText("An encrypted message to test streams.");
   stringstream  ss;